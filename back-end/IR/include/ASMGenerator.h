@@ -13,8 +13,13 @@ std::string IR_OperandToString (const IR_Operand &operand);
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
 IR_Error printIR    (IR *IR);
+// cached function text is reused as it is, any change to what is written here goes with a new COMPILER_VERSION
 IR_Error generateASM(IR_Context *IRContext, IR *IR, const char *filename);
 
+// the header and the text of one function as generateASM writes them, for a file put together from several runs
+IR_Error generateASMHeader  (IR_Context *IRContext, std::string &text);
+IR_Error generateFunctionASM(IR_Context *IRContext, IR *IR, size_t functionIndex, std::string &text);
+
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
 #endif // ASM_GENERATOR_H_
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "AST.h"
 #include "asmTranslator.h"
@@ -168,6 +169,7 @@ struct IR_Context {
 
     size_t currentFunction = {};
     bool hasReturn = {};
+    std::vector<astHandle> functions;               // definitions in the order of the tree, set by prepareIR
     std::map<std::string, size_t> functionNameToIndex;
     std::unordered_map<size_t, IR_Register> variableRegisterCache;
 };
@@ -6,11 +6,17 @@
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
+// a function lowered differently than before is still found in the cache under its old key, unless COMPILER_VERSION changes too
 IR_Error generateIR(IR_Context *IRContext);
 
-IR_Error generateFunctionIR     (IR_Context *IRContext, node<astNode> *node, IR_BasicBlock *block);
-IR_Error generateStatementIR    (IR_Context *IRContext, node<astNode> *node, IR_BasicBlock *block);
-IR_Error generateExpressionIR   (IR_Context *IRContext, node<astNode> *node, IR_BasicBlock *block, IR_Register &resultReg);
+// generateIR split in two: prepareIR finds the functions and the entry point, generateFunctionsIR lowers those whose
+// lower[i] is set (every one when lower is NULL), i being the index in IRContext->functions
+IR_Error prepareIR          (IR_Context *IRContext);
+IR_Error generateFunctionsIR(IR_Context *IRContext, const bool *lower);
+
+IR_Error generateFunctionIR     (IR_Context *IRContext, compactNode *node, IR_BasicBlock *block);
+IR_Error generateStatementIR    (IR_Context *IRContext, compactNode *node, IR_BasicBlock *block);
+IR_Error generateExpressionIR   (IR_Context *IRContext, compactNode *node, IR_BasicBlock *block, IR_Register &resultReg);
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
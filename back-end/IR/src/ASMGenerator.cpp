@@ -1,4 +1,5 @@
 #include <fstream>
+#include <sstream>
 
 #include "ASMGenerator.h"
 #include "customWarning.h"
@@ -103,102 +104,153 @@ std::string IR_OperandToString(const IR_Operand &operand) {
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-IR_Error generateASM(IR_Context *IRContext, IR *IR, const char *filename) {
-    customWarning(IRContext, IR_Error::IR_CONTEXT_BAD_POINTER);
-    customWarning(IR, IR_Error::IR_BAD_POINTER);
-
-    std::ofstream outFile(filename);
-    if (!outFile.is_open()) {
-        return IR_Error::IO_ERROR;
-    }
-
-    customPrint(blue, bold, bgDefault, "Generating ASM file: %s\n", filename);
-
+static IR_Error writeASMHeader(IR_Context *IRContext, std::ostream &outFile) {
     outFile << "; Generated ASM from IR\n";
     outFile << "section .text\n";
-    outFile << "global " << IR->entryPoint->label << "\n\n";
-
-    ssize_t currentBlockIndex = IR->basicBlocks->next[0];
-    while (currentBlockIndex != 0) {
-        IR_BasicBlock *block = IR->basicBlocks->data[currentBlockIndex];
+    outFile << "global " << IRContext->ASTContext->nameTable->data[IRContext->ASTContext->entryPoint].name << "\n\n";
 
-        std::string blockLabel = block->label ? block->label : "block_" + std::to_string(currentBlockIndex);
-        outFile << blockLabel << ":\n";
+    return IR_Error::NO_ERRORS;
+}
 
-        ssize_t currentInstIndex = block->instructions->next[0];
-        while (currentInstIndex != 0) {
-            IR_Instruction &inst = block->instructions->data[currentInstIndex];
-            std::string instStr = IR_OperatorToString(inst.op);
+static IR_Error writeBlockASM(IR_Context *IRContext, IR_BasicBlock *block, std::ostream &outFile) {
+    outFile << block->label << ":\n";
 
-            if (inst.op == IR_Operator::IR_CALL) {
-                if (inst.firstOperand.type == IR_OperandType::FUNC_INDEX) {
-                    size_t funcIndex = inst.firstOperand.functionIndex;
-                    std::string funcName;
+    ssize_t currentInstIndex = block->instructions->next[0];
+    while (currentInstIndex != 0) {
+        IR_Instruction &inst = block->instructions->data[currentInstIndex];
+        std::string instStr = IR_OperatorToString(inst.op);
 
-                    for (const auto &pair : IRContext->functionNameToIndex) {
-                        if (pair.second == funcIndex) {
-                            funcName = pair.first;
-                            break;
-                        }
-                    }
+        if (inst.op == IR_Operator::IR_CALL) {
+            if (inst.firstOperand.type == IR_OperandType::FUNC_INDEX) {
+                size_t funcIndex = inst.firstOperand.functionIndex;
+                std::string funcName;
 
-                    if (funcName.empty()) {
-                        outFile.close();
-                        return IR_Error::AST_BAD_STRUCTURE;
+                for (const auto &pair : IRContext->functionNameToIndex) {
+                    if (pair.second == funcIndex) {
+                        funcName = pair.first;
+                        break;
                     }
+                }
 
-                    outFile << "    call " << funcName << "\n";
-                } else {
-                    outFile << "    call " << IR_OperandToString(inst.firstOperand) << "\n";
+                if (funcName.empty()) {
+                    return IR_Error::AST_BAD_STRUCTURE;
                 }
 
-            } else if (inst.op == IR_Operator::IR_JMP || inst.op == IR_Operator::IR_JE || inst.op == IR_Operator::IR_JNE ||
-                       inst.op == IR_Operator::IR_JL || inst.op == IR_Operator::IR_JLE ||
-                       inst.op == IR_Operator::IR_JG || inst.op == IR_Operator::IR_JGE) {
+                outFile << "    call " << funcName << "\n";
+            } else {
+                outFile << "    call " << IR_OperandToString(inst.firstOperand) << "\n";
+            }
 
-                if (inst.firstOperand.type == IR_OperandType::LABEL) {
-                    outFile << "    " << instStr << " " << inst.firstOperand.label << "\n";
-                } else {
-                    outFile << "    " << instStr << " " << IR_OperandToString(inst.firstOperand) << "\n";
-                }
+        } else if (inst.op == IR_Operator::IR_JMP || inst.op == IR_Operator::IR_JE || inst.op == IR_Operator::IR_JNE ||
+                   inst.op == IR_Operator::IR_JL || inst.op == IR_Operator::IR_JLE ||
+                   inst.op == IR_Operator::IR_JG || inst.op == IR_Operator::IR_JGE) {
 
-            } else if (inst.op == IR_Operator::IR_SYSCALL) {
-                outFile << "    syscall\n";
-            } else if (inst.op == IR_Operator::IR_CQO) {
-                outFile << "    cqo\n";
+            if (inst.firstOperand.type == IR_OperandType::LABEL) {
+                outFile << "    " << instStr << " " << inst.firstOperand.label << "\n";
             } else {
-                outFile << "    " << instStr;
+                outFile << "    " << instStr << " " << IR_OperandToString(inst.firstOperand) << "\n";
+            }
 
-                if (inst.operandCount > 0) {
-                    std::string firstOp = IR_OperandToString(inst.firstOperand);
-                    if (inst.firstOperand.isImmediate && inst.firstOperand.type != IR_OperandType::IMM) {
-                        firstOp = firstOp.substr(4, firstOp.size() - 5);
-                    }
+        } else if (inst.op == IR_Operator::IR_SYSCALL) {
+            outFile << "    syscall\n";
+        } else if (inst.op == IR_Operator::IR_CQO) {
+            outFile << "    cqo\n";
+        } else {
+            outFile << "    " << instStr;
 
-                    outFile << " " << firstOp;
+            if (inst.operandCount > 0) {
+                std::string firstOp = IR_OperandToString(inst.firstOperand);
+                if (inst.firstOperand.isImmediate && inst.firstOperand.type != IR_OperandType::IMM) {
+                    firstOp = firstOp.substr(4, firstOp.size() - 5);
+                }
 
-                    if (inst.operandCount > 1) {
-                        std::string secondOp = IR_OperandToString(inst.secondOperand);
+                outFile << " " << firstOp;
 
-                        if (inst.secondOperand.isImmediate && inst.secondOperand.type != IR_OperandType::IMM) {
-                            secondOp = secondOp.substr(4, secondOp.size() - 5);
-                        }
+                if (inst.operandCount > 1) {
+                    std::string secondOp = IR_OperandToString(inst.secondOperand);
 
-                        outFile << ", " << secondOp;
+                    if (inst.secondOperand.isImmediate && inst.secondOperand.type != IR_OperandType::IMM) {
+                        secondOp = secondOp.substr(4, secondOp.size() - 5);
                     }
+
+                    outFile << ", " << secondOp;
                 }
-                
-                outFile << "\n";
             }
+            
+            outFile << "\n";
+        }
+
+        currentInstIndex = block->instructions->next[currentInstIndex];
+    }
+
+    outFile << "\n";
+
+    return IR_Error::NO_ERRORS;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+IR_Error generateASM(IR_Context *IRContext, IR *IR, const char *filename) {
+    customWarning(IRContext, IR_Error::IR_CONTEXT_BAD_POINTER);
+    customWarning(IR, IR_Error::IR_BAD_POINTER);
+
+    std::ofstream outFile(filename);
+    if (!outFile.is_open()) {
+        return IR_Error::IO_ERROR;
+    }
+
+    customPrint(blue, bold, bgDefault, "Generating ASM file: %s\n", filename);
+
+    writeASMHeader(IRContext, outFile);
 
-            currentInstIndex = block->instructions->next[currentInstIndex];
+    ssize_t currentBlockIndex = IR->basicBlocks->next[0];
+    while (currentBlockIndex != 0) {
+        IR_Error error = writeBlockASM(IRContext, IR->basicBlocks->data[currentBlockIndex], outFile);
+
+        if (error != IR_Error::NO_ERRORS) {
+            outFile.close();
+            return error;
         }
 
-        outFile << "\n";
         currentBlockIndex = IR->basicBlocks->next[currentBlockIndex];
     }
 
     outFile.close();
     customPrint(blue, bold, bgDefault, "ASM file %s generated successfully\n", filename);
+    return IR_Error::NO_ERRORS;
+}
+
+IR_Error generateASMHeader(IR_Context *IRContext, std::string &text) {
+    customWarning(IRContext, IR_Error::IR_CONTEXT_BAD_POINTER);
+
+    std::ostringstream out;
+    writeASMHeader(IRContext, out);
+
+    text = out.str();
+
+    return IR_Error::NO_ERRORS;
+}
+
+// the blocks of one function keep their order in the list, so the text is the part generateASM writes for it
+IR_Error generateFunctionASM(IR_Context *IRContext, IR *IR, size_t functionIndex, std::string &text) {
+    customWarning(IRContext, IR_Error::IR_CONTEXT_BAD_POINTER);
+    customWarning(IR, IR_Error::IR_BAD_POINTER);
+
+    std::ostringstream out;
+
+    ssize_t currentBlockIndex = IR->basicBlocks->next[0];
+    while (currentBlockIndex != 0) {
+        IR_BasicBlock *block = IR->basicBlocks->data[currentBlockIndex];
+
+        if (block->functionIndex == functionIndex) {
+            IR_Error error = writeBlockASM(IRContext, block, out);
+            customWarning(error == IR_Error::NO_ERRORS, error);
+        }
+
+        currentBlockIndex = IR->basicBlocks->next[currentBlockIndex];
+    }
+
+    text = out.str();
+
     return IR_Error::NO_ERRORS;
 }
\ No newline at end of file
@@ -1,11 +1,20 @@
 #include <fstream>
 #include <stdio.h>
+#include <string.h>
 #include <string>
 #include <vector>
 
 #include "ASMGenerator.h"
 #include "codegen.h"
 #include "IRGenerator.h"
+#include "astVisitor.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// the children and the parent of a node in the compact tree the back-end has read
+#define LEFT_(_NODE_)   getCompactLeft  (IRContext->ASTContext->AST, _NODE_)
+#define RIGHT_(_NODE_)  getCompactRight (IRContext->ASTContext->AST, _NODE_)
+#define PARENT_(_NODE_) getCompactParent(IRContext->ASTContext->AST, _NODE_)
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
@@ -26,22 +35,31 @@ static size_t getVariableOffset(IR_Context *IRContext, size_t nameTableIndex) {
     return 0;
 }
 
-static void collectFunctionNodes(node<astNode> *current, std::vector<node<astNode> *> &functions) {
-    while (current) {
-        if (current->data.type == nodeType::KEYWORD && 
-            current->data.data.keyword == Keyword::OPERATOR_SEPARATOR) {
-            if (current->left && current->left->data.type == nodeType::FUNCTION_DEFINITION) {
-                functions.push_back(current->left);
-            }
+// handles rather than pointers, so the list does not depend on where the node array ends up
+static void collectFunctionNodes(compactAST *AST, std::vector<astHandle> &functions) {
+    compactChainIterator declarations = {};
+    compactChainIteratorInitialize(&declarations, AST, getCompactNode(AST, AST->root), isOperatorSeparator);
+
+    while (compactNode *declaration = compactChainIteratorNext(&declarations)) {
+        if (declaration->type == nodeType::FUNCTION_DEFINITION) {
+            functions.push_back(getCompactHandle(AST, declaration));
         }
-        
-        current = current->right;
     }
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
 IR_Error generateIR(IR_Context *IRContext) {
+    IR_Error error = prepareIR(IRContext);
+
+    if (error != IR_Error::NO_ERRORS) {
+        return error;
+    }
+
+    return generateFunctionsIR(IRContext, NULL);
+}
+
+IR_Error prepareIR(IR_Context *IRContext) {
     customWarning(IRContext, IR_Error::IR_CONTEXT_BAD_POINTER);
 
     IR *IR = IRContext->representation;
@@ -52,73 +70,75 @@ IR_Error generateIR(IR_Context *IRContext) {
 
     IR->basicBlocks = blocks;
 
-    std::vector<node<astNode> *> functions;
-
-    if (IRContext->ASTContext->AST->root->left && 
-        IRContext->ASTContext->AST->root->left->data.type == nodeType::FUNCTION_DEFINITION) {
-        functions.push_back(IRContext->ASTContext->AST->root->left);
-    } else {
-        return IR_Error::AST_BAD_STRUCTURE;
-    }
+    compactAST             *AST       = IRContext->ASTContext->AST;
+    std::vector<astHandle> &functions = IRContext->functions;
+    functions.clear();
 
-    collectFunctionNodes(IRContext->ASTContext->AST->root->right, functions);
+    // a binary AST leaves the separators of functions nobody calls empty, so the first one may be missing too
+    collectFunctionNodes(AST, functions);
     customWarning(!functions.empty(), IR_Error::AST_BAD_STRUCTURE);
 
-    node<astNode> *entryPointNode = nullptr;
-    std::string entryPointName = IRContext->ASTContext->nameTable->data[IRContext->ASTContext->entryPoint].name;
-    size_t entryPointIndex = 0;
-
     for (size_t i = 0; i < functions.size(); i++) {
-        size_t globalNameID = functions[i]->data.data.nameTableIndex;
+        size_t globalNameID = getCompactNode(AST, functions[i])->data.nameTableIndex;
         std::string funcName = IRContext->ASTContext->nameTable->data[globalNameID].name;
 
         IRContext->functionNameToIndex[funcName] = i;
     }
 
+    // names are interned, so equal names always share one name table index
     for (size_t i = 0; i < functions.size(); ++i) {
-        std::string funcName = IRContext->ASTContext->nameTable->data[functions[i]->data.data.nameTableIndex].name;
+        if (getCompactNode(AST, functions[i])->data.nameTableIndex == IRContext->ASTContext->entryPoint) {
+            IR->entryPointIndex = i;
 
-        if (funcName == entryPointName) {
-            entryPointNode  = functions[i];
-            entryPointIndex = i;
-            break;
+            return IR_Error::NO_ERRORS;
         }
     }
 
-    customWarning(entryPointNode, IR_Error::NODE_BAD_POINTER);
+    return IR_Error::NODE_BAD_POINTER;
+}
+
+// the entry point goes first, the rest follow in the order of the tree; every block a function creates is tagged
+// with its index, so generateFunctionASM can find them
+IR_Error generateFunctionsIR(IR_Context *IRContext, const bool *lower) {
+    customWarning(IRContext, IR_Error::IR_CONTEXT_BAD_POINTER);
+
+    IR *IR = IRContext->representation;
+    customWarning(IR->basicBlocks, IR_Error::BLOCKS_LIST_BAD_POINTER);
 
-    IR_BasicBlock *entryPointBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-    customWarning(entryPointBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-    initializeBasicBlock(entryPointBlock, entryPointName.c_str());
+    std::vector<astHandle> &functions = IRContext->functions;
 
-    IR->entryPoint = entryPointBlock;
-    linkedListError llError = insertNode(IR->basicBlocks, entryPointBlock);
-    customWarning(llError == linkedListError::NO_ERRORS, IR_Error::BLOCKS_LIST_BAD_POINTER);
+    for (size_t order = 0; order < functions.size(); order++) {
+        size_t i = order == 0 ? IR->entryPointIndex : (order <= IR->entryPointIndex ? order - 1 : order);
 
-    IRContext->currentFunction = IRContext->ASTContext->entryPoint;
-    size_t localTableIndex = IRContext->ASTContext->functionToLocalTable[IRContext->currentFunction];
-    
-    IR_Error error = generateFunctionIR(IRContext, entryPointNode, entryPointBlock);
-    customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_FUNCTION_IR_ERROR);
+        if (lower && !lower[i]) {
+            continue;
+        }
 
-    for (size_t i = 0; i < functions.size(); ++i) {
-        if (i != entryPointIndex) {
-            node<astNode> *func = functions[i];
+        compactNode *func = getCompactNode(IRContext->ASTContext->AST, functions[i]);
 
-            std::string funcName = IRContext->ASTContext->nameTable->data[func->data.data.nameTableIndex].name;
-            
-            IRContext->currentFunction = func->data.data.nameTableIndex;
-            localTableIndex = IRContext->ASTContext->functionToLocalTable[IRContext->currentFunction];
+        std::string funcName = IRContext->ASTContext->nameTable->data[func->data.nameTableIndex].name;
 
-            IR_BasicBlock *funcBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-            customWarning(funcBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-            initializeBasicBlock(funcBlock, funcName.c_str());
+        IRContext->currentFunction = func->data.nameTableIndex;
 
-            llError = insertNode(IR->basicBlocks, funcBlock);
-            customWarning(llError == linkedListError::NO_ERRORS, IR_Error::BLOCKS_LIST_BAD_POINTER);
+        IR_BasicBlock *funcBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(funcBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(funcBlock, funcName.c_str());
 
-            error = generateFunctionIR(IRContext, func, funcBlock);
-            customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_FUNCTION_IR_ERROR);
+        if (i == IR->entryPointIndex) {
+            IR->entryPoint = funcBlock;
+        }
+
+        linkedListError llError = insertNode(IR->basicBlocks, funcBlock);
+        customWarning(llError == linkedListError::NO_ERRORS, IR_Error::BLOCKS_LIST_BAD_POINTER);
+
+        ssize_t firstBlockIndex = IR->basicBlocks->newIndex;
+
+        IR_Error error = generateFunctionIR(IRContext, func, funcBlock);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_FUNCTION_IR_ERROR);
+
+        // blocks are appended, so everything from the function block on belongs to this function
+        for (ssize_t blockIndex = firstBlockIndex; blockIndex != 0; blockIndex = IR->basicBlocks->next[blockIndex]) {
+            IR->basicBlocks->data[blockIndex]->functionIndex = i;
         }
     }
 
@@ -138,38 +158,40 @@ IR_Error generateIR(IR_Context *IRContext) {
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-IR_Error generateFunctionIR(IR_Context *IRContext, node<astNode> *currentNode, IR_BasicBlock *block) {
+IR_Error generateFunctionIR(IR_Context *IRContext, compactNode *currentNode, IR_BasicBlock *block) {
     customWarning(IRContext, IR_Error::IR_CONTEXT_BAD_POINTER);
     customWarning(currentNode, IR_Error::NODE_BAD_POINTER);
     customWarning(block, IR_Error::BASIC_BLOCK_BAD_POINTER);
 
-    if (currentNode->data.type != nodeType::FUNCTION_DEFINITION) {
+    if (currentNode->type != nodeType::FUNCTION_DEFINITION) {
         return IR_Error::AST_BAD_STRUCTURE;
     }
 
-    std::string funcName = IRContext->ASTContext->nameTable->data[IRContext->currentFunction].name;
-
     IRContext->hasReturn = false;
     IRContext->regAllocator->stackOffset = 0;
 
+    // a register filled by the function lowered before holds nothing on entry here, so no variable is cached in one
+    memset(IRContext->regAllocator->used, 0, IRContext->regAllocator->count * sizeof(bool));
+    IRContext->variableRegisterCache.clear();
+
     PUSH_REG(IR_Register::RBP);
     MOV_REG_REG(IR_Register::RBP, IR_Register::RSP);
 
     size_t localTableIndex = IRContext->ASTContext->functionToLocalTable[IRContext->currentFunction];
     size_t localSize = IRContext->ASTContext->localTables->data[localTableIndex].size * 8;
 
-    if (funcName == IRContext->ASTContext->nameTable->data[IRContext->ASTContext->entryPoint].name) {
+    if (IRContext->currentFunction == IRContext->ASTContext->entryPoint) {
         localSize += 8; // for return value
     }
 
     SUB_REG_IMM(IR_Register::RSP, localSize);
 
     // parameters
-    if (!currentNode->right || currentNode->right->data.type != nodeType::PARAMETERS) {
+    if (!RIGHT_(currentNode) || RIGHT_(currentNode)->type != nodeType::PARAMETERS) {
         return IR_Error::AST_BAD_STRUCTURE;
     }
 
-    IR_Error error = generateStatementIR(IRContext, currentNode->right, block);
+    IR_Error error = generateStatementIR(IRContext, RIGHT_(currentNode), block);
     customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_STATEMENT_IR_ERROR);    
 
     if (!IRContext->hasReturn) {
@@ -185,778 +207,811 @@ IR_Error generateFunctionIR(IR_Context *IRContext, node<astNode> *currentNode, I
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-IR_Error generateStatementIR(IR_Context *IRContext, node<astNode> *currentNode, IR_BasicBlock *block) {
-    customWarning(IRContext, IR_Error::IR_CONTEXT_BAD_POINTER);
-    customWarning(block, IR_Error::BASIC_BLOCK_BAD_POINTER);
+// a nested block takes over from block only until its own statement is over, the next statement goes to block again
+struct statementIRGenerator : compactVisitor<statementIRGenerator, IR_Error, IR_BasicBlock *> {
+    IR_Context *IRContext = NULL;
 
-    customWarning(currentNode, IR_Error::NODE_BAD_POINTER);
+    IR_Error visitNode(compactNode *currentNode, IR_BasicBlock *block) {
+        return IR_Error::AST_BAD_STRUCTURE;
+    }
 
-    switch (currentNode->data.type) {
-        case nodeType::VARIABLE_DECLARATION: {
+    IR_Error visitVariableDeclaration(compactNode *currentNode, IR_BasicBlock *block) {
+        size_t offset = IRContext->regAllocator->stackOffset + 8;
+        IRContext->regAllocator->stackOffset += 8;
+
+        size_t localTableIndex = IRContext->ASTContext->functionToLocalTable[IRContext->currentFunction];
+        localNameTable *localTable = &IRContext->ASTContext->localTables->data[localTableIndex];
+        for (size_t i = 0; i < localTable->size; i++) {
+            if (localTable->elements.data[i].globalNameID == currentNode->data.nameTableIndex) {
+                localTable->elements.data[i].rbpOffset = offset;
+                break;
+            }
+        }
+
+        if (RIGHT_(currentNode) && RIGHT_(currentNode)->type == nodeType::KEYWORD && 
+            RIGHT_(currentNode)->data.keyword == Keyword::ASSIGNMENT) {
+
+            IR_Register resultReg;
+            IR_Error error = generateExpressionIR(IRContext, LEFT_(RIGHT_(currentNode)), block, resultReg);
+            customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+            MOV_MEM_REG_MINUS_IMM_REG(IR_Register::RBP, offset, resultReg);
+            IRContext->variableRegisterCache[currentNode->data.nameTableIndex] = resultReg;
+        }
+
+        return IR_Error::NO_ERRORS;
+    }
+
+    IR_Error visitParameters(compactNode *currentNode, IR_BasicBlock *block) {
+        compactNode *paramNode = LEFT_(currentNode);
+        size_t paramIndex = 0;
+
+        static const IR_Register argRegisters[] = {
+            IR_Register::RDI, IR_Register::RSI, IR_Register::RDX,
+            IR_Register::RCX, IR_Register::R8, IR_Register::R9
+        };
+
+        while (paramNode && paramNode->type == nodeType::VARIABLE_DECLARATION) {
             size_t offset = IRContext->regAllocator->stackOffset + 8;
             IRContext->regAllocator->stackOffset += 8;
-            currentNode->data.rbpOffset = offset;
-        
-            localNameTable *localTable = &IRContext->ASTContext->localTables->data[IRContext->currentFunction];
+
+            size_t localTableIndex = IRContext->ASTContext->functionToLocalTable[IRContext->currentFunction];
+            localNameTable *localTable = &IRContext->ASTContext->localTables->data[localTableIndex];
+            bool found = false;
+
             for (size_t i = 0; i < localTable->size; i++) {
-                if (localTable->elements.data[i].globalNameID == currentNode->data.data.nameTableIndex) {
+                if (localTable->elements.data[i].globalNameID == paramNode->data.nameTableIndex) {
                     localTable->elements.data[i].rbpOffset = offset;
+                    found = true;
                     break;
                 }
             }
-        
-            if (currentNode->right && currentNode->right->data.type == nodeType::KEYWORD && 
-                currentNode->right->data.data.keyword == Keyword::ASSIGNMENT) {
 
-                IR_Register resultReg;
-                IR_Error error = generateExpressionIR(IRContext, currentNode->right->left, block, resultReg);
-                customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
-        
-                MOV_MEM_REG_MINUS_IMM_REG(IR_Register::RBP, offset, resultReg);
-                IRContext->variableRegisterCache[currentNode->data.data.nameTableIndex] = resultReg;
+            if (!found) {
+                return IR_Error::VARIABLE_NOT_FOUND;
             }
-        
-            break;
-        }
-        
-        case nodeType::PARAMETERS: {
-            node<astNode> *paramNode = currentNode->left;
-            size_t paramIndex = 0;
-
-            static const IR_Register argRegisters[] = {
-                IR_Register::RDI, IR_Register::RSI, IR_Register::RDX,
-                IR_Register::RCX, IR_Register::R8, IR_Register::R9
-            };
-
-            while (paramNode && paramNode->data.type == nodeType::VARIABLE_DECLARATION) {
-                size_t offset = IRContext->regAllocator->stackOffset + 8;
-                IRContext->regAllocator->stackOffset += 8;
-                paramNode->data.rbpOffset = offset;
-    
-                localNameTable *localTable = &IRContext->ASTContext->localTables->data[IRContext->currentFunction];
-                bool found = false;
-
-                for (size_t i = 0; i < localTable->size; i++) {
-                    if (localTable->elements.data[i].globalNameID == paramNode->data.data.nameTableIndex) {
-                        localTable->elements.data[i].rbpOffset = offset;
-                        found = true;
-                        break;
-                    }
-                }
 
-                if (!found) {
-                    return IR_Error::VARIABLE_NOT_FOUND;
-                }
-                
-                // store parameter in the register
-                if (paramIndex < 6) {
-                    MOV_MEM_REG_MINUS_IMM_REG(IR_Register::RBP, offset, argRegisters[paramIndex]);
-                // store parameter on stack
-                } else {
-                    size_t stackOffset = (paramIndex - 6) * 8 + 16;
-                    MOV_REG_MEM_REG_PLUS_IMM(IR_Register::RAX, IR_Register::RBP, stackOffset);
-                    MOV_MEM_REG_MINUS_IMM_REG(IR_Register::RBP, offset, IR_Register::RAX);
-                }
-
-                paramNode = paramNode->right;
-                paramIndex++;
-            }
-    
-            if (currentNode->right) {
-                IR_Error error = generateStatementIR(IRContext, currentNode->right, block);
-                customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_STATEMENT_IR_ERROR);
+            // store parameter in the register
+            if (paramIndex < 6) {
+                MOV_MEM_REG_MINUS_IMM_REG(IR_Register::RBP, offset, argRegisters[paramIndex]);
+            // store parameter on stack
+            } else {
+                size_t stackOffset = (paramIndex - 6) * 8 + 16;
+                MOV_REG_MEM_REG_PLUS_IMM(IR_Register::RAX, IR_Register::RBP, stackOffset);
+                MOV_MEM_REG_MINUS_IMM_REG(IR_Register::RBP, offset, IR_Register::RAX);
             }
 
-            break;
+            paramNode = RIGHT_(paramNode);
+            paramIndex++;
         }
 
-        case nodeType::FUNCTION_CALL: {
-            if (!currentNode->right || currentNode->right->data.type != nodeType::STRING ||
-                IRContext->ASTContext->nameTable->data[currentNode->right->data.data.nameTableIndex].type != nameType::IDENTIFIER) {
-                return IR_Error::AST_BAD_STRUCTURE;
-            }
+        if (RIGHT_(currentNode)) {
+            IR_Error error = generateStatementIR(IRContext, RIGHT_(currentNode), block);
+            customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_STATEMENT_IR_ERROR);
+        }
 
-            std::string funcName = IRContext->ASTContext->nameTable->data[currentNode->right->data.data.nameTableIndex].name;
+        return IR_Error::NO_ERRORS;
+    }
 
-            auto funcIt = IRContext->functionNameToIndex.find(funcName);
-            if (funcIt == IRContext->functionNameToIndex.end()) {
-                return IR_Error::AST_BAD_STRUCTURE;
-            }
+    IR_Error visitFunctionCall(compactNode *currentNode, IR_BasicBlock *block) {
+        if (!RIGHT_(currentNode) || RIGHT_(currentNode)->type != nodeType::STRING ||
+            IRContext->ASTContext->nameTable->data[RIGHT_(currentNode)->data.nameTableIndex].type != nameType::IDENTIFIER) {
+            return IR_Error::AST_BAD_STRUCTURE;
+        }
+
+        std::string funcName = IRContext->ASTContext->nameTable->data[RIGHT_(currentNode)->data.nameTableIndex].name;
 
-            size_t funcIndex = funcIt->second;
+        auto funcIt = IRContext->functionNameToIndex.find(funcName);
+        if (funcIt == IRContext->functionNameToIndex.end()) {
+            return IR_Error::AST_BAD_STRUCTURE;
+        }
 
-            // arguments 
-            std::vector<IR_Register> argRegs;
-            
-            if (currentNode->left && currentNode->left->data.type == nodeType::KEYWORD && 
-                currentNode->left->data.data.keyword == Keyword::ARGUMENT_SEPARATOR) {
-                node<astNode> *argNode = currentNode->left->left;
+        size_t funcIndex = funcIt->second;
 
-                while (argNode) {
-                    IR_Register argReg;
-                    IR_Error error = generateExpressionIR(IRContext, argNode, block, argReg);
-                    customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+        // arguments 
+        std::vector<IR_Register> argRegs;
 
-                    argRegs.push_back(argReg);
-                    argNode = (argNode->right && argNode->right->data.type == nodeType::KEYWORD && 
-                               argNode->right->data.data.keyword == Keyword::ARGUMENT_SEPARATOR) ? 
-                              argNode->right->left : NULL;
-                }
+        if (LEFT_(currentNode) && LEFT_(currentNode)->type == nodeType::KEYWORD && 
+            LEFT_(currentNode)->data.keyword == Keyword::ARGUMENT_SEPARATOR) {
+            compactNode *argNode = LEFT_(LEFT_(currentNode));
 
-            } else if (currentNode->left) {
+            while (argNode) {
                 IR_Register argReg;
-                IR_Error error = generateExpressionIR(IRContext, currentNode->left, block, argReg);
+                IR_Error error = generateExpressionIR(IRContext, argNode, block, argReg);
                 customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
 
                 argRegs.push_back(argReg);
+                argNode = (RIGHT_(argNode) && RIGHT_(argNode)->type == nodeType::KEYWORD && 
+                           RIGHT_(argNode)->data.keyword == Keyword::ARGUMENT_SEPARATOR) ? 
+                          LEFT_(RIGHT_(argNode)) : NULL;
             }
-        
-            // pass arguments
-            static const IR_Register argRegisters[] = {
-                IR_Register::RDI, IR_Register::RSI, IR_Register::RDX,
-                IR_Register::RCX, IR_Register::R8, IR_Register::R9
-            };
-
-            for (size_t i = 0; i < argRegs.size() && i < 6; ++i) {
-                if (argRegs[i] != argRegisters[i]) {
-                    MOV_REG_REG(argRegisters[i], argRegs[i]);
-                }
 
-                freeRegister(IRContext, IRContext->regAllocator, argRegs[i]);
+        } else if (LEFT_(currentNode)) {
+            IR_Register argReg;
+            IR_Error error = generateExpressionIR(IRContext, LEFT_(currentNode), block, argReg);
+            customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+            argRegs.push_back(argReg);
+        }
+
+        // pass arguments
+        static const IR_Register argRegisters[] = {
+            IR_Register::RDI, IR_Register::RSI, IR_Register::RDX,
+            IR_Register::RCX, IR_Register::R8, IR_Register::R9
+        };
+
+        for (size_t i = 0; i < argRegs.size() && i < 6; ++i) {
+            if (argRegs[i] != argRegisters[i]) {
+                MOV_REG_REG(argRegisters[i], argRegs[i]);
             }
 
-            if (argRegs.size() > 6) {
-                for (size_t i = 6; i < argRegs.size(); ++i) {
-                    PUSH_REG(argRegs[i]);
-                    freeRegister(IRContext, IRContext->regAllocator, argRegs[i]);
-                }
+            freeRegister(IRContext, IRContext->regAllocator, argRegs[i]);
+        }
+
+        if (argRegs.size() > 6) {
+            for (size_t i = 6; i < argRegs.size(); ++i) {
+                PUSH_REG(argRegs[i]);
+                freeRegister(IRContext, IRContext->regAllocator, argRegs[i]);
             }
-        
-            // generate call
-            IR_Instruction callInst = {
-                .op = IR_Operator::IR_CALL,
-                .operandCount = 1,
-                .firstOperand = { .type = IR_OperandType::FUNC_INDEX, .functionIndex = funcIndex }
-            };
-
-            insertNode(block->instructions, callInst);
-        
-            // return result
-            IR_Register resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
-            MOV_REG_REG(resultReg, IR_Register::RAX);
-            break;
-        }
-
-        case nodeType::KEYWORD: {
-            switch (currentNode->data.data.keyword) {
-                case Keyword::IF: {
-                    IR_BasicBlock *thenBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(thenBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(thenBlock, "then");
-
-                    IR_BasicBlock *mergeBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(mergeBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(mergeBlock, "merge");
-
-                    IR_Register conditionReg;
-                    IR_Error error = generateExpressionIR(IRContext, currentNode->left, block, conditionReg);
-                    customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
-
-                    insertNode(IRContext->representation->basicBlocks, thenBlock);
-                    insertNode(IRContext->representation->basicBlocks, mergeBlock);
-
-                    CMP_REG_IMM(conditionReg, 0);
-                    JMP_CONDITION(IR_Operator::IR_JE);
-
-                    insertNode(block->successors, thenBlock);
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(thenBlock->predecessors, block);
-                    insertNode(mergeBlock->predecessors, block);
-
-                    block = thenBlock;
-
-                    if (currentNode->right) {
-                        generateStatementIR(IRContext, currentNode->right, block);
-                    }
-
-                    JMP();
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(mergeBlock->predecessors, block);
-
-                    block = mergeBlock;
-                    freeRegister(IRContext, IRContext->regAllocator, conditionReg);
-                    break;
-                }
+        }
 
-                case Keyword::ASSIGNMENT: {
-                    IR_Register resultReg;
-                    IR_Error error = generateExpressionIR(IRContext, currentNode->right, block, resultReg);
-                    customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
-                
-                    size_t offset = getVariableOffset(IRContext, currentNode->left->data.data.nameTableIndex);
-                    customWarning(offset != 0, IR_Error::VARIABLE_NOT_FOUND);
-                
-                    MOV_MEM_REG_MINUS_IMM_REG(IR_Register::RBP, offset, resultReg);
-                    IRContext->variableRegisterCache[currentNode->left->data.data.nameTableIndex] = resultReg;
-                    break;
-                }
+        // generate call
+        IR_Instruction callInst = {
+            .op = IR_Operator::IR_CALL,
+            .operandCount = 1,
+            .firstOperand = { .type = IR_OperandType::FUNC_INDEX, .functionIndex = funcIndex }
+        };
 
-                case Keyword::WHILE: {
-                    IR_BasicBlock *condBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(condBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(condBlock, "while_cond");
-                
-                    IR_BasicBlock *bodyBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(bodyBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(bodyBlock, "while_body");
-                
-                    IR_BasicBlock *mergeBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(mergeBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(mergeBlock, "while_merge");
-                
-                    insertNode(IRContext->representation->basicBlocks, condBlock);
-                    insertNode(IRContext->representation->basicBlocks, bodyBlock);
-                    insertNode(IRContext->representation->basicBlocks, mergeBlock);
-                
-                    IR_Instruction jmpToCond = {
-                        .op = IR_Operator::IR_JMP,
-                        .operandCount = 1,
-                        .firstOperand = { .type = IR_OperandType::LABEL, .label = condBlock->label }
-                    };
-
-                    insertNode(block->instructions, jmpToCond);
-                    insertNode(block->successors, condBlock);
-                    insertNode(condBlock->predecessors, block);
-                
-                    block = condBlock;
-                    IR_Register conditionReg;
-
-                    IR_Error error = generateExpressionIR(IRContext, currentNode->left, block, conditionReg);
-                    customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
-                
-                    IR_Instruction jmpToMerge = {
-                        .op = IR_Operator::IR_JE,
-                        .operandCount = 1,
-                        .firstOperand = { .type = IR_OperandType::LABEL, .label = mergeBlock->label }
-                    };
-
-                    insertNode(block->instructions, jmpToMerge);
-                    insertNode(block->successors, bodyBlock);
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(bodyBlock->predecessors, block);
-                    insertNode(mergeBlock->predecessors, block);
-                
-                    block = bodyBlock;
-
-                    if (currentNode->right) {
-                        error = generateStatementIR(IRContext, currentNode->right, block);
-                        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_STATEMENT_IR_ERROR);
-                    }
-                
-                    IR_Instruction jmpBack = {
-                        .op = IR_Operator::IR_JMP,
-                        .operandCount = 1,
-                        .firstOperand = { .type = IR_OperandType::LABEL, .label = condBlock->label }
-                    };
-
-                    insertNode(block->instructions, jmpBack);
-                    insertNode(block->successors, condBlock);
-                    insertNode(condBlock->predecessors, block);
-                
-                    block = mergeBlock;
-                    freeRegister(IRContext, IRContext->regAllocator, conditionReg);
-                    break;
-                }
+        insertNode(block->instructions, callInst);
 
-                case Keyword::RETURN: {
-                    IRContext->hasReturn = true;
-                    if (currentNode->right) {
-                        IR_Register resultReg;
-                        IR_Error error = generateExpressionIR(IRContext, currentNode->right, block, resultReg);
-                        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+        // return result
+        IR_Register resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
+        MOV_REG_REG(resultReg, IR_Register::RAX);
 
-                        if (resultReg != IR_Register::RAX) {
-                            MOV_REG_REG(IR_Register::RAX, resultReg);
-                        }
+        return IR_Error::NO_ERRORS;
+    }
 
-                        freeRegister(IRContext, IRContext->regAllocator, resultReg);
-                    }
+    IR_Error visitIF(compactNode *currentNode, IR_BasicBlock *block) {
+        IR_BasicBlock *thenBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(thenBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(thenBlock, "then");
 
-                    MOV_REG_REG(IR_Register::RSP, IR_Register::RBP);
-                    POP_REG(IR_Register::RBP);
-                    RET();
-                    break;
-                }
+        IR_BasicBlock *mergeBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(mergeBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(mergeBlock, "merge");
 
-                case Keyword::OUT: {
-                    IR_Register resultReg;
-                    IR_Error error = generateExpressionIR(IRContext, currentNode->right, block, resultReg);
-                    customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+        IR_Register conditionReg;
+        IR_Error error = generateExpressionIR(IRContext, LEFT_(currentNode), block, conditionReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
 
-                    if (resultReg != IR_Register::RDI) {
-                        MOV_REG_REG(IR_Register::RDI, resultReg);
-                    }
+        insertNode(IRContext->representation->basicBlocks, thenBlock);
+        insertNode(IRContext->representation->basicBlocks, mergeBlock);
 
-                    // TODO:
-                    MOV_REG_IMM(IR_Register::RAX, 1);
-                    MOV_REG_IMM(IR_Register::RSI, 1);
-                    SYSCALL();
+        CMP_REG_IMM(conditionReg, 0);
+        JMP_CONDITION(IR_Operator::IR_JE);
 
-                    freeRegister(IRContext, IRContext->regAllocator, resultReg);
+        insertNode(block->successors, thenBlock);
+        insertNode(block->successors, mergeBlock);
+        insertNode(thenBlock->predecessors, block);
+        insertNode(mergeBlock->predecessors, block);
 
-                    break;
-                }
+        block = thenBlock;
 
-                // TODO:
-                case Keyword::BREAK:
-                case Keyword::CONTINUE:
-                case Keyword::IN:
-                case Keyword::ABORT: {
-                    MOV_REG_IMM(IR_Register::RDI, 1);
-                    MOV_REG_IMM(IR_Register::RAX, 60);
-                    SYSCALL();
+        if (RIGHT_(currentNode)) {
+            generateStatementIR(IRContext, RIGHT_(currentNode), block);
+        }
 
-                    break;
-                }
+        JMP();
+        insertNode(block->successors, mergeBlock);
+        insertNode(mergeBlock->predecessors, block);
 
-                case Keyword::OPERATOR_SEPARATOR: {
-                    if (currentNode->left) {
-                        IR_Error error = generateStatementIR(IRContext, currentNode->left, block);
-                        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_STATEMENT_IR_ERROR);
-                    }
+        block = mergeBlock;
+        freeRegister(IRContext, IRContext->regAllocator, conditionReg);
 
-                    if (currentNode->right) {
-                        IR_Error error = generateStatementIR(IRContext, currentNode->right, block);
-                        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_STATEMENT_IR_ERROR);
-                    }
+        return IR_Error::NO_ERRORS;
+    }
 
-                    break;
-                }
+    IR_Error visitASSIGNMENT(compactNode *currentNode, IR_BasicBlock *block) {
+        IR_Register resultReg;
+        IR_Error error = generateExpressionIR(IRContext, RIGHT_(currentNode), block, resultReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
 
-                default: {
-                    return IR_Error::AST_BAD_STRUCTURE;
-                }
+        size_t offset = getVariableOffset(IRContext, LEFT_(currentNode)->data.nameTableIndex);
+        customWarning(offset != 0, IR_Error::VARIABLE_NOT_FOUND);
+
+        MOV_MEM_REG_MINUS_IMM_REG(IR_Register::RBP, offset, resultReg);
+        IRContext->variableRegisterCache[LEFT_(currentNode)->data.nameTableIndex] = resultReg;
+
+        return IR_Error::NO_ERRORS;
+    }
+
+    IR_Error visitWHILE(compactNode *currentNode, IR_BasicBlock *block) {
+        IR_BasicBlock *condBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(condBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(condBlock, "while_cond");
+
+        IR_BasicBlock *bodyBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(bodyBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(bodyBlock, "while_body");
+
+        IR_BasicBlock *mergeBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(mergeBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(mergeBlock, "while_merge");
+
+        insertNode(IRContext->representation->basicBlocks, condBlock);
+        insertNode(IRContext->representation->basicBlocks, bodyBlock);
+        insertNode(IRContext->representation->basicBlocks, mergeBlock);
+
+        IR_Instruction jmpToCond = {
+            .op = IR_Operator::IR_JMP,
+            .operandCount = 1,
+            .firstOperand = { .type = IR_OperandType::LABEL, .label = condBlock->label }
+        };
+
+        insertNode(block->instructions, jmpToCond);
+        insertNode(block->successors, condBlock);
+        insertNode(condBlock->predecessors, block);
+
+        block = condBlock;
+        IR_Register conditionReg;
+
+        IR_Error error = generateExpressionIR(IRContext, LEFT_(currentNode), block, conditionReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        IR_Instruction jmpToMerge = {
+            .op = IR_Operator::IR_JE,
+            .operandCount = 1,
+            .firstOperand = { .type = IR_OperandType::LABEL, .label = mergeBlock->label }
+        };
+
+        insertNode(block->instructions, jmpToMerge);
+        insertNode(block->successors, bodyBlock);
+        insertNode(block->successors, mergeBlock);
+        insertNode(bodyBlock->predecessors, block);
+        insertNode(mergeBlock->predecessors, block);
+
+        block = bodyBlock;
+
+        if (RIGHT_(currentNode)) {
+            error = generateStatementIR(IRContext, RIGHT_(currentNode), block);
+            customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_STATEMENT_IR_ERROR);
+        }
+
+        IR_Instruction jmpBack = {
+            .op = IR_Operator::IR_JMP,
+            .operandCount = 1,
+            .firstOperand = { .type = IR_OperandType::LABEL, .label = condBlock->label }
+        };
+
+        insertNode(block->instructions, jmpBack);
+        insertNode(block->successors, condBlock);
+        insertNode(condBlock->predecessors, block);
+
+        block = mergeBlock;
+        freeRegister(IRContext, IRContext->regAllocator, conditionReg);
+
+        return IR_Error::NO_ERRORS;
+    }
+
+    IR_Error visitRETURN(compactNode *currentNode, IR_BasicBlock *block) {
+        IRContext->hasReturn = true;
+        if (RIGHT_(currentNode)) {
+            IR_Register resultReg;
+            IR_Error error = generateExpressionIR(IRContext, RIGHT_(currentNode), block, resultReg);
+            customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+            if (resultReg != IR_Register::RAX) {
+                MOV_REG_REG(IR_Register::RAX, resultReg);
             }
 
-            break;
+            freeRegister(IRContext, IRContext->regAllocator, resultReg);
         }
 
-        case nodeType::STRING: {
-            return IR_Error::AST_BAD_STRUCTURE;
+        MOV_REG_REG(IR_Register::RSP, IR_Register::RBP);
+        POP_REG(IR_Register::RBP);
+        RET();
+
+        return IR_Error::NO_ERRORS;
+    }
+
+    IR_Error visitOUT(compactNode *currentNode, IR_BasicBlock *block) {
+        IR_Register resultReg;
+        IR_Error error = generateExpressionIR(IRContext, RIGHT_(currentNode), block, resultReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        if (resultReg != IR_Register::RDI) {
+            MOV_REG_REG(IR_Register::RDI, resultReg);
         }
 
-        default:
-            return IR_Error::AST_BAD_STRUCTURE;
+        // TODO:
+        MOV_REG_IMM(IR_Register::RAX, 1);
+        MOV_REG_IMM(IR_Register::RSI, 1);
+        SYSCALL();
+
+        freeRegister(IRContext, IRContext->regAllocator, resultReg);
+
+        return IR_Error::NO_ERRORS;
     }
 
-    return IR_Error::NO_ERRORS;
-}
+    // TODO:
+    IR_Error generateExitIR(compactNode *currentNode, IR_BasicBlock *block) {
+        MOV_REG_IMM(IR_Register::RDI, 1);
+        MOV_REG_IMM(IR_Register::RAX, 60);
+        SYSCALL();
 
-// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+        return IR_Error::NO_ERRORS;
+    }
 
-IR_Error generateExpressionIR(IR_Context *IRContext, node<astNode> *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
-    customWarning(IRContext, IR_Error::IR_CONTEXT_BAD_POINTER);
-    customWarning(currentNode, IR_Error::NODE_BAD_POINTER);
-    customWarning(block, IR_Error::BASIC_BLOCK_BAD_POINTER);
+    IR_Error visitBREAK   (compactNode *currentNode, IR_BasicBlock *block) { return generateExitIR(currentNode, block); }
+    IR_Error visitCONTINUE(compactNode *currentNode, IR_BasicBlock *block) { return generateExitIR(currentNode, block); }
+    IR_Error visitIN      (compactNode *currentNode, IR_BasicBlock *block) { return generateExitIR(currentNode, block); }
+    IR_Error visitABORT   (compactNode *currentNode, IR_BasicBlock *block) { return generateExitIR(currentNode, block); }
+
+    IR_Error visitOPERATOR_SEPARATOR(compactNode *currentNode, IR_BasicBlock *block) {
+        compactChainIterator statements = {};
+        compactChainIteratorInitialize(&statements, IRContext->ASTContext->AST, currentNode, isOperatorSeparator);
+
+        while (compactNode *statement = compactChainIteratorNext(&statements)) {
+            IR_Error error = generateStatementIR(IRContext, statement, block);
+            customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_STATEMENT_IR_ERROR);
+        }
+
+        return IR_Error::NO_ERRORS;
+    }
+};
+
+// an operator evaluates both of its operands before anything else, even one it has no code for
+struct expressionIRGenerator : compactVisitor<expressionIRGenerator, IR_Error, IR_BasicBlock *, IR_Register &> {
+    IR_Context *IRContext = NULL;
 
-    if (!currentNode) {
+    IR_Error visitNode(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
         return IR_Error::AST_BAD_STRUCTURE;
     }
 
-    switch (currentNode->data.type) {
-        case nodeType::CONSTANT: {
-            resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
-            MOV_REG_IMM(resultReg, currentNode->data.data.number);
+    IR_Error generateOperandsIR(compactNode *currentNode, IR_BasicBlock *block, IR_Register &leftReg, IR_Register &rightReg) {
+        IR_Error error = generateExpressionIR(IRContext, LEFT_(currentNode), block, leftReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        error = generateExpressionIR(IRContext, RIGHT_(currentNode), block, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        return IR_Error::NO_ERRORS;
+    }
+
+    IR_Error visitKeyword(compactNode *currentNode, Keyword keyword, IR_BasicBlock *block, IR_Register &resultReg) {
+        IR_Register leftReg, rightReg;
+        IR_Error error = generateOperandsIR(currentNode, block, leftReg, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        return IR_Error::AST_BAD_STRUCTURE;
+    }
 
-            break;
+    IR_Error visitConstant(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
+        resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
+        MOV_REG_IMM(resultReg, currentNode->data.number);
+
+        return IR_Error::NO_ERRORS;
+    }
+
+    IR_Error visitString(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
+        if (!IRContext || !IRContext->ASTContext || !IRContext->ASTContext->nameTable) {
+            return IR_Error::IR_CONTEXT_BAD_POINTER;
         }
 
-        case nodeType::STRING: {
-            if (!IRContext || !IRContext->ASTContext || !IRContext->ASTContext->nameTable) {
-                return IR_Error::IR_CONTEXT_BAD_POINTER;
-            }
-        
-            size_t nameTableIndex = currentNode->data.data.nameTableIndex;
+        size_t nameTableIndex = currentNode->data.nameTableIndex;
 
-            if (nameTableIndex >= IRContext->ASTContext->nameTable->currentIndex) {
-                return IR_Error::AST_BAD_STRUCTURE;
-            }
-        
-            std::string name = IRContext->ASTContext->nameTable->data[nameTableIndex].name;
-            nameType identType = IRContext->ASTContext->nameTable->data[nameTableIndex].type;
-        
-            if (identType != nameType::IDENTIFIER) {
-                return IR_Error::AST_BAD_STRUCTURE;
-            }
-        
-            size_t offset = getVariableOffset(IRContext, nameTableIndex);
-            if (offset == 0) {
-                return IR_Error::VARIABLE_NOT_FOUND;
-            }
-        
-            // check register cache
-            auto cacheIt = IRContext->variableRegisterCache.find(nameTableIndex);
+        if (nameTableIndex >= IRContext->ASTContext->nameTable->currentIndex) {
+            return IR_Error::AST_BAD_STRUCTURE;
+        }
 
-            if (cacheIt != IRContext->variableRegisterCache.end()) {
-                resultReg = cacheIt->second;
-            } else {
-                resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
-                MOV_REG_MEM_REG_MINUS_IMM(resultReg, IR_Register::RBP, offset);
-                IRContext->variableRegisterCache[nameTableIndex] = resultReg;
-            }
-        
-            break;
+        std::string name = IRContext->ASTContext->nameTable->data[nameTableIndex].name;
+        nameType identType = IRContext->ASTContext->nameTable->data[nameTableIndex].type;
+
+        if (identType != nameType::IDENTIFIER) {
+            return IR_Error::AST_BAD_STRUCTURE;
         }
 
-        case nodeType::FUNCTION_CALL: {
-            if (!currentNode->right || currentNode->right->data.type != nodeType::STRING) {
-                return IR_Error::AST_BAD_STRUCTURE;
-            }
+        size_t offset = getVariableOffset(IRContext, nameTableIndex);
+        if (offset == 0) {
+            return IR_Error::VARIABLE_NOT_FOUND;
+        }
+
+        // check register cache
+        auto cacheIt = IRContext->variableRegisterCache.find(nameTableIndex);
 
-            std::string funcName = IRContext->ASTContext->nameTable->data[currentNode->right->data.data.nameTableIndex].name;
-        
-            // handle arguments
-            std::vector<IR_Register> argRegs;
+        if (cacheIt != IRContext->variableRegisterCache.end()) {
+            resultReg = cacheIt->second;
+        } else {
+            resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
+            MOV_REG_MEM_REG_MINUS_IMM(resultReg, IR_Register::RBP, offset);
+            IRContext->variableRegisterCache[nameTableIndex] = resultReg;
+        }
 
-            if (currentNode->left && currentNode->left->data.type == nodeType::KEYWORD && 
-                currentNode->left->data.data.keyword == Keyword::ARGUMENT_SEPARATOR) {
-                node<astNode> *argNode = currentNode->left->left;
+        return IR_Error::NO_ERRORS;
+    }
 
-                while (argNode) {
-                    IR_Register argReg;
-                    IR_Error error = generateExpressionIR(IRContext, argNode, block, argReg);
-                    customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+    IR_Error visitFunctionCall(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
+        if (!RIGHT_(currentNode) || RIGHT_(currentNode)->type != nodeType::STRING) {
+            return IR_Error::AST_BAD_STRUCTURE;
+        }
 
-                    argRegs.push_back(argReg);
-                    argNode = (argNode->right && argNode->right->data.type == nodeType::KEYWORD && 
-                               argNode->right->data.data.keyword == Keyword::ARGUMENT_SEPARATOR) ? 
-                              argNode->right->left : NULL;
-                }
+        std::string funcName = IRContext->ASTContext->nameTable->data[RIGHT_(currentNode)->data.nameTableIndex].name;
 
-            } else if (currentNode->left) {
-                // single argument
-                IR_Register argReg;
+        // handle arguments
+        std::vector<IR_Register> argRegs;
 
-                IR_Error error = generateExpressionIR(IRContext, currentNode->left, block, argReg);
+        if (LEFT_(currentNode) && LEFT_(currentNode)->type == nodeType::KEYWORD && 
+            LEFT_(currentNode)->data.keyword == Keyword::ARGUMENT_SEPARATOR) {
+            compactNode *argNode = LEFT_(LEFT_(currentNode));
+
+            while (argNode) {
+                IR_Register argReg;
+                IR_Error error = generateExpressionIR(IRContext, argNode, block, argReg);
                 customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
-                
+
                 argRegs.push_back(argReg);
+                argNode = (RIGHT_(argNode) && RIGHT_(argNode)->type == nodeType::KEYWORD && 
+                           RIGHT_(argNode)->data.keyword == Keyword::ARGUMENT_SEPARATOR) ? 
+                          LEFT_(RIGHT_(argNode)) : NULL;
             }
-        
-            // pass arguments in registers
-            static const IR_Register argRegisters[] = {
-                IR_Register::RDI, IR_Register::RSI, IR_Register::RDX,
-                IR_Register::RCX, IR_Register::R8, IR_Register::R9
-            };
-
-            for (size_t i = 0; i < argRegs.size() && i < 6; ++i) {
-                if (argRegs[i] != argRegisters[i]) {
-                    MOV_REG_REG(argRegisters[i], argRegs[i]);
-                }
 
-                freeRegister(IRContext, IRContext->regAllocator, argRegs[i]);
-            }
+        } else if (LEFT_(currentNode)) {
+            // single argument
+            IR_Register argReg;
 
-            if (argRegs.size() > 6) {
-                for (size_t i = 6; i < argRegs.size(); ++i) {
-                    PUSH_REG(argRegs[i]);
-                    freeRegister(IRContext, IRContext->regAllocator, argRegs[i]);
-                }
-            }
-        
-            // generate call instruction
-            IR_Instruction callInst = {
-                .op = IR_Operator::IR_CALL,
-                .operandCount = 1,
-                .firstOperand = { .type = IR_OperandType::FUNC_INDEX, .functionIndex = currentNode->right->data.data.nameTableIndex }
-            };
-
-            insertNode(block->instructions, callInst);
-        
-            // return result in resultReg
-            resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
-            MOV_REG_REG(resultReg, IR_Register::RAX);
+            IR_Error error = generateExpressionIR(IRContext, LEFT_(currentNode), block, argReg);
+            customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
 
-            break;
+            argRegs.push_back(argReg);
         }
 
-        case nodeType::KEYWORD: {
-            IR_Register leftReg, rightReg;
-            IR_Error error = generateExpressionIR(IRContext, currentNode->left, block, leftReg);
-            customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+        // pass arguments in registers
+        static const IR_Register argRegisters[] = {
+            IR_Register::RDI, IR_Register::RSI, IR_Register::RDX,
+            IR_Register::RCX, IR_Register::R8, IR_Register::R9
+        };
 
-            error = generateExpressionIR(IRContext, currentNode->right, block, rightReg);
-            customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+        for (size_t i = 0; i < argRegs.size() && i < 6; ++i) {
+            if (argRegs[i] != argRegisters[i]) {
+                MOV_REG_REG(argRegisters[i], argRegs[i]);
+            }
 
-            switch (currentNode->data.data.keyword) {
-                case Keyword::ADD: {
-                    ADD_REG_REG(leftReg, rightReg);
-                    resultReg = leftReg;
-                    freeRegister(IRContext, IRContext->regAllocator, rightReg);
+            freeRegister(IRContext, IRContext->regAllocator, argRegs[i]);
+        }
 
-                    break;
-                }
+        if (argRegs.size() > 6) {
+            for (size_t i = 6; i < argRegs.size(); ++i) {
+                PUSH_REG(argRegs[i]);
+                freeRegister(IRContext, IRContext->regAllocator, argRegs[i]);
+            }
+        }
 
-                case Keyword::SUB: {
-                    SUB_REG_REG(leftReg, rightReg);
-                    resultReg = leftReg;
-                    freeRegister(IRContext, IRContext->regAllocator, rightReg);
+        // generate call instruction
+        IR_Instruction callInst = {
+            .op = IR_Operator::IR_CALL,
+            .operandCount = 1,
+            .firstOperand = { .type = IR_OperandType::FUNC_INDEX, .functionIndex = RIGHT_(currentNode)->data.nameTableIndex }
+        };
 
-                    break;
-                }
+        insertNode(block->instructions, callInst);
 
-                case Keyword::MUL: {
-                    IMUL_REG_REG(leftReg, rightReg);
-                    resultReg = leftReg;
-                    freeRegister(IRContext, IRContext->regAllocator, rightReg);
+        // return result in resultReg
+        resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
+        MOV_REG_REG(resultReg, IR_Register::RAX);
 
-                    break;
-                }
+        return IR_Error::NO_ERRORS;
+    }
 
-                case Keyword::DIV: {
-                    IR_Register divReg = rightReg;
-                    if (rightReg == IR_Register::RAX) {
-                        divReg = allocateRegister(IRContext, IRContext->regAllocator, block);
-                        MOV_REG_REG(divReg, rightReg);
-                    }
-                
-                    if (leftReg != IR_Register::RAX) {
-                        MOV_REG_REG(IR_Register::RAX, leftReg);
-                    }
-                
-                    CQO();
-                    IDIV_REG(divReg);
-                
-                    resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
-                    MOV_REG_REG(resultReg, IR_Register::RAX);
-                
-                    if (leftReg != resultReg && leftReg != IR_Register::RAX) {
-                        freeRegister(IRContext, IRContext->regAllocator, leftReg);
-                    }
-                    if (divReg != resultReg && divReg != leftReg) {
-                        freeRegister(IRContext, IRContext->regAllocator, divReg);
-                    }
-                
-                    // if assignment => update variable register cache
-                    node<astNode> *parent = currentNode;
-
-                    while (parent && parent->data.type != nodeType::VARIABLE_DECLARATION && parent->data.type != nodeType::KEYWORD) {
-                        parent = parent->parent;
-                    }
-
-                    if (parent && parent->data.type == nodeType::VARIABLE_DECLARATION) {
-                        IRContext->variableRegisterCache[parent->data.data.nameTableIndex] = resultReg;
-                    } else if (parent && parent->data.type == nodeType::KEYWORD && parent->data.data.keyword == Keyword::ASSIGNMENT) {
-                        IRContext->variableRegisterCache[parent->left->data.data.nameTableIndex] = resultReg;
-                    }
-                
-                    break;
-                }
+    IR_Error visitADD(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
+        IR_Register leftReg, rightReg;
+        IR_Error error = generateOperandsIR(currentNode, block, leftReg, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
 
-                case Keyword::LESS:
-                case Keyword::GREATER:
-                case Keyword::LESS_OR_EQUAL:
-                case Keyword::GREATER_OR_EQUAL:
-                case Keyword::NOT_EQUAL:
-                case Keyword::EQUAL: {
-                    CMP_REG_REG(leftReg, rightReg);
-                    resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
-                    MOV_REG_IMM(resultReg, 0);
-
-                    IR_BasicBlock *trueBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(trueBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(trueBlock, "true");
-
-                    IR_BasicBlock *mergeBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(mergeBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(mergeBlock, "merge");
-
-                    insertNode(IRContext->representation->basicBlocks, trueBlock);
-                    insertNode(IRContext->representation->basicBlocks, mergeBlock);
-
-                    IR_Operator jmpOp;
-
-                    switch (currentNode->data.data.keyword) {
-                        case Keyword::EQUAL:            jmpOp = IR_Operator::IR_JE;     break;
-                        case Keyword::LESS:             jmpOp = IR_Operator::IR_JL;     break;
-                        case Keyword::GREATER:          jmpOp = IR_Operator::IR_JG;     break;
-                        case Keyword::LESS_OR_EQUAL:    jmpOp = IR_Operator::IR_JLE;    break;
-                        case Keyword::GREATER_OR_EQUAL: jmpOp = IR_Operator::IR_JGE;    break;
-                        case Keyword::NOT_EQUAL:        jmpOp = IR_Operator::IR_JNE;    break;
-                        default: return IR_Error::AST_BAD_STRUCTURE;
-                    }
-
-                    JMP_CONDITION(jmpOp);
-                    insertNode(block->successors, trueBlock);
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(trueBlock->predecessors, block);
-                    insertNode(mergeBlock->predecessors, block);
-
-                    block = trueBlock;
-                    MOV_REG_IMM(resultReg, 1);
-                    JMP();
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(mergeBlock->predecessors, block);
-
-                    block = mergeBlock;
-                    freeRegister(IRContext, IRContext->regAllocator, leftReg);
-                    freeRegister(IRContext, IRContext->regAllocator, rightReg);
+        ADD_REG_REG(leftReg, rightReg);
+        resultReg = leftReg;
+        freeRegister(IRContext, IRContext->regAllocator, rightReg);
 
-                    break;
-                }
+        return IR_Error::NO_ERRORS;
+    }
 
-                case Keyword::AND: {
-                    CMP_REG_IMM(leftReg, 0);
-                    IR_BasicBlock *falseBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(falseBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(falseBlock, "false");
-
-                    IR_BasicBlock *mergeBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(mergeBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(mergeBlock, "merge");
-
-                    insertNode(IRContext->representation->basicBlocks, falseBlock);
-                    insertNode(IRContext->representation->basicBlocks, mergeBlock);
-
-                    JMP_CONDITION(IR_Operator::IR_JE);
-                    insertNode(block->successors, falseBlock);
-                    insertNode(falseBlock->predecessors, block);
-
-                    error = generateExpressionIR(IRContext, currentNode->right, block, rightReg);
-                    customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
-
-                    CMP_REG_IMM(rightReg, 0);
-                    JMP_CONDITION(IR_Operator::IR_JE);
-                    insertNode(block->successors, falseBlock);
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(falseBlock->predecessors, block);
-                    insertNode(mergeBlock->predecessors, block);
-
-                    resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
-                    MOV_REG_IMM(resultReg, 1);
-                    JMP();
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(mergeBlock->predecessors, block);
-
-                    block = falseBlock;
-                    MOV_REG_IMM(resultReg, 0);
-                    JMP();
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(mergeBlock->predecessors, block);
-
-                    block = mergeBlock;
-                    freeRegister(IRContext, IRContext->regAllocator, leftReg);
-                    freeRegister(IRContext, IRContext->regAllocator, rightReg);
-                    break;
-                }
+    IR_Error visitSUB(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
+        IR_Register leftReg, rightReg;
+        IR_Error error = generateOperandsIR(currentNode, block, leftReg, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
 
-                case Keyword::OR: {
-                    CMP_REG_IMM(leftReg, 1);
-                    IR_BasicBlock *trueBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(trueBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(trueBlock, "true");
-
-                    IR_BasicBlock *mergeBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(mergeBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(mergeBlock, "merge");
-
-                    insertNode(IRContext->representation->basicBlocks, trueBlock);
-                    insertNode(IRContext->representation->basicBlocks, mergeBlock);
-
-                    JMP_CONDITION(IR_Operator::IR_JE);
-                    insertNode(block->successors, trueBlock);
-                    insertNode(trueBlock->predecessors, block);
-
-                    error = generateExpressionIR(IRContext, currentNode->right, block, rightReg);
-                    customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
-
-                    CMP_REG_IMM(rightReg, 1);
-                    JMP_CONDITION(IR_Operator::IR_JE);
-                    insertNode(block->successors, trueBlock);
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(trueBlock->predecessors, block);
-                    insertNode(mergeBlock->predecessors, block);
-
-                    resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
-                    MOV_REG_IMM(resultReg, 0);
-                    JMP();
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(mergeBlock->predecessors, block);
-
-                    block = trueBlock;
-                    MOV_REG_IMM(resultReg, 1);
-                    JMP();
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(mergeBlock->predecessors, block);
-
-                    block = mergeBlock;
-                    freeRegister(IRContext, IRContext->regAllocator, leftReg);
-                    freeRegister(IRContext, IRContext->regAllocator, rightReg);
-                    break;
-                }
+        SUB_REG_REG(leftReg, rightReg);
+        resultReg = leftReg;
+        freeRegister(IRContext, IRContext->regAllocator, rightReg);
 
-                case Keyword::NOT: {
-                    IR_Register operandReg;
-                    IR_Error error = generateExpressionIR(IRContext, currentNode->right, block, operandReg);
-                    customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+        return IR_Error::NO_ERRORS;
+    }
 
-                    resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
-                    MOV_REG_IMM(resultReg, 0);
-                    CMP_REG_IMM(operandReg, 0);
+    IR_Error visitMUL(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
+        IR_Register leftReg, rightReg;
+        IR_Error error = generateOperandsIR(currentNode, block, leftReg, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
 
-                    IR_BasicBlock *trueBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(trueBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(trueBlock, "true");
+        IMUL_REG_REG(leftReg, rightReg);
+        resultReg = leftReg;
+        freeRegister(IRContext, IRContext->regAllocator, rightReg);
 
-                    IR_BasicBlock *mergeBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
-                    customWarning(mergeBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
-                    initializeBasicBlock(mergeBlock, "merge");
+        return IR_Error::NO_ERRORS;
+    }
 
-                    insertNode(IRContext->representation->basicBlocks, trueBlock);
-                    insertNode(IRContext->representation->basicBlocks, mergeBlock);
+    IR_Error visitDIV(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
+        IR_Register leftReg, rightReg;
+        IR_Error error = generateOperandsIR(currentNode, block, leftReg, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
 
-                    JMP_CONDITION(IR_Operator::IR_JE);
-                    insertNode(block->successors, trueBlock);
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(trueBlock->predecessors, block);
-                    insertNode(mergeBlock->predecessors, block);
+        IR_Register divReg = rightReg;
+        if (rightReg == IR_Register::RAX) {
+            divReg = allocateRegister(IRContext, IRContext->regAllocator, block);
+            MOV_REG_REG(divReg, rightReg);
+        }
 
-                    block = trueBlock;
-                    MOV_REG_IMM(resultReg, 1);
-                    JMP();
-                    insertNode(block->successors, mergeBlock);
-                    insertNode(mergeBlock->predecessors, block);
+        if (leftReg != IR_Register::RAX) {
+            MOV_REG_REG(IR_Register::RAX, leftReg);
+        }
 
-                    block = mergeBlock;
-                    freeRegister(IRContext, IRContext->regAllocator, operandReg);
-                    break;
-                }
+        CQO();
+        IDIV_REG(divReg);
 
-                // TODO:
-                case Keyword::SIN:
-                case Keyword::COS:
-                case Keyword::FLOOR:
-                case Keyword::SQRT:
-                case Keyword::DIFF:
-                case Keyword::IN: {
-                    resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
-                    return IR_Error::NOT_IMPLEMENTED;
-                }
+        resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
+        MOV_REG_REG(resultReg, IR_Register::RAX);
 
-                default: {
-                    return IR_Error::AST_BAD_STRUCTURE;
-                }
-            }
+        if (leftReg != resultReg && leftReg != IR_Register::RAX) {
+            freeRegister(IRContext, IRContext->regAllocator, leftReg);
+        }
+        if (divReg != resultReg && divReg != leftReg) {
+            freeRegister(IRContext, IRContext->regAllocator, divReg);
+        }
 
-            break;
+        // if assignment => update variable register cache
+        compactNode *parent = currentNode;
+
+        while (parent && parent->type != nodeType::VARIABLE_DECLARATION && parent->type != nodeType::KEYWORD) {
+            parent = PARENT_(parent);
         }
 
-        default: {
-            return IR_Error::AST_BAD_STRUCTURE;
+        if (parent && parent->type == nodeType::VARIABLE_DECLARATION) {
+            IRContext->variableRegisterCache[parent->data.nameTableIndex] = resultReg;
+        } else if (parent && parent->type == nodeType::KEYWORD && parent->data.keyword == Keyword::ASSIGNMENT) {
+            IRContext->variableRegisterCache[LEFT_(parent)->data.nameTableIndex] = resultReg;
         }
+
+        return IR_Error::NO_ERRORS;
     }
 
-    return IR_Error::NO_ERRORS;
+    IR_Error generateComparisonIR(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg, IR_Operator jmpOp) {
+        IR_Register leftReg, rightReg;
+        IR_Error error = generateOperandsIR(currentNode, block, leftReg, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        CMP_REG_REG(leftReg, rightReg);
+        resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
+        MOV_REG_IMM(resultReg, 0);
+
+        IR_BasicBlock *trueBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(trueBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(trueBlock, "true");
+
+        IR_BasicBlock *mergeBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(mergeBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(mergeBlock, "merge");
+
+        insertNode(IRContext->representation->basicBlocks, trueBlock);
+        insertNode(IRContext->representation->basicBlocks, mergeBlock);
+
+        JMP_CONDITION(jmpOp);
+        insertNode(block->successors, trueBlock);
+        insertNode(block->successors, mergeBlock);
+        insertNode(trueBlock->predecessors, block);
+        insertNode(mergeBlock->predecessors, block);
+
+        block = trueBlock;
+        MOV_REG_IMM(resultReg, 1);
+        JMP();
+        insertNode(block->successors, mergeBlock);
+        insertNode(mergeBlock->predecessors, block);
+
+        block = mergeBlock;
+        freeRegister(IRContext, IRContext->regAllocator, leftReg);
+        freeRegister(IRContext, IRContext->regAllocator, rightReg);
+
+        return IR_Error::NO_ERRORS;
+    }
+
+    IR_Error visitEQUAL           (compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) { return generateComparisonIR(currentNode, block, resultReg, IR_Operator::IR_JE); }
+    IR_Error visitLESS            (compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) { return generateComparisonIR(currentNode, block, resultReg, IR_Operator::IR_JL); }
+    IR_Error visitGREATER         (compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) { return generateComparisonIR(currentNode, block, resultReg, IR_Operator::IR_JG); }
+    IR_Error visitLESS_OR_EQUAL   (compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) { return generateComparisonIR(currentNode, block, resultReg, IR_Operator::IR_JLE); }
+    IR_Error visitGREATER_OR_EQUAL(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) { return generateComparisonIR(currentNode, block, resultReg, IR_Operator::IR_JGE); }
+    IR_Error visitNOT_EQUAL       (compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) { return generateComparisonIR(currentNode, block, resultReg, IR_Operator::IR_JNE); }
+
+    IR_Error visitAND(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
+        IR_Register leftReg, rightReg;
+        IR_Error error = generateOperandsIR(currentNode, block, leftReg, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        CMP_REG_IMM(leftReg, 0);
+        IR_BasicBlock *falseBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(falseBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(falseBlock, "false");
+
+        IR_BasicBlock *mergeBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(mergeBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(mergeBlock, "merge");
+
+        insertNode(IRContext->representation->basicBlocks, falseBlock);
+        insertNode(IRContext->representation->basicBlocks, mergeBlock);
+
+        JMP_CONDITION(IR_Operator::IR_JE);
+        insertNode(block->successors, falseBlock);
+        insertNode(falseBlock->predecessors, block);
+
+        error = generateExpressionIR(IRContext, RIGHT_(currentNode), block, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        CMP_REG_IMM(rightReg, 0);
+        JMP_CONDITION(IR_Operator::IR_JE);
+        insertNode(block->successors, falseBlock);
+        insertNode(block->successors, mergeBlock);
+        insertNode(falseBlock->predecessors, block);
+        insertNode(mergeBlock->predecessors, block);
+
+        resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
+        MOV_REG_IMM(resultReg, 1);
+        JMP();
+        insertNode(block->successors, mergeBlock);
+        insertNode(mergeBlock->predecessors, block);
+
+        block = falseBlock;
+        MOV_REG_IMM(resultReg, 0);
+        JMP();
+        insertNode(block->successors, mergeBlock);
+        insertNode(mergeBlock->predecessors, block);
+
+        block = mergeBlock;
+        freeRegister(IRContext, IRContext->regAllocator, leftReg);
+        freeRegister(IRContext, IRContext->regAllocator, rightReg);
+
+        return IR_Error::NO_ERRORS;
+    }
+
+    IR_Error visitOR(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
+        IR_Register leftReg, rightReg;
+        IR_Error error = generateOperandsIR(currentNode, block, leftReg, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        CMP_REG_IMM(leftReg, 1);
+        IR_BasicBlock *trueBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(trueBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(trueBlock, "true");
+
+        IR_BasicBlock *mergeBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(mergeBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(mergeBlock, "merge");
+
+        insertNode(IRContext->representation->basicBlocks, trueBlock);
+        insertNode(IRContext->representation->basicBlocks, mergeBlock);
+
+        JMP_CONDITION(IR_Operator::IR_JE);
+        insertNode(block->successors, trueBlock);
+        insertNode(trueBlock->predecessors, block);
+
+        error = generateExpressionIR(IRContext, RIGHT_(currentNode), block, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        CMP_REG_IMM(rightReg, 1);
+        JMP_CONDITION(IR_Operator::IR_JE);
+        insertNode(block->successors, trueBlock);
+        insertNode(block->successors, mergeBlock);
+        insertNode(trueBlock->predecessors, block);
+        insertNode(mergeBlock->predecessors, block);
+
+        resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
+        MOV_REG_IMM(resultReg, 0);
+        JMP();
+        insertNode(block->successors, mergeBlock);
+        insertNode(mergeBlock->predecessors, block);
+
+        block = trueBlock;
+        MOV_REG_IMM(resultReg, 1);
+        JMP();
+        insertNode(block->successors, mergeBlock);
+        insertNode(mergeBlock->predecessors, block);
+
+        block = mergeBlock;
+        freeRegister(IRContext, IRContext->regAllocator, leftReg);
+        freeRegister(IRContext, IRContext->regAllocator, rightReg);
+
+        return IR_Error::NO_ERRORS;
+    }
+
+    IR_Error visitNOT(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
+        IR_Register leftReg, rightReg;
+        IR_Error error = generateOperandsIR(currentNode, block, leftReg, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        IR_Register operandReg;
+        error = generateExpressionIR(IRContext, RIGHT_(currentNode), block, operandReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
+        MOV_REG_IMM(resultReg, 0);
+        CMP_REG_IMM(operandReg, 0);
+
+        IR_BasicBlock *trueBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(trueBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(trueBlock, "true");
+
+        IR_BasicBlock *mergeBlock = (IR_BasicBlock *)calloc(1, sizeof(IR_BasicBlock));
+        customWarning(mergeBlock, IR_Error::BASIC_BLOCK_BAD_POINTER);
+        initializeBasicBlock(mergeBlock, "merge");
+
+        insertNode(IRContext->representation->basicBlocks, trueBlock);
+        insertNode(IRContext->representation->basicBlocks, mergeBlock);
+
+        JMP_CONDITION(IR_Operator::IR_JE);
+        insertNode(block->successors, trueBlock);
+        insertNode(block->successors, mergeBlock);
+        insertNode(trueBlock->predecessors, block);
+        insertNode(mergeBlock->predecessors, block);
+
+        block = trueBlock;
+        MOV_REG_IMM(resultReg, 1);
+        JMP();
+        insertNode(block->successors, mergeBlock);
+        insertNode(mergeBlock->predecessors, block);
+
+        block = mergeBlock;
+        freeRegister(IRContext, IRContext->regAllocator, operandReg);
+
+        return IR_Error::NO_ERRORS;
+    }
+
+    // TODO:
+    IR_Error generateNotImplementedIR(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
+        IR_Register leftReg, rightReg;
+        IR_Error error = generateOperandsIR(currentNode, block, leftReg, rightReg);
+        customWarning(error == IR_Error::NO_ERRORS, IR_Error::GENERATE_EXPRESSION_IR_ERROR);
+
+        resultReg = allocateRegister(IRContext, IRContext->regAllocator, block);
+
+        return IR_Error::NOT_IMPLEMENTED;
+    }
+
+    IR_Error visitSIN  (compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) { return generateNotImplementedIR(currentNode, block, resultReg); }
+    IR_Error visitCOS  (compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) { return generateNotImplementedIR(currentNode, block, resultReg); }
+    IR_Error visitFLOOR(compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) { return generateNotImplementedIR(currentNode, block, resultReg); }
+    IR_Error visitSQRT (compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) { return generateNotImplementedIR(currentNode, block, resultReg); }
+    IR_Error visitDIFF (compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) { return generateNotImplementedIR(currentNode, block, resultReg); }
+    IR_Error visitIN   (compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) { return generateNotImplementedIR(currentNode, block, resultReg); }
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+IR_Error generateStatementIR(IR_Context *IRContext, compactNode *currentNode, IR_BasicBlock *block) {
+    customWarning(IRContext, IR_Error::IR_CONTEXT_BAD_POINTER);
+    customWarning(block, IR_Error::BASIC_BLOCK_BAD_POINTER);
+
+    customWarning(currentNode, IR_Error::NODE_BAD_POINTER);
+
+    statementIRGenerator generator = {{}, IRContext};
+
+    return generator.visit(currentNode, block);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+IR_Error generateExpressionIR(IR_Context *IRContext, compactNode *currentNode, IR_BasicBlock *block, IR_Register &resultReg) {
+    customWarning(IRContext, IR_Error::IR_CONTEXT_BAD_POINTER);
+    customWarning(currentNode, IR_Error::NODE_BAD_POINTER);
+    customWarning(block, IR_Error::BASIC_BLOCK_BAD_POINTER);
+
+    expressionIRGenerator generator = {{}, IRContext};
+
+    return generator.visit(currentNode, block, resultReg);
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
\ No newline at end of file
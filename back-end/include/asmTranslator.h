@@ -21,7 +21,7 @@ translationError translateToASM(translationContext *context, const char *fileNam
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
 translationError initializeProgram(translationContext *context, Buffer<char> *outputData);
-translationError traverseAST      (translationContext *context, node<astNode> *node, Buffer<char> *outputData, size_t nameTableIndex);
+translationError traverseAST      (translationContext *context, compactNode *node, Buffer<char> *outputData, size_t nameTableIndex);
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
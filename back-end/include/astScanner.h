@@ -0,0 +1,38 @@
+#ifndef AST_SCANNER_H_
+#define AST_SCANNER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const size_t AST_SCANNER_BLOCK_SIZE = 64;
+
+// walks the tokens of a text .AST or .nameTable file: every field there is a run of non-space bytes.
+// the starts of the runs are found a block at a time (AVX2, SSE2 or scalar, picked once at runtime with cpuid)
+// and handed out one by one, so the reader never looks at a space
+struct astScanner {
+    const char *text        = NULL;
+    size_t      size        = 0;
+
+    size_t      blockBegin  = 0;    // the block tokenStarts describes
+    size_t      blockEnd    = 0;    // where the next block starts
+    uint64_t    tokenStarts = 0;    // bit i: a token not handed out yet starts at blockBegin + i
+    bool        afterSpace  = true; // the byte before blockEnd is a space, or there is none
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// begin counts as the start of a token even if the byte before it is not a space
+void   initializeASTScanner(astScanner *scanner, const char *text, size_t size, size_t begin);
+
+// the offset of the next token, scanner->size when there are no more
+size_t nextASTToken        (astScanner *scanner);
+
+inline bool isASTSpace(char symbol) {
+    return symbol == ' ' || (symbol >= '\t' && symbol <= '\r');
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // AST_SCANNER_H_
@@ -5,6 +5,7 @@
 #include <stdbool.h>
 
 #include "AST.h"
+#include "compactAST.h"
 #include "binaryTreeDef.h"
 #include "buffer.h"
 #include "nameTable.h"
@@ -37,9 +38,10 @@ struct operatorCounters {
 };
 
 struct translationContext {
-    binaryTree<astNode> *AST = {};
+    compactAST *AST = {};
 
     Buffer<nameTableElement> *nameTable   = {};
+    nameInterner             *interner    = {};
     Buffer<localNameTable>   *localTables = {};
 
     translationError error = translationError::NO_ERRORS;
@@ -62,4 +64,11 @@ translationError destroyTranslationContext   (translationContext *context);
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
+// the reader turns every separator into a keyword node, so this holds for trees read from an .AST file only
+inline bool isOperatorSeparator(compactNode *currentNode) {
+    return currentNode->type == nodeType::KEYWORD && currentNode->data.keyword == Keyword::OPERATOR_SEPARATOR;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
 #endif // CORE_H_
\ No newline at end of file
@@ -2,11 +2,13 @@
 #define TREE_READER_H_
 
 #include "core.h"
+#include "binaryAST.h"
+#include "astHandoff.h"
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
 translationError readAST            (translationContext *context, const char *fileName);
-node<astNode>   *readASTInternal    (translationContext *context, Buffer<char> *fileContent, size_t *currentFilePosition);
+astHandle        readASTInternal    (translationContext *context, Buffer<char> *fileContent, size_t *currentFilePosition);
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
@@ -16,4 +18,12 @@ translationError readLocalNameTable (translationContext *context, size_t localTa
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
+// the name table and the tree at once from a file written by saveBinaryAST or from an image built by buildBinaryAST
+translationError readBinaryAST      (translationContext *context, const char *fileName);
+translationError importBinaryAST    (translationContext *context, const binaryAST *ast);
+// the same tables and tree straight from the front-end, with nothing serialized on the way
+translationError importASTHandoff   (translationContext *context, const astHandoff *handoff);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
 #endif // TREE_READER_H_
\ No newline at end of file
@@ -8,7 +8,8 @@
 #include "linkedListAddons.h"
 #include "treeReader.h"
 
-int main() {
+// backend [file.bin] reads what the front-end writes by default, the text pair below stays for trees saved with --text-ast
+int main(int argc, char *argv[]) {
     const char *ASTFileName = "22.04.2025-01:33:22.AST";
     const char *NTFileName  = "22.04.2025-01:33:22.nameTable";
 
@@ -18,8 +19,12 @@ int main() {
     IR_Context IRContext = {};
     initializeIRContext(&IRContext, &ASTContext);
     
-    readNameTable(&ASTContext, NTFileName);
-    readAST      (&ASTContext, ASTFileName);
+    if (argc > 1) {
+        readBinaryAST(&ASTContext, argv[1]);
+    } else {
+        readNameTable(&ASTContext, NTFileName);
+        readAST      (&ASTContext, ASTFileName);
+    }
 
     generateIR(&IRContext);
 
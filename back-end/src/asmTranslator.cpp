@@ -4,6 +4,7 @@
 #include "buffer.h"
 #include "core.h"
 #include "nameTable.h"
+#include "astVisitor.h"
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
@@ -19,80 +20,296 @@
 #define LABEL(NAME, INDEX) writeLabel(context, outputData, NAME, INDEX)
 #define NEW_LABEL(NAME, INDEX) LABEL(NAME, INDEX); WRITE(":\n")
 
-#define BINARY_OPERATION(OPERATION) do {                                    \
-    traverseAST(context, currentNode->left, outputData, nameTableIndex);    \
-    WRITE("\tmov rbx, rax\n");                                              \
-    traverseAST(context, currentNode->right, outputData, nameTableIndex);   \
-    WRITE("\t" OPERATION " rax, rbx\n");                                    \
-    if (!(currentNode->parent && currentNode->parent->data.type == nodeType::KEYWORD \
-        && currentNode->parent->data.data.keyword == Keyword::ASSIGNMENT)) {\
-        WRITE("\tpush rax\n");                                              \
-    }                                                                       \
+#define BINARY_OPERATION(OPERATION) do {                                                          \
+    compactNode *parentNode = getCompactParent(context->AST, currentNode);                        \
+    traverseAST(context, getCompactLeft(context->AST, currentNode), outputData, nameTableIndex);  \
+    WRITE("\tmov rbx, rax\n");                                                                    \
+    traverseAST(context, getCompactRight(context->AST, currentNode), outputData, nameTableIndex); \
+    WRITE("\t" OPERATION " rax, rbx\n");                                                          \
+    if (!(parentNode && parentNode->type == nodeType::KEYWORD                                     \
+        && parentNode->data.keyword == Keyword::ASSIGNMENT)) {                                    \
+        WRITE("\tpush rax\n");                                                                    \
+    }                                                                                             \
 } while (0)
 
-#define UNARY_OPERATION(OPERATION) do {                                     \
-    traverseAST(context, currentNode->left, outputData, nameTableIndex);    \
-    WRITE("\t" OPERATION " rax\n");                                         \
-    WRITE("\tpush rax\n");                                                  \
+#define UNARY_OPERATION(OPERATION) do {                                                           \
+    traverseAST(context, getCompactLeft(context->AST, currentNode), outputData, nameTableIndex);  \
+    WRITE("\t" OPERATION " rax\n");                                                               \
+    WRITE("\tpush rax\n");                                                                        \
 } while (0)
 
 #define MEMORY(NODE) pointMemoryCell(context, NODE, outputData, nameTableIndex);
 
-#define JUMP(JUMP_TYPE) do {                                                \
-    traverseAST(context, currentNode->left, outputData, nameTableIndex);    \
-    traverseAST(context, currentNode->right, outputData, nameTableIndex);   \
-    WRITE("\tpop rbx\n");                                                   \
-    WRITE("\tpop rax\n");                                                   \
-    WRITE("\tcmp rax, rbx\n");                                              \
-    LOGIC_JUMP(JUMP_TYPE);                                                  \
+#define JUMP(JUMP_TYPE) do {                                                                      \
+    traverseAST(context, getCompactLeft(context->AST, currentNode), outputData, nameTableIndex);  \
+    traverseAST(context, getCompactRight(context->AST, currentNode), outputData, nameTableIndex); \
+    WRITE("\tpop rbx\n");                                                                         \
+    WRITE("\tpop rax\n");                                                                         \
+    WRITE("\tcmp rax, rbx\n");                                                                    \
+    LOGIC_JUMP(JUMP_TYPE);                                                                        \
 } while (0)
 
-#define LOGIC_JUMP(JUMP_TYPE) do {                                          \
-    context->counters->logicCount++;                                        \
-    WRITE("\t" JUMP_TYPE " ");                                              \
-    LABEL("TRUE_BRANCH", context->counters->logicCount);                    \
-    WRITE("\n\tpush 0\n");                                                  \
-    WRITE("\tjmp ");                                                        \
-    LABEL("JUMP_END", context->counters->logicCount);                       \
-    WRITE("\n");                                                            \
-    NEW_LABEL("TRUE_BRANCH", context->counters->logicCount);                \
-    WRITE("\n\tpush 1\n");                                                  \
-    NEW_LABEL("JUMP_END", context->counters->logicCount);                   \
-    WRITE("\n");                                                            \
+#define LOGIC_JUMP(JUMP_TYPE) do {                                                                \
+    context->counters->logicCount++;                                                              \
+    WRITE("\t" JUMP_TYPE " ");                                                                    \
+    LABEL("TRUE_BRANCH", context->counters->logicCount);                                          \
+    WRITE("\n\tpush 0\n");                                                                        \
+    WRITE("\tjmp ");                                                                              \
+    LABEL("JUMP_END", context->counters->logicCount);                                             \
+    WRITE("\n");                                                                                  \
+    NEW_LABEL("TRUE_BRANCH", context->counters->logicCount);                                      \
+    WRITE("\n\tpush 1\n");                                                                        \
+    NEW_LABEL("JUMP_END", context->counters->logicCount);                                         \
+    WRITE("\n");                                                                                  \
 } while (0)
 
-#define LOGIC_EXPRESSION(NODE) do {                                         \
-    traverseAST(context, NODE, outputData, nameTableIndex);                 \
-    WRITE("\tpop rax\n");                                                   \
-    WRITE("\tcmp rax, 0\n");                                                \
-    LOGIC_JUMP("jne");                                                      \
+#define LOGIC_EXPRESSION(NODE) do {                                                               \
+    traverseAST(context, NODE, outputData, nameTableIndex);                                       \
+    WRITE("\tpop rax\n");                                                                         \
+    WRITE("\tcmp rax, 0\n");                                                                      \
+    LOGIC_JUMP("jne");                                                                            \
 } while (0)
 
-#define LOGIC_OPERATION(OPERATION) do {                                     \
-    LOGIC_EXPRESSION(currentNode->left);                                    \
-    LOGIC_EXPRESSION(currentNode->right);                                   \
-    WRITE("\tpop rbx\n");                                                   \
-    WRITE("\tpop rax\n");                                                   \
-    WRITE("\t" OPERATION " rax, rbx\n");                                    \
-    WRITE("\tpush rax\n");                                                  \
+#define LOGIC_OPERATION(OPERATION) do {                                                           \
+    LOGIC_EXPRESSION(getCompactLeft(context->AST, currentNode));                                  \
+    LOGIC_EXPRESSION(getCompactRight(context->AST, currentNode));                                 \
+    WRITE("\tpop rbx\n");                                                                         \
+    WRITE("\tpop rax\n");                                                                         \
+    WRITE("\t" OPERATION " rax, rbx\n");                                                          \
+    WRITE("\tpush rax\n");                                                                        \
 } while (0)
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
 static translationError writeConstant(Buffer<char> *outputData, int number);
 
-static translationError writeIdentifier     (translationContext *context, node<astNode> *currentNode,      Buffer<char> *outputData, size_t nameTableIndex);
-static translationError pointMemoryCell     (translationContext *context, node<astNode> *currentNode,      Buffer<char> *outputData, size_t nameTableIndex);
-static translationError writeKeyword        (translationContext *context, node<astNode> *currentNode,      Buffer<char> *outputData, size_t nameTableIndex);
-static translationError writeFunction       (translationContext *context, node<astNode> *currentNode,      Buffer<char> *outputData, size_t nameTableIndex);
-static translationError writeFunctionCall   (translationContext *context, node<astNode> *currentNode,      Buffer<char> *outputData, size_t nameTableIndex);
-static translationError writeVariable       (translationContext *context, node<astNode> *currentNode,      Buffer<char> *outputData, size_t nameTableIndex);
+static translationError writeIdentifier     (translationContext *context, compactNode   *currentNode,      Buffer<char> *outputData, size_t nameTableIndex);
+static translationError pointMemoryCell     (translationContext *context, compactNode   *currentNode,      Buffer<char> *outputData, size_t nameTableIndex);
+static translationError writeFunction       (translationContext *context, compactNode   *currentNode,      Buffer<char> *outputData, size_t nameTableIndex);
+static translationError writeFunctionCall   (translationContext *context, compactNode   *currentNode,      Buffer<char> *outputData, size_t nameTableIndex);
+static translationError writeVariable       (translationContext *context, compactNode   *currentNode,      Buffer<char> *outputData, size_t nameTableIndex);
 static translationError writeLabel          (translationContext *context, Buffer<char> *outputData, const char   *labelName,  size_t labelIndex);
 
 static translationError writeBlockStatement (translationContext *context, Buffer<char> *outputData, codeBlock block);
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
+// nameTableIndex is the local table of the function being translated, it is handed down with every node
+struct asmTranslator : compactVisitor<asmTranslator, translationError, size_t> {
+    translationContext *context    = NULL;
+    Buffer<char>       *outputData = NULL;
+
+    translationError visitNode(compactNode *currentNode, size_t nameTableIndex) {
+        return translationError::AST_BAD_STRUCTURE;
+    }
+
+    translationError visitConstant(compactNode *currentNode, size_t nameTableIndex) {
+        return writeConstant(outputData, currentNode->data.number);
+    }
+
+    translationError visitParameters(compactNode *currentNode, size_t nameTableIndex) {
+        context->callParameters = false;
+
+        traverseAST(context, getCompactLeft(context->AST, currentNode), outputData, nameTableIndex);
+        traverseAST(context, getCompactRight(context->AST, currentNode), outputData, nameTableIndex);
+
+        return translationError::NO_ERRORS;
+    }
+
+    translationError visitString(compactNode *currentNode, size_t nameTableIndex) {
+        return writeIdentifier(context, currentNode, outputData, nameTableIndex);
+    }
+
+    translationError visitFunctionDefinition(compactNode *currentNode, size_t nameTableIndex) {
+        return writeFunction(context, currentNode, outputData, nameTableIndex);
+    }
+
+    translationError visitVariableDeclaration(compactNode *currentNode, size_t nameTableIndex) {
+        return writeVariable(context, currentNode, outputData, nameTableIndex);
+    }
+
+    translationError visitFunctionCall(compactNode *currentNode, size_t nameTableIndex) {
+        return writeFunctionCall(context, currentNode, outputData, nameTableIndex);
+    }
+
+    translationError visitWHILE(compactNode *currentNode, size_t nameTableIndex) {
+        size_t blockID = ++context->counters->whileCount;
+        NEW_LABEL("WHILE_BEGIN", blockID);
+        traverseAST(context, getCompactLeft(context->AST, currentNode), outputData, nameTableIndex);
+        WRITE("\tpop rax\n");
+        WRITE("\tcmp rax, 0\n");
+        WRITE("\tje ");
+        LABEL("WHILE_END", blockID);
+        WRITE("\n");
+        traverseAST(context, getCompactRight(context->AST, currentNode), outputData, nameTableIndex);
+        WRITE("\tjmp ");
+        LABEL("WHILE_BEGIN", blockID);
+        WRITE("\n");
+        NEW_LABEL("WHILE_END", blockID);
+        WRITE("\n");
+
+        return translationError::NO_ERRORS;
+    }
+
+    translationError visitIF(compactNode *currentNode, size_t nameTableIndex) {
+        size_t blockID = ++context->counters->ifCount;
+        traverseAST(context, getCompactLeft(context->AST, currentNode), outputData, nameTableIndex);
+        WRITE("\tpop rax\n");
+        WRITE("\tcmp rax, 0\n");
+        WRITE("\tje ");
+        LABEL("IF_END", blockID);
+        WRITE("\n");
+        traverseAST(context, getCompactRight(context->AST, currentNode), outputData, nameTableIndex);
+        NEW_LABEL("IF_END", blockID);
+        WRITE("\n");
+
+        return translationError::NO_ERRORS;
+    }
+
+    translationError visitASSIGNMENT(compactNode *currentNode, size_t nameTableIndex) {
+        traverseAST(context, getCompactLeft(context->AST, currentNode), outputData, nameTableIndex);
+        WRITE("\tmov qword ");
+        MEMORY(getCompactRight(context->AST, currentNode));
+        WRITE(", rax\n");
+
+        return translationError::NO_ERRORS;
+    }
+
+    translationError visitSIN  (compactNode *currentNode, size_t nameTableIndex) { UNARY_OPERATION("sin");   return translationError::NO_ERRORS; }
+    translationError visitCOS  (compactNode *currentNode, size_t nameTableIndex) { UNARY_OPERATION("cos");   return translationError::NO_ERRORS; }
+    translationError visitFLOOR(compactNode *currentNode, size_t nameTableIndex) { UNARY_OPERATION("floor"); return translationError::NO_ERRORS; }
+    translationError visitSQRT (compactNode *currentNode, size_t nameTableIndex) { UNARY_OPERATION("sqrt");  return translationError::NO_ERRORS; }
+
+    translationError visitADD  (compactNode *currentNode, size_t nameTableIndex) { BINARY_OPERATION("add");  return translationError::NO_ERRORS; }
+    translationError visitMUL  (compactNode *currentNode, size_t nameTableIndex) { BINARY_OPERATION("imul"); return translationError::NO_ERRORS; }
+    translationError visitDIV  (compactNode *currentNode, size_t nameTableIndex) { BINARY_OPERATION("idiv"); return translationError::NO_ERRORS; }
+
+    translationError visitSUB(compactNode *currentNode, size_t nameTableIndex) {
+        traverseAST(context, getCompactLeft(context->AST, currentNode), outputData, nameTableIndex);
+        WRITE("\tmov rbx, rax\n");
+        traverseAST(context, getCompactRight(context->AST, currentNode), outputData, nameTableIndex);
+        WRITE("\tsub rbx, rax\n");
+        WRITE("\tmov rax, rbx\n");
+
+        compactNode *parentNode = getCompactParent(context->AST, currentNode);
+
+        if (parentNode && parentNode->type == nodeType::KEYWORD && parentNode->data.keyword == Keyword::ASSIGNMENT) {
+            WRITE("\tmov qword ");
+            MEMORY(getCompactRight(context->AST, parentNode));
+            WRITE(", rax\n");
+        } else {
+            WRITE("\tpush rax\n");
+        }
+
+        return translationError::NO_ERRORS;
+    }
+
+    translationError visitEQUAL           (compactNode *currentNode, size_t nameTableIndex) { JUMP("je");  return translationError::NO_ERRORS; }
+    translationError visitLESS            (compactNode *currentNode, size_t nameTableIndex) { JUMP("jl");  return translationError::NO_ERRORS; }
+    translationError visitGREATER         (compactNode *currentNode, size_t nameTableIndex) { JUMP("jg");  return translationError::NO_ERRORS; }
+    translationError visitLESS_OR_EQUAL   (compactNode *currentNode, size_t nameTableIndex) { JUMP("jle"); return translationError::NO_ERRORS; }
+    translationError visitGREATER_OR_EQUAL(compactNode *currentNode, size_t nameTableIndex) { JUMP("jge"); return translationError::NO_ERRORS; }
+    translationError visitNOT_EQUAL       (compactNode *currentNode, size_t nameTableIndex) { JUMP("jne"); return translationError::NO_ERRORS; }
+
+    translationError visitAND(compactNode *currentNode, size_t nameTableIndex) { LOGIC_OPERATION("and");                                        return translationError::NO_ERRORS; }
+    translationError visitOR (compactNode *currentNode, size_t nameTableIndex) { LOGIC_OPERATION("or");                                         return translationError::NO_ERRORS; }
+    translationError visitNOT(compactNode *currentNode, size_t nameTableIndex) { LOGIC_EXPRESSION(getCompactLeft(context->AST, currentNode)); return translationError::NO_ERRORS; }
+
+    translationError visitABORT(compactNode *currentNode, size_t nameTableIndex) {
+        WRITE("\thlt\n");
+
+        return translationError::NO_ERRORS;
+    }
+
+    translationError visitRETURN(compactNode *currentNode, size_t nameTableIndex) {
+        compactNode *value = getCompactRight(context->AST, currentNode);
+
+        if (value) {
+            if (value->type == nodeType::STRING) {
+                WRITE("\tmov rax, qword ");
+                MEMORY(value);
+                WRITE("\n");
+            } else {
+                traverseAST(context, value, outputData, nameTableIndex);
+                WRITE("\tpop rax\n");
+            }
+        }
+
+        WRITE("\tmov rsp, rbp\n");
+        WRITE("\tpop rbp\n");
+        WRITE("\tret\n");
+
+        return translationError::NO_ERRORS;
+    }
+
+    translationError visitBREAK(compactNode *currentNode, size_t nameTableIndex) {
+        WRITE("\tjmp ");
+        LABEL("WHILE_END", context->counters->whileCount);
+        WRITE("\n");
+
+        return translationError::NO_ERRORS;
+    }
+
+    translationError visitCONTINUE(compactNode *currentNode, size_t nameTableIndex) {
+        WRITE("\tjmp ");
+        LABEL("WHILE_BEGIN", context->counters->whileCount);
+        WRITE("\n");
+
+        return translationError::NO_ERRORS;
+    }
+
+    translationError visitIN(compactNode *currentNode, size_t nameTableIndex) {
+        WRITE("\tin\n");
+
+        return translationError::NO_ERRORS;
+    }
+
+    translationError visitOUT(compactNode *currentNode, size_t nameTableIndex) {
+        traverseAST(context, getCompactRight(context->AST, currentNode), outputData, nameTableIndex);
+
+        WRITE("\tpop rax\n");
+        WRITE("\tout\n");
+
+        return translationError::NO_ERRORS;
+    }
+
+    translationError visitOPERATOR_SEPARATOR(compactNode *currentNode, size_t nameTableIndex) {
+        compactChainIterator statements = {};
+        compactChainIteratorInitialize(&statements, context->AST, currentNode, isOperatorSeparator);
+
+        while (compactNode *statement = compactChainIteratorNext(&statements)) {
+            translationError error = traverseAST(context, statement, outputData, nameTableIndex);
+
+            if (error != translationError::NO_ERRORS) {
+                return error;
+            }
+        }
+
+        return translationError::NO_ERRORS;
+    }
+
+    translationError visitARGUMENT_SEPARATOR(compactNode *currentNode, size_t nameTableIndex) {
+        if (context->callParameters) {
+            traverseAST(context, getCompactLeft(context->AST, currentNode), outputData, nameTableIndex);
+            traverseAST(context, getCompactRight(context->AST, currentNode), outputData, nameTableIndex);
+        } else {
+            traverseAST(context, getCompactRight(context->AST, currentNode), outputData, nameTableIndex);
+            traverseAST(context, getCompactLeft(context->AST, currentNode), outputData, nameTableIndex);
+
+            if (getCompactLeft(context->AST, currentNode)) {
+                WRITE("\tpop rax\n");
+                WRITE("\tmov ");
+                MEMORY(getCompactLeft(context->AST, currentNode));
+                WRITE(", rax\n");
+            }
+        }
+
+        return translationError::NO_ERRORS;
+    }
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
 translationError translateToASM(translationContext *context, const char *fileName) {
     customWarning(context,  translationError::CONTEXT_BAD_POINTER);
     customWarning(fileName, translationError::BAD_FILE_NAME);
@@ -100,8 +317,11 @@ translationError translateToASM(translationContext *context, const char *fileNam
     Buffer<char> outputData = {};
     bufferInitialize(&outputData);
 
+    // the offsets of parameters and locals are kept next to the tree, not in it
+    customWarning(annotateCompactAST(context->AST) == bufferError::NO_BUFFER_ERROR, translationError::AST_BAD_POINTER);
+
     initializeProgram(context, &outputData);
-    traverseAST(context, context->AST->root, &outputData, 0);
+    traverseAST(context, getCompactNode(context->AST, context->AST->root), &outputData, 0);
 
     FILE *outputFile = fopen(fileName, "w");
     customWarning(outputFile, translationError::FILE_OPEN_ERROR);
@@ -125,7 +345,7 @@ translationError initializeProgram(translationContext *context, Buffer<char> *ou
     return translationError::NO_ERRORS;
 }
 
-translationError traverseAST(translationContext *context, node<astNode> *currentNode, Buffer<char> *outputData, size_t nameTableIndex) {
+translationError traverseAST(translationContext *context, compactNode *currentNode, Buffer<char> *outputData, size_t nameTableIndex) {
     customWarning(context,    translationError::CONTEXT_BAD_POINTER);
     customWarning(outputData, translationError::BUFFER_BAD_POINTER);
 
@@ -133,55 +353,9 @@ translationError traverseAST(translationContext *context, node<astNode> *current
         return translationError::NO_ERRORS;
     }
 
-    switch (currentNode->data.type) {
-        case nodeType::TERMINATOR: {
-            return translationError::AST_BAD_STRUCTURE;
-        }
-
-        case nodeType::CONSTANT: {
-            writeConstant(outputData, currentNode->data.data.number);
-            break;
-        }
-
-        case nodeType::PARAMETERS: {
-            context->callParameters = false;
-
-            traverseAST(context, currentNode->left, outputData, nameTableIndex);
-            traverseAST(context, currentNode->right, outputData, nameTableIndex);
-
-            break;
-        }
-
-        case nodeType::STRING: {
-            writeIdentifier(context, currentNode, outputData, nameTableIndex);
-            break;
-        }
-
-        case nodeType::KEYWORD: {
-            writeKeyword(context, currentNode, outputData, nameTableIndex);
-            break;
-        }
-
-        case nodeType::FUNCTION_DEFINITION: {
-            writeFunction(context, currentNode, outputData, nameTableIndex);
-            break;
-        }
-
-        case nodeType::VARIABLE_DECLARATION: {
-            writeVariable(context, currentNode, outputData, nameTableIndex);
-            break;
-        }
-
-        case nodeType::FUNCTION_CALL: {
-            writeFunctionCall(context, currentNode, outputData, nameTableIndex);
-            break;
-        }
+    asmTranslator translator = {{}, context, outputData};
 
-        default:
-            return translationError::AST_BAD_STRUCTURE;
-    }
-
-    return translationError::NO_ERRORS;
+    return translator.visit(currentNode, nameTableIndex);
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -198,10 +372,10 @@ static translationError writeConstant(Buffer<char> *outputData, int number) {
 }
 
 static translationError writeIdentifier(translationContext *context, 
-                                      node<astNode> *currentNode, 
+                                      compactNode *currentNode, 
                                       Buffer<char> *outputData, 
                                       size_t nameTableIndex) {
-    size_t identifierIndex = currentNode->data.data.nameTableIndex;
+    size_t identifierIndex = currentNode->data.nameTableIndex;
     int64_t offset = context->nameTable->data[identifierIndex].rbpOffset;
     
     WRITE("\tmov rax, qword [rbp - ");
@@ -215,12 +389,12 @@ static translationError writeIdentifier(translationContext *context,
     return translationError::NO_ERRORS;
 }
 
-static translationError pointMemoryCell(translationContext *context, node<astNode> *currentNode, Buffer<char> *outputData, size_t nameTableIndex) {
+static translationError pointMemoryCell(translationContext *context, compactNode *currentNode, Buffer<char> *outputData, size_t nameTableIndex) {
     char indexBuffer[MAX_NUMBER_LENGTH] = {};
 
-    int64_t rbpOffset = currentNode->data.type == nodeType::STRING ?
-        context->nameTable->data[currentNode->data.data.nameTableIndex].rbpOffset :
-        currentNode->data.rbpOffset;
+    int64_t rbpOffset = currentNode->type == nodeType::STRING ?
+        context->nameTable->data[currentNode->data.nameTableIndex].rbpOffset :
+        getCompactAnnotation(context->AST, currentNode)->rbpOffset;
 
     if (rbpOffset == 0) {
         return translationError::AST_BAD_STRUCTURE;
@@ -241,217 +415,21 @@ static translationError pointMemoryCell(translationContext *context, node<astNod
     return translationError::NO_ERRORS;
 }
 
-static translationError writeKeyword(translationContext *context, node<astNode> *currentNode, Buffer<char> *outputData, size_t nameTableIndex) {
-    customWarning(context,    translationError::CONTEXT_BAD_POINTER);
-    customWarning(currentNode, translationError::AST_BAD_POINTER);
-    customWarning(outputData, translationError::BUFFER_BAD_POINTER);
-
-    switch (currentNode->data.data.keyword) {
-        case Keyword::WHILE: {
-            size_t blockID = ++context->counters->whileCount;
-            NEW_LABEL("WHILE_BEGIN", blockID);
-            traverseAST(context, currentNode->left, outputData, nameTableIndex);
-            WRITE("\tpop rax\n");
-            WRITE("\tcmp rax, 0\n");
-            WRITE("\tje ");
-            LABEL("WHILE_END", blockID);
-            WRITE("\n");
-            traverseAST(context, currentNode->right, outputData, nameTableIndex);
-            WRITE("\tjmp ");
-            LABEL("WHILE_BEGIN", blockID);
-            WRITE("\n");
-            NEW_LABEL("WHILE_END", blockID);
-            WRITE("\n");
-            break;
-        }
-
-        case Keyword::IF: {
-            size_t blockID = ++context->counters->ifCount;
-            traverseAST(context, currentNode->left, outputData, nameTableIndex);
-            WRITE("\tpop rax\n");
-            WRITE("\tcmp rax, 0\n");
-            WRITE("\tje ");
-            LABEL("IF_END", blockID);
-            WRITE("\n");
-            traverseAST(context, currentNode->right, outputData, nameTableIndex);
-            NEW_LABEL("IF_END", blockID);
-            WRITE("\n");
-            break;
-        }
-
-        case Keyword::ASSIGNMENT: {
-            traverseAST(context, currentNode->left, outputData, nameTableIndex);
-            WRITE("\tmov qword ");
-            MEMORY(currentNode->right);
-            WRITE(", rax\n");
-            break;
-        }
-
-        case Keyword::SIN:
-            UNARY_OPERATION("sin");
-            break;
-        case Keyword::COS:
-            UNARY_OPERATION("cos");
-            break;
-        case Keyword::FLOOR:
-            UNARY_OPERATION("floor");
-            break;
-        case Keyword::SQRT:
-            UNARY_OPERATION("sqrt");
-            break;
-
-        case Keyword::ADD:
-            BINARY_OPERATION("add");
-            break;
-
-        case Keyword::SUB: {
-            traverseAST(context, currentNode->left, outputData, nameTableIndex);
-            WRITE("\tmov rbx, rax\n");
-            traverseAST(context, currentNode->right, outputData, nameTableIndex);
-            WRITE("\tsub rbx, rax\n");
-            WRITE("\tmov rax, rbx\n");
-                
-            if (currentNode->parent && currentNode->parent->data.type == nodeType::KEYWORD &&
-                currentNode->parent->data.data.keyword == Keyword::ASSIGNMENT) {
-                WRITE("\tmov qword ");
-                MEMORY(currentNode->parent->right);
-                WRITE(", rax\n");
-            } else {
-                WRITE("\tpush rax\n");
-            }
-
-            break;
-        }
-
-        case Keyword::MUL:
-            BINARY_OPERATION("imul");
-            break;
-        case Keyword::DIV:
-            BINARY_OPERATION("idiv");
-            break;
-
-        case Keyword::EQUAL:
-            JUMP("je");
-            break;
-        case Keyword::LESS:
-            JUMP("jl");
-            break;
-        case Keyword::GREATER:
-            JUMP("jg");
-            break;
-        case Keyword::LESS_OR_EQUAL:
-            JUMP("jle");
-            break;
-        case Keyword::GREATER_OR_EQUAL:
-            JUMP("jge");
-            break;
-        case Keyword::NOT_EQUAL:
-            JUMP("jne");
-            break;
-
-        case Keyword::AND:
-            LOGIC_OPERATION("and");
-            break;
-        case Keyword::OR:
-            LOGIC_OPERATION("or");
-            break;
-
-        case Keyword::NOT:
-            LOGIC_EXPRESSION(currentNode->left);
-            break;
-
-        case Keyword::ABORT:
-            WRITE("\thlt\n");
-            break;
-
-        case Keyword::RETURN: {
-            if (currentNode->right) {
-                if (currentNode->right->data.type == nodeType::STRING) {
-                    WRITE("\tmov rax, qword ");
-                    MEMORY(currentNode->right);
-                    WRITE("\n");
-                } else {
-                    traverseAST(context, currentNode->right, outputData, nameTableIndex);
-                    WRITE("\tpop rax\n");
-                }
-            }
-
-            WRITE("\tmov rsp, rbp\n");
-            WRITE("\tpop rbp\n");
-            WRITE("\tret\n");
-
-            break;
-        }
-
-        case Keyword::BREAK:
-            WRITE("\tjmp ");
-            LABEL("WHILE_END", context->counters->whileCount);
-            WRITE("\n");
-            break;
-
-        case Keyword::CONTINUE:
-            WRITE("\tjmp ");
-            LABEL("WHILE_BEGIN", context->counters->whileCount);
-            WRITE("\n");
-            break;
-
-        case Keyword::IN:
-            WRITE("\tin\n");
-            break;
-
-        case Keyword::OUT:
-            traverseAST(context, currentNode->right, outputData, nameTableIndex);
-
-            WRITE("\tpop rax\n");
-            WRITE("\tout\n");
-
-            break;
-
-        case Keyword::OPERATOR_SEPARATOR:
-            traverseAST(context, currentNode->left, outputData, nameTableIndex);
-            traverseAST(context, currentNode->right, outputData, nameTableIndex);
-            break;
-
-        case Keyword::ARGUMENT_SEPARATOR:
-            if (context->callParameters) {
-                traverseAST(context, currentNode->left, outputData, nameTableIndex);
-                traverseAST(context, currentNode->right, outputData, nameTableIndex);
-            } else {
-                traverseAST(context, currentNode->right, outputData, nameTableIndex);
-                traverseAST(context, currentNode->left, outputData, nameTableIndex);
-
-                if (currentNode->left) {
-                    WRITE("\tpop rax\n");
-                    WRITE("\tmov ");
-                    MEMORY(currentNode->left);
-                    WRITE(", rax\n");
-                }
-            }
-
-            break;
-
-        default:
-            return translationError::AST_BAD_STRUCTURE;
-    }
-
-    return translationError::NO_ERRORS;
-}
-
-static translationError writeFunction(translationContext *context, node<astNode> *currentNode, Buffer<char> *outputData, size_t nameTableIndex) {
+static translationError writeFunction(translationContext *context, compactNode *currentNode, Buffer<char> *outputData, size_t nameTableIndex) {
     customWarning(context, translationError::CONTEXT_BAD_POINTER);
     customWarning(currentNode, translationError::AST_BAD_POINTER);
     customWarning(outputData, translationError::BUFFER_BAD_POINTER);
 
-    int tableIndex = getLocalNameTableIndex(currentNode->data.data.nameTableIndex, context->localTables);
+    int tableIndex = getLocalNameTableIndex(currentNode->data.nameTableIndex, context->localTables);
 
     if (tableIndex < 0) {
         return translationError::NAME_TABLE_ERROR;
     }
 
-    if (currentNode->data.data.nameTableIndex == context->entryPoint) {
+    if (currentNode->data.nameTableIndex == context->entryPoint) {
         WRITE("main:\n");
     } else {
-        WRITE(context->nameTable->data[currentNode->data.data.nameTableIndex].name);
+        WRITE(context->nameTable->data[currentNode->data.nameTableIndex].name);
         WRITE(":\n");
     }
 
@@ -469,23 +447,23 @@ static translationError writeFunction(translationContext *context, node<astNode>
 
     size_t paramOffset = 16;
 
-    node<astNode> *paramNode = currentNode->left;
+    compactNode *paramNode = getCompactLeft(context->AST, currentNode);
 
-    while (paramNode && paramNode->data.type == nodeType::PARAMETERS) {
-        if (paramNode->right) {
-            paramNode->right->data.rbpOffset = paramOffset;
+    while (paramNode && paramNode->type == nodeType::PARAMETERS) {
+        if (compactNode *parameter = getCompactRight(context->AST, paramNode)) {
+            getCompactAnnotation(context->AST, parameter)->rbpOffset = paramOffset;
             paramOffset += 8;
         }
 
-        paramNode = paramNode->left;
+        paramNode = getCompactLeft(context->AST, paramNode);
     }
 
-    if (paramNode && paramNode->data.type != nodeType::KEYWORD) {
-        paramNode->data.rbpOffset = paramOffset;
+    if (paramNode && paramNode->type != nodeType::KEYWORD) {
+        getCompactAnnotation(context->AST, paramNode)->rbpOffset = paramOffset;
     }
 
-    if (currentNode->right) {
-        traverseAST(context, currentNode->right, outputData, tableIndex);
+    if (currentNode->right != AST_NO_NODE) {
+        traverseAST(context, getCompactRight(context->AST, currentNode), outputData, tableIndex);
     } else {
         return translationError::AST_BAD_STRUCTURE;
     }
@@ -493,21 +471,21 @@ static translationError writeFunction(translationContext *context, node<astNode>
     return translationError::NO_ERRORS;
 }
 
-static translationError writeFunctionCall(translationContext *context, node<astNode> *currentNode, Buffer<char> *outputData, size_t nameTableIndex) {
+static translationError writeFunctionCall(translationContext *context, compactNode *currentNode, Buffer<char> *outputData, size_t nameTableIndex) {
     size_t blockID = ++context->counters->callCount;
 
-    if (!currentNode->right) {
+    if (currentNode->right == AST_NO_NODE) {
         return translationError::AST_BAD_STRUCTURE;
     }
     
     context->callParameters = true;
 
-    std::vector<node<astNode>*> arguments;
-    node<astNode> *current = currentNode->left;
+    std::vector<compactNode *> arguments;
+    compactNode *current = getCompactLeft(context->AST, currentNode);
 
-    while (current && current->data.type == nodeType::KEYWORD && current->data.data.keyword == Keyword::ARGUMENT_SEPARATOR) {
-        arguments.push_back(current->right);
-        current = current->left;
+    while (current && current->type == nodeType::KEYWORD && current->data.keyword == Keyword::ARGUMENT_SEPARATOR) {
+        arguments.push_back(getCompactRight(context->AST, current));
+        current = getCompactLeft(context->AST, current);
     }
 
     if (current) {
@@ -520,7 +498,7 @@ static translationError writeFunctionCall(translationContext *context, node<astN
 
     WRITE("\tand rsp, -16\n");
     WRITE("\tcall ");
-    WRITE(context->nameTable->data[currentNode->right->data.data.nameTableIndex].name);
+    WRITE(context->nameTable->data[getCompactRight(context->AST, currentNode)->data.nameTableIndex].name);
     WRITE("\n");
 
     if (!arguments.empty()) {
@@ -532,14 +510,16 @@ static translationError writeFunctionCall(translationContext *context, node<astN
         WRITE("\n");
     }
 
-    if (currentNode->parent && !(currentNode->parent->data.type == nodeType::KEYWORD && currentNode->parent->data.data.keyword == Keyword::OPERATOR_SEPARATOR)) {
+    compactNode *parentNode = getCompactParent(context->AST, currentNode);
+
+    if (parentNode && !(parentNode->type == nodeType::KEYWORD && parentNode->data.keyword == Keyword::OPERATOR_SEPARATOR)) {
         WRITE("\tpush rax\n");
     }
 
     return translationError::NO_ERRORS;
 }
 
-static translationError writeVariable(translationContext *context, node<astNode> *currentNode, Buffer<char> *outputData, size_t nameTableIndex) {
+static translationError writeVariable(translationContext *context, compactNode *currentNode, Buffer<char> *outputData, size_t nameTableIndex) {
     customWarning(context, translationError::CONTEXT_BAD_POINTER);
     customWarning(currentNode, translationError::AST_BAD_POINTER);
     customWarning(outputData, translationError::BUFFER_BAD_POINTER);
@@ -559,21 +539,24 @@ static translationError writeVariable(translationContext *context, node<astNode>
         return translationError::AST_BAD_STRUCTURE;
     }
 
-    currentNode->data.rbpOffset = -(currentIndex * 8);
+    compactAnnotation *annotation = getCompactAnnotation(context->AST, currentNode);
+
+    annotation->rbpOffset = -(currentIndex * 8);
     context->localTables->data[nameTableIndex].elements.currentIndex--;
 
     size_t stackFrameSize = ((size * 8 + 15) / 16) * 16;
 
-    if (-currentNode->data.rbpOffset > stackFrameSize) {
+    if (-annotation->rbpOffset > stackFrameSize) {
         return translationError::AST_BAD_STRUCTURE;
     }
 
-    size_t identifierIndex = currentNode->data.data.nameTableIndex;
-    context->nameTable->data[identifierIndex].rbpOffset = currentNode->data.rbpOffset;
+    size_t identifierIndex = currentNode->data.nameTableIndex;
+    context->nameTable->data[identifierIndex].rbpOffset = annotation->rbpOffset;
+
+    compactNode *initializer = getCompactRight(context->AST, currentNode);
 
-    if (currentNode->right && currentNode->right->data.type == nodeType::KEYWORD &&
-        currentNode->right->data.data.keyword == Keyword::ASSIGNMENT) {
-        traverseAST(context, currentNode->right, outputData, nameTableIndex);
+    if (initializer && initializer->type == nodeType::KEYWORD && initializer->data.keyword == Keyword::ASSIGNMENT) {
+        traverseAST(context, initializer, outputData, nameTableIndex);
     }
 
     return translationError::NO_ERRORS;
@@ -0,0 +1,148 @@
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define AST_SCANNER_X86
+#endif
+
+#include "astScanner.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// bit i is set when block[i] is not a space, the block is always AST_SCANNER_BLOCK_SIZE bytes
+typedef uint64_t (*nonSpaceMaskFunction)(const char *block);
+
+static nonSpaceMaskFunction getNonSpaceMask ();
+static uint64_t             getLastBlockMask(const char *block, size_t bytes);
+
+static uint64_t scalarNonSpaceMask(const char *block);
+
+#ifdef AST_SCANNER_X86
+static uint64_t sse2NonSpaceMask  (const char *block);
+static uint64_t avx2NonSpaceMask  (const char *block);
+#endif
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+void initializeASTScanner(astScanner *scanner, const char *text, size_t size, size_t begin) {
+    if (!scanner) {
+        return;
+    }
+
+    *scanner = {};
+
+    scanner->text       = text;
+    scanner->size       = text ? size : 0;
+    scanner->blockBegin = begin < scanner->size ? begin : scanner->size;
+    scanner->blockEnd   = scanner->blockBegin;
+}
+
+// a token starts at every byte that is not a space and comes right after one
+size_t nextASTToken(astScanner *scanner) {
+    if (!scanner) {
+        return 0;
+    }
+
+    while (!scanner->tokenStarts) {
+        if (scanner->blockEnd >= scanner->size) {
+            return scanner->size;
+        }
+
+        size_t   bytes     = scanner->size - scanner->blockEnd;
+        uint64_t nonSpaces = bytes < AST_SCANNER_BLOCK_SIZE ? getLastBlockMask(scanner->text + scanner->blockEnd, bytes) :
+                                                              getNonSpaceMask()(scanner->text + scanner->blockEnd);
+
+        scanner->tokenStarts = nonSpaces & ~((nonSpaces << 1) | (scanner->afterSpace ? 0 : 1));
+        scanner->afterSpace  = !(nonSpaces >> (AST_SCANNER_BLOCK_SIZE - 1));
+        scanner->blockBegin  = scanner->blockEnd;
+        scanner->blockEnd   += AST_SCANNER_BLOCK_SIZE;
+    }
+
+    size_t token = scanner->blockBegin + (size_t) __builtin_ctzll(scanner->tokenStarts);
+
+    scanner->tokenStarts &= scanner->tokenStarts - 1;
+
+    return token;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static nonSpaceMaskFunction getNonSpaceMask() {
+    #ifdef AST_SCANNER_X86
+        // function-local static, so cpuid runs once and the choice is thread-safe
+        static const nonSpaceMaskFunction nonSpaceMask = __builtin_cpu_supports("avx2") ? avx2NonSpaceMask :
+                                                         __builtin_cpu_supports("sse2") ? sse2NonSpaceMask : scalarNonSpaceMask;
+
+        return nonSpaceMask;
+    #else
+        return scalarNonSpaceMask;
+    #endif
+}
+
+// the last block is padded with spaces, so every implementation only ever sees whole blocks
+static uint64_t getLastBlockMask(const char *block, size_t bytes) {
+    char lastBlock[AST_SCANNER_BLOCK_SIZE];
+
+    memcpy(lastBlock,         block, bytes);
+    memset(lastBlock + bytes, ' ',   AST_SCANNER_BLOCK_SIZE - bytes);
+
+    return getNonSpaceMask()(lastBlock);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static uint64_t scalarNonSpaceMask(const char *block) {
+    uint64_t nonSpaces = 0;
+
+    for (size_t byteIndex = 0; byteIndex < AST_SCANNER_BLOCK_SIZE; byteIndex++) {
+        nonSpaces |= (uint64_t) !isASTSpace(block[byteIndex]) << byteIndex;
+    }
+
+    return nonSpaces;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#ifdef AST_SCANNER_X86
+
+// compares are signed, so no byte of a multi-byte name falls into '\t'..'\r'
+
+static inline __m128i sse2SpaceBytes(__m128i block) {
+    __m128i controls = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('\t' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('\r' + 1), block));
+
+    return _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), controls);
+}
+
+static uint64_t sse2NonSpaceMask(const char *block) {
+    uint64_t spaces = 0;
+
+    for (size_t part = 0; part < AST_SCANNER_BLOCK_SIZE / sizeof(__m128i); part++) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(block + part * sizeof(__m128i)));
+
+        spaces |= (uint64_t)(uint32_t)_mm_movemask_epi8(sse2SpaceBytes(bytes)) << (part * sizeof(__m128i));
+    }
+
+    return ~spaces;
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx2SpaceBytes(__m256i block) {
+    __m256i controls = _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('\t' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), block));
+
+    return _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')), controls);
+}
+
+__attribute__((target("avx2")))
+static uint64_t avx2NonSpaceMask(const char *block) {
+    __m256i low  = _mm256_loadu_si256((const __m256i *) block);
+    __m256i high = _mm256_loadu_si256((const __m256i *)(block + sizeof(__m256i)));
+
+    uint64_t spaces = (uint64_t)(uint32_t)_mm256_movemask_epi8(avx2SpaceBytes(low)) |
+                      (uint64_t)(uint32_t)_mm256_movemask_epi8(avx2SpaceBytes(high)) << sizeof(__m256i);
+
+    return ~spaces;
+}
+
+#endif // AST_SCANNER_X86
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -1,6 +1,7 @@
 #include <stdlib.h>
 
 #include "AST.h"
+#include "compactAST.h"
 #include "buffer.h"
 #include "customWarning.h"
 #include "core.h"
@@ -10,12 +11,16 @@
 translationError initializeTranslationContext(translationContext *context) {
     customWarning(context, translationError::CONTEXT_BAD_POINTER);
 
-    context->AST = (binaryTree<astNode> *)calloc(1, sizeof(binaryTree<node<astNode> *>));
+    context->AST = (compactAST *)calloc(1, sizeof(compactAST));
     customWarning(context->AST, translationError::AST_BAD_POINTER);
+    customWarning(initializeCompactAST(context->AST) == bufferError::NO_BUFFER_ERROR, translationError::AST_BAD_POINTER);
 
     context->nameTable = (Buffer<nameTableElement> *)calloc(1, sizeof(Buffer<nameTableElement>));
     customWarning(context->nameTable, translationError::BUFFER_BAD_POINTER);
 
+    context->interner = (nameInterner *)calloc(1, sizeof(nameInterner));
+    customWarning(context->interner, translationError::BUFFER_BAD_POINTER);
+
     context->localTables = (Buffer<localNameTable> *)calloc(1, sizeof(Buffer<localNameTable>));
     customWarning(context->localTables, translationError::BUFFER_BAD_POINTER);
 
@@ -29,11 +34,16 @@ translationError destroyTranslationContext(translationContext *context) {
     customWarning(context, translationError::CONTEXT_BAD_POINTER);
 
     if (context->AST) {
+        destroyCompactAST(context->AST);
         FREE_(context->AST);
     }
 
-    if (context->nameTable) {
-        bufferDestruct(context->nameTable);
+    if (context->nameTable && context->interner) {
+        destroyNameTable(context->nameTable, context->interner);
+    }
+
+    if (context->interner) {
+        FREE_(context->interner);
     }
 
     if (context->localTables) {
@@ -1,88 +1,136 @@
-#include <ctype.h>
+#include <string.h>
 
 #include "core.h"
 #include "colorPrint.h"
 #include "treeReader.h"
+#include "numberParser.h"
+#include "astScanner.h"
+#include "binaryAST.h"
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-#define SKIP_SPACES() do {                                      \
-    while (isspace(fileContent->data[*currentFilePosition])) {  \
-        (*currentFilePosition)++;                               \
-    }                                                           \
-} while (0)
-
-#define CHECK_SYMBOL(symbol, ...) do {                          \
-    if (fileContent->data[*currentFilePosition] != symbol) {    \
-        (*currentFilePosition)++;                               \
-        __VA_ARGS__;                                            \
-    }                                                           \
-} while (0)
+struct readFrame {
+    astHandle current      = AST_NO_NODE;
+    int       childrenRead = 0;
+};
 
+struct handoffFrame {
+    node<astNode> *current = NULL;        // in the front-end tree
+    astHandle      parent  = AST_NO_NODE; // in context->AST
+    bool           isRight = false;
+};
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-static translationError readNone(translationContext *context, Buffer<char> *fileContent, size_t *currentFilePosition, node<astNode> *node) {
-    customWarning(context, translationError::CONTEXT_BAD_POINTER);
-    customWarning(fileContent, translationError::BUFFER_BAD_POINTER);
+static bool isTokenOver     (const astScanner *scanner, size_t position);
+static bool readSymbolToken (astScanner *scanner, size_t *currentFilePosition, char symbol);
+static bool readIntToken    (astScanner *scanner, size_t *currentFilePosition, int    *number);
+static bool readSizeToken   (astScanner *scanner, size_t *currentFilePosition, size_t *number);
+static bool readNameToken   (astScanner *scanner, size_t *currentFilePosition, size_t *nameBegin, size_t *nameLength);
 
-    return translationError::NO_ERRORS;
+static void setNodePayload  (compactNode *currentNode, int64_t payload);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// a field is always followed by a space or by the end of the file
+static bool isTokenOver(const astScanner *scanner, size_t position) {
+    return position >= scanner->size || isASTSpace(scanner->text[position]);
 }
 
-static translationError readConstant(translationContext *context, Buffer<char> *fileContent, size_t *currentFilePosition, node<astNode> *node) {
-    customWarning(context, translationError::CONTEXT_BAD_POINTER);
-    customWarning(fileContent, translationError::BUFFER_BAD_POINTER);
+static bool readSymbolToken(astScanner *scanner, size_t *currentFilePosition, char symbol) {
+    size_t token = nextASTToken(scanner);
 
-    int number = 0;
-    int length = 0;
+    if (token >= scanner->size || scanner->text[token] != symbol || !isTokenOver(scanner, token + 1)) {
+        return false;
+    }
 
-    sscanf(fileContent->data + (*currentFilePosition), "%d%n", &number, &length);
-    (*currentFilePosition) += length;
+    *currentFilePosition = token + 1;
 
-    node->data.data.number = number;
+    return true;
+}
 
-    return translationError::NO_ERRORS;
+static bool readIntToken(astScanner *scanner, size_t *currentFilePosition, int *number) {
+    size_t token  = nextASTToken(scanner);
+    size_t length = 0;
+
+    if (token >= scanner->size ||
+        parseInt(scanner->text + token, scanner->size - token, number, &length) != numberParserError::NO_ERRORS ||
+        !isTokenOver(scanner, token + length)) {
+        return false;
+    }
+
+    *currentFilePosition = token + length;
+
+    return true;
 }
 
-static translationError readKeyword(translationContext *context, Buffer<char> *fileContent, size_t *currentFilePosition, node<astNode> *node) {
-    customWarning(context, translationError::CONTEXT_BAD_POINTER);
-    customWarning(fileContent, translationError::BUFFER_BAD_POINTER);
+static bool readSizeToken(astScanner *scanner, size_t *currentFilePosition, size_t *number) {
+    size_t token  = nextASTToken(scanner);
+    size_t length = 0;
 
-    int keywordID     = 0;
-    int keywordLength = 0;
+    if (token >= scanner->size ||
+        parseSize(scanner->text + token, scanner->size - token, number, &length) != numberParserError::NO_ERRORS ||
+        !isTokenOver(scanner, token + length)) {
+        return false;
+    }
 
-    sscanf(fileContent->data + (*currentFilePosition), "%d%n", &keywordID, &keywordLength);
-    (*currentFilePosition) += keywordLength;
-    
-    node->data.data.keyword = static_cast<Keyword>(keywordID);
+    *currentFilePosition = token + length;
 
-    return translationError::NO_ERRORS;
+    return true;
 }
 
-static translationError readIdentifierID(translationContext *context, Buffer<char> *fileContent, size_t *currentFilePosition, node<astNode> *node) {
-    customWarning(context, translationError::CONTEXT_BAD_POINTER);
-    customWarning(fileContent, translationError::BUFFER_BAD_POINTER);
+// a name is the whole run, whatever bytes it is made of
+static bool readNameToken(astScanner *scanner, size_t *currentFilePosition, size_t *nameBegin, size_t *nameLength) {
+    size_t token = nextASTToken(scanner);
 
-    int identifierLength = 0;
+    if (token >= scanner->size) {
+        return false;
+    }
 
-    sscanf(fileContent->data + (*currentFilePosition), "%lu%n", &node->data.data.nameTableIndex, &identifierLength);
-    (*currentFilePosition) += identifierLength;
+    size_t nameEnd = token + 1;
 
-    node->data.localTableOtherElementsCount = context->localTables->data[node->data.data.nameTableIndex].elements.currentIndex;
+    while (!isTokenOver(scanner, nameEnd)) {
+        nameEnd++;
+    }
 
-    return translationError::NO_ERRORS;
+    *nameBegin           = token;
+    *nameLength          = nameEnd - token;
+    *currentFilePosition = nameEnd;
+
+    return true;
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-typedef translationError (*readElement)(translationContext *, Buffer<char> *, size_t *, node<astNode> *);
-static const readElement READ_ELEMENT[] = {readConstant, 
-                                           readIdentifierID, 
-                                           readKeyword, 
-                                           readIdentifierID, 
-                                           readNone, 
-                                           readIdentifierID, 
-                                           readNone};
+// both formats store the same payloads
+static void setNodePayload(compactNode *currentNode, int64_t payload) {
+    switch (currentNode->type) {
+        case nodeType::CONSTANT:
+        {
+            currentNode->data.number = (int) payload;
+            break;
+        }
+
+        case nodeType::KEYWORD:
+        {
+            currentNode->data.keyword = static_cast<Keyword>(payload);
+            break;
+        }
+
+        case nodeType::STRING:
+        case nodeType::FUNCTION_DEFINITION:
+        case nodeType::VARIABLE_DECLARATION:
+        {
+            currentNode->data.nameTableIndex = (size_t) payload;
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+}
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
@@ -98,55 +146,109 @@ translationError readAST(translationContext *context, const char *fileName) {
 
     context->AST->root = readASTInternal(context, &fileContent, &currentFilePosition);
 
-    customWarning(context->AST->root, translationError::BAD_FILE_CONTENT);
+    bufferDestruct(&fileContent);
+
+    customWarning(context->AST->root != AST_NO_NODE, translationError::BAD_FILE_CONTENT);
 
     return translationError::NO_ERRORS;
 }
 
-node<astNode> *readASTInternal(translationContext *context, Buffer<char> *fileContent, size_t *currentFilePosition) {
-    if (!context || !fileContent) {
-        return NULL;
+// a subtree is "( type payload left right )" or "_"; the nodes still waiting for children are kept on a stack of their own.
+// the fields come from the scanner, the spaces between them are never looked at
+astHandle readASTInternal(translationContext *context, Buffer<char> *fileContent, size_t *currentFilePosition) {
+    if (!context || !fileContent || !currentFilePosition) {
+        return AST_NO_NODE;
     }
 
-    SKIP_SPACES();
+    astScanner scanner = {};
+    initializeASTScanner(&scanner, fileContent->data, fileContent->currentIndex, *currentFilePosition);
 
-    CHECK_SYMBOL('(', return NULL);
+    Buffer<readFrame> frames = {};
 
-    (*currentFilePosition)++;
-    SKIP_SPACES();
+    if (bufferInitialize(&frames) != bufferError::NO_BUFFER_ERROR) {
+        return AST_NO_NODE;
+    }
 
-    int nodeTypeID = -1;
-    sscanf(fileContent->data + (*currentFilePosition), "%d", &nodeTypeID);
+    astHandle root    = AST_NO_NODE;
+    bool      isValid = true;
 
-    if (nodeTypeID < 1 || nodeTypeID > 7) {
-        return NULL;
-    }
+    while (isValid) {
+        size_t token = nextASTToken(&scanner);
 
-    (*currentFilePosition)++;
-    SKIP_SPACES();
+        if (token < scanner.size && scanner.text[token] == '(' && isTokenOver(&scanner, token + 1)) {
+            int nodeTypeID = 0;
 
-    node<astNode> *node = NULL;
-    nodeInitialize(&node);
+            if (!readIntToken(&scanner, currentFilePosition, &nodeTypeID) || nodeTypeID < 1 || nodeTypeID > 7) {
+                isValid = false;
+                break;
+            }
 
-    node->data.type = static_cast<nodeType>(nodeTypeID);
+            compactNode newNode = {.type = static_cast<nodeType>(nodeTypeID)};
 
-    READ_ELEMENT[nodeTypeID - 1](context, fileContent, currentFilePosition, node);
+            // names are read as sizes and numbers as ints, the way they were written
+            int    number  = 0;
+            size_t payload = 0;
 
-    node->left  = readASTInternal(context, fileContent, currentFilePosition);
-    node->right = readASTInternal(context, fileContent, currentFilePosition);
+            if (newNode.type == nodeType::CONSTANT || newNode.type == nodeType::KEYWORD) {
+                isValid = readIntToken(&scanner, currentFilePosition, &number);
+                setNodePayload(&newNode, number);
+            } else if (hasNodePayload(newNode.type)) {
+                isValid = readSizeToken(&scanner, currentFilePosition, &payload);
+                setNodePayload(&newNode, (int64_t) payload);
+            }
 
-    if (node->left) {
-        node->left->parent = node;
-    }
+            // the reader goes in preorder, so the nodes are laid out in the order the translator walks them
+            readFrame      *parentFrame = frames.currentIndex > 0 ? &frames.data[frames.currentIndex - 1] : NULL;
+            compactLocation location    = {};
+            readFrame       newFrame    = {};
+
+            if (!isValid ||
+                appendCompactNode(context->AST, &newNode, &location, parentFrame ? parentFrame->current : AST_NO_NODE,
+                                  parentFrame && parentFrame->childrenRead == 1, &newFrame.current) != bufferError::NO_BUFFER_ERROR) {
+                isValid = false;
+                break;
+            }
+
+            if (!parentFrame) {
+                root = newFrame.current;
+            }
+
+            if (writeDataToBuffer(&frames, &newFrame, 1) != bufferError::NO_BUFFER_ERROR) {
+                isValid = false;
+                break;
+            }
+
+            continue;
+        }
+
+        if (token >= scanner.size || scanner.text[token] != '_' || !isTokenOver(&scanner, token + 1)) {
+            isValid = false;
+            break;
+        }
+
+        *currentFilePosition = token + 1;
+
+        // the subtree just read is over, so are all the nodes it was the right child of
+        while (frames.currentIndex > 0 && frames.data[frames.currentIndex - 1].childrenRead == 1) {
+            frames.currentIndex--;
+
+            if (!readSymbolToken(&scanner, currentFilePosition, ')')) {
+                isValid = false;
+                break;
+            }
+        }
 
-    if (node->right) {
-        node->right->parent = node;
+        if (!isValid || frames.currentIndex == 0) {
+            break;
+        }
+
+        frames.data[frames.currentIndex - 1].childrenRead = 1;
     }
 
-    SKIP_SPACES();
-    (*currentFilePosition)++;
+    bufferDestruct(&frames);
 
-    return node;
+    // whatever was linked so far stays in the array and goes away with the tree
+    return isValid ? root : AST_NO_NODE;
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -159,71 +261,86 @@ translationError readNameTable(translationContext *context, const char *fileName
     customWarning(writeFileDataToBuffer(&fileContent, fileName) == bufferError::NO_BUFFER_ERROR, 
                   translationError::FILE_READING_ERROR);
     
-    size_t currentFilePosition = 0;
+    size_t           currentFilePosition = 0;
+    translationError error               = readGlobalNameTable(context, &fileContent, &currentFilePosition);
 
-    readGlobalNameTable(context, &fileContent, &currentFilePosition);
+    astScanner scanner = {};
+    initializeASTScanner(&scanner, fileContent.data, fileContent.currentIndex, currentFilePosition);
 
-    size_t localTablesCount       = 0;
-    int    localTablesCountLength = 0;
+    size_t localTablesCount = 0;
 
-    sscanf(fileContent.data + currentFilePosition, "%lu%n", &localTablesCount, &localTablesCountLength);
-    currentFilePosition += localTablesCountLength;
+    if (error == translationError::NO_ERRORS && !readSizeToken(&scanner, &currentFilePosition, &localTablesCount)) {
+        error = translationError::BAD_FILE_CONTENT;
+    }
 
-    for (size_t localTableIndex = 0; localTableIndex < localTablesCount; localTableIndex++) {
+    for (size_t localTableIndex = 0; localTableIndex < localTablesCount && error == translationError::NO_ERRORS; localTableIndex++) {
         addLocalNameTable(localTableIndex, context->localTables);
-        readLocalNameTable(context, localTableIndex, &fileContent, &currentFilePosition);
+        error = readLocalNameTable(context, localTableIndex, &fileContent, &currentFilePosition);
         size_t nameTableID = context->localTables->data[localTableIndex].nameTableID;
         context->functionToLocalTable[nameTableID] = localTableIndex;
     }
 
-    return translationError::NO_ERRORS;
+    bufferDestruct(&fileContent);
+
+    return error;
 }
 
 translationError readGlobalNameTable(translationContext *context, Buffer<char> *fileContent, size_t *currentFilePosition) {
     customWarning(context,             translationError::CONTEXT_BAD_POINTER);
     customWarning(fileContent,         translationError::BUFFER_BAD_POINTER);
+    customWarning(currentFilePosition, translationError::BUFFER_BAD_POINTER);
 
-    size_t globalNameTableSize       = 0;
-    int    globalNameTableSizeLength = 0;
+    astScanner scanner = {};
+    initializeASTScanner(&scanner, fileContent->data, fileContent->currentIndex, *currentFilePosition);
 
-    sscanf(fileContent->data + (*currentFilePosition), "%lu%n", &globalNameTableSize, &globalNameTableSizeLength);
-    (*currentFilePosition) += globalNameTableSizeLength;
+    size_t globalNameTableSize = 0;
+    customWarning(readSizeToken(&scanner, currentFilePosition, &globalNameTableSize), translationError::BAD_FILE_CONTENT);
 
-    initializeNameTable(context->nameTable, false);
+    initializeNameTable(context->nameTable, context->interner, false);
 
     for (size_t globalNameTableIndex = 0; globalNameTableIndex < globalNameTableSize; globalNameTableIndex++) {
-        char *identifier       = NULL;
-        int   identifierLength = 0;
+        size_t identifierBegin  = 0;
+        size_t identifierLength = 0;
 
-        sscanf(fileContent->data + (*currentFilePosition), "%ms%n[^\n]", &identifier, &identifierLength);
-        (*currentFilePosition) += identifierLength;
+        if (!readNameToken(&scanner, currentFilePosition, &identifierBegin, &identifierLength)) {
+            return translationError::BAD_FILE_CONTENT;
+        }
 
-        addIdentifier(context->nameTable, identifier);
+        if (addIdentifier(context->nameTable, context->interner, fileContent->data + identifierBegin,
+                          identifierLength) != bufferError::NO_BUFFER_ERROR) {
+            return translationError::NAME_TABLE_ERROR;
+        }
     }
 
     return translationError::NO_ERRORS;
 }
 
 translationError readLocalNameTable(translationContext *context, size_t localTableIndex, Buffer<char> *fileContent, size_t *currentFilePosition) {
-    customWarning(context, translationError::CONTEXT_BAD_POINTER);
-    customWarning(fileContent, translationError::BUFFER_BAD_POINTER);
+    customWarning(context,             translationError::CONTEXT_BAD_POINTER);
+    customWarning(fileContent,         translationError::BUFFER_BAD_POINTER);
+    customWarning(currentFilePosition, translationError::BUFFER_BAD_POINTER);
+
+    astScanner scanner = {};
+    initializeASTScanner(&scanner, fileContent->data, fileContent->currentIndex, *currentFilePosition);
 
     size_t localNameTableSize = 0;
-    int localNameTableID = 0;
-    int localNameTableSizeLength = 0;
+    int    localNameTableID   = 0;
 
-    sscanf(fileContent->data + (*currentFilePosition), "%lu %d%n", &localNameTableSize, &localNameTableID, &localNameTableSizeLength);
-    (*currentFilePosition) += localNameTableSizeLength;
+    if (!readSizeToken(&scanner, currentFilePosition, &localNameTableSize) ||
+        !readIntToken (&scanner, currentFilePosition, &localNameTableID)) {
+        return translationError::BAD_FILE_CONTENT;
+    }
 
     context->localTables->data[localTableIndex].nameTableID = localNameTableID;
 
     for (size_t elementIndex = 0; elementIndex < localNameTableSize; elementIndex++) {
         size_t globalNameTableElementID = 0;
-        size_t elementType = 0;
-        int lineLength = 0;
+        size_t elementType              = 0;
 
-        sscanf(fileContent->data + (*currentFilePosition), "%lu %lu%n", &globalNameTableElementID, &elementType, &lineLength);
-        (*currentFilePosition) += lineLength;
+        if (!readSizeToken(&scanner, currentFilePosition, &globalNameTableElementID) ||
+            !readSizeToken(&scanner, currentFilePosition, &elementType)) {
+            return translationError::BAD_FILE_CONTENT;
+        }
 
         localNameTableElement element = {
             .type = static_cast<localNameType>(elementType),
@@ -236,4 +353,417 @@ translationError readLocalNameTable(translationContext *context, size_t localTab
     return translationError::NO_ERRORS;
 }
 
-// -------------------------------------------------------------------------------------------------------------------------------------------------- //
\ No newline at end of file
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static translationError readBinaryNameTable(translationContext *context, const binaryAST *ast) {
+    if (initializeNameTable(context->nameTable, context->interner, false) != bufferError::NO_BUFFER_ERROR) {
+        return translationError::NAME_TABLE_ERROR;
+    }
+
+    for (uint32_t nameIndex = 0; nameIndex < ast->header->namesCount; nameIndex++) {
+        if (addIdentifier(context->nameTable, context->interner, getBinaryName(ast, nameIndex),
+                          ast->names[nameIndex].length) != bufferError::NO_BUFFER_ERROR) {
+            return translationError::NAME_TABLE_ERROR;
+        }
+    }
+
+    for (uint32_t localTableIndex = 0; localTableIndex < ast->header->localTablesCount; localTableIndex++) {
+        const binaryASTLocalTable *localTable = &ast->localTables[localTableIndex];
+
+        addLocalNameTable((int) localTableIndex, context->localTables);
+        context->localTables->data[localTableIndex].nameTableID = localTable->nameTableID;
+
+        for (uint32_t elementIndex = 0; elementIndex < localTable->elementsCount; elementIndex++) {
+            const binaryASTLocalElement *binaryElement = &ast->localElements[localTable->firstElement + elementIndex];
+
+            localNameTableElement element = {
+                .type         = static_cast<localNameType>(binaryElement->type),
+                .globalNameID = binaryElement->globalNameID,
+                .rbpOffset    = 0
+            };
+            addLocalIdentifier((int) localTableIndex, context->localTables, element, 1);
+        }
+
+        context->functionToLocalTable[(size_t) localTable->nameTableID] = localTableIndex;
+    }
+
+    return translationError::NO_ERRORS;
+}
+
+// the entry point and everything it calls, over and over; the callee of a call is the name in its right child.
+// without a directory entry for the entry point nothing is left out, generateIR reports it
+static translationError markReachableFunctions(translationContext *context, const binaryAST *ast, bool *isLoaded) {
+    uint32_t functionsCount = ast->header->functionsCount;
+    uint32_t namesCount     = ast->header->namesCount;
+
+    // every function goes on the stack at most once
+    uint32_t *functionByName = (uint32_t *)calloc(namesCount,     sizeof(uint32_t));
+    uint32_t *stack          = (uint32_t *)calloc(functionsCount, sizeof(uint32_t));
+
+    if (!functionByName || !stack) {
+        FREE_(functionByName);
+        FREE_(stack);
+
+        return translationError::BAD_FILE_CONTENT;
+    }
+
+    for (uint32_t nameIndex = 0; nameIndex < namesCount; nameIndex++) {
+        functionByName[nameIndex] = functionsCount;
+    }
+
+    for (uint32_t functionIndex = 0; functionIndex < functionsCount; functionIndex++) {
+        functionByName[ast->functions[functionIndex].nameIndex] = functionIndex;
+    }
+
+    size_t stackSize = 0;
+
+    if (context->entryPoint < namesCount && functionByName[context->entryPoint] < functionsCount) {
+        stack[stackSize++]                            = functionByName[context->entryPoint];
+        isLoaded[functionByName[context->entryPoint]] = true;
+    } else {
+        memset(isLoaded, true, functionsCount * sizeof(bool));
+    }
+
+    while (stackSize > 0) {
+        const binaryASTFunction *function  = &ast->functions[stack[--stackSize]];
+        uint32_t                 firstNode = getFunctionFirstNode(ast, function);
+        uint32_t                 lastNode  = firstNode + getFunctionNodesCount(function);
+
+        for (uint32_t nodeIndex = firstNode; nodeIndex < lastNode; nodeIndex++) {
+            const binaryASTNode *callee = getBinaryNode(ast, ast->nodes[nodeIndex].right);
+
+            if (ast->nodes[nodeIndex].type != (uint32_t) nodeType::FUNCTION_CALL ||
+                !callee || callee->type != (uint32_t) nodeType::STRING ||
+                callee->payload < 0 || (uint64_t) callee->payload >= namesCount) {
+                continue;
+            }
+
+            uint32_t calleeIndex = functionByName[callee->payload];
+
+            if (calleeIndex < functionsCount && !isLoaded[calleeIndex]) {
+                isLoaded[calleeIndex] = true;
+                stack[stackSize++]    = calleeIndex;
+            }
+        }
+    }
+
+    FREE_(functionByName);
+    FREE_(stack);
+
+    return translationError::NO_ERRORS;
+}
+
+// mapBinaryAST has checked that every parent comes before its children, so the tree is linked in one pass over the nodes.
+// a function nobody reaches is stepped over whole: no node outside its section links into it, so the separator
+// that holds it is just left without a left child
+static translationError readBinaryNodes(translationContext *context, const binaryAST *ast) {
+    uint32_t nodesCount     = ast->header->nodesCount;
+    uint32_t functionsCount = ast->header->functionsCount;
+
+    customWarning(nodesCount > 0, translationError::BAD_FILE_CONTENT);
+
+    astHandle *handles  = (astHandle *)calloc(nodesCount, sizeof(astHandle));
+    bool      *isLoaded = (bool *)     calloc(functionsCount + 1, sizeof(bool));
+
+    if (!handles || !isLoaded) {
+        FREE_(handles);
+        FREE_(isLoaded);
+
+        return translationError::BAD_FILE_CONTENT;
+    }
+
+    translationError error         = markReachableFunctions(context, ast, isLoaded);
+    uint32_t         functionIndex = 0;
+
+    for (uint32_t nodeIndex = 0; nodeIndex < nodesCount && error == translationError::NO_ERRORS; nodeIndex++) {
+        // the directory is in file order, so one cursor is enough
+        if (functionIndex < functionsCount && nodeIndex == getFunctionFirstNode(ast, &ast->functions[functionIndex])) {
+            const binaryASTFunction *function = &ast->functions[functionIndex];
+
+            if (!isLoaded[functionIndex++]) {
+                nodeIndex += getFunctionNodesCount(function) - 1;
+                continue;
+            }
+        }
+
+        // the image carries no locations, the binary nodes are already in preorder
+        const binaryASTNode *binaryNode = &ast->nodes[nodeIndex];
+        compactNode          newNode    = {.type = static_cast<nodeType>(binaryNode->type)};
+        compactLocation      location   = {};
+        bool                 isRight    = binaryNode->parent != AST_NO_NODE && ast->nodes[binaryNode->parent].left != nodeIndex;
+
+        setNodePayload(&newNode, binaryNode->payload);
+
+        if (appendCompactNode(context->AST, &newNode, &location,
+                              binaryNode->parent != AST_NO_NODE ? handles[binaryNode->parent] : AST_NO_NODE, isRight,
+                              &handles[nodeIndex]) != bufferError::NO_BUFFER_ERROR) {
+            error = translationError::BAD_FILE_CONTENT;
+            break;
+        }
+    }
+
+    if (error == translationError::NO_ERRORS) {
+        context->AST->root = handles[ast->header->root];
+    }
+
+    FREE_(handles);
+    FREE_(isLoaded);
+
+    return error;
+}
+
+translationError importBinaryAST(translationContext *context, const binaryAST *ast) {
+    customWarning(context, translationError::CONTEXT_BAD_POINTER);
+    customWarning(ast,     translationError::BUFFER_BAD_POINTER);
+
+    translationError error = readBinaryNameTable(context, ast);
+
+    // the entry point picks the functions to load, so it has to be known before the nodes are read
+    context->entryPoint = ast->header->entryPoint;
+
+    if (error == translationError::NO_ERRORS) {
+        error = readBinaryNodes(context, ast);
+    }
+
+    return error;
+}
+
+translationError readBinaryAST(translationContext *context, const char *fileName) {
+    customWarning(context,  translationError::CONTEXT_BAD_POINTER);
+    customWarning(fileName, translationError::BAD_FILE_NAME);
+
+    binaryAST ast = {};
+    customWarning(mapBinaryAST(&ast, fileName) == binaryASTError::NO_ERRORS, translationError::FILE_READING_ERROR);
+
+    translationError error = importBinaryAST(context, &ast);
+
+    unmapBinaryAST(&ast);
+
+    return error;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// readBinaryNameTable over the front-end tables, keywords are left out and every name goes down by keywordsCount
+static translationError readHandoffNameTable(translationContext *context, const astHandoff *handoff) {
+    if (initializeNameTable(context->nameTable, context->interner, false) != bufferError::NO_BUFFER_ERROR) {
+        return translationError::NAME_TABLE_ERROR;
+    }
+
+    size_t keywordsCount = handoff->keywordsCount;
+
+    for (size_t nameIndex = keywordsCount; nameIndex < handoff->nameTable->currentIndex; nameIndex++) {
+        const nameTableElement *name = &handoff->nameTable->data[nameIndex];
+
+        if (addIdentifier(context->nameTable, context->interner, name->name, getNameLength(name)) != bufferError::NO_BUFFER_ERROR) {
+            return translationError::NAME_TABLE_ERROR;
+        }
+    }
+
+    for (size_t localTableIndex = 0; localTableIndex < handoff->localTables->currentIndex; localTableIndex++) {
+        const localNameTable *localTable  = &handoff->localTables->data[localTableIndex];
+        int                   nameTableID = localTable->nameTableID - (localTable->nameTableID > 0 ? (int) keywordsCount : 0);
+
+        addLocalNameTable((int) localTableIndex, context->localTables);
+        context->localTables->data[localTableIndex].nameTableID = nameTableID;
+
+        for (size_t elementIndex = 0; elementIndex < localTable->size; elementIndex++) {
+            localNameTableElement element = {
+                .type         = localTable->elements.data[elementIndex].type,
+                .globalNameID = localTable->elements.data[elementIndex].globalNameID - keywordsCount,
+                .rbpOffset    = 0
+            };
+            addLocalIdentifier((int) localTableIndex, context->localTables, element, 1);
+        }
+
+        context->functionToLocalTable[(size_t) nameTableID] = localTableIndex;
+    }
+
+    return translationError::NO_ERRORS;
+}
+
+// the definitions on the top-level separator chain, in the order buildFunctionDirectory lists them
+static translationError collectHandoffFunctions(const astHandoff *handoff, astNodeEncoder *encoder, Buffer<node<astNode> *> *functions) {
+    for (node<astNode> *separator = handoff->AST->root;
+         separator && encoder->getNodeKeyword(separator) == Keyword::OPERATOR_SEPARATOR; separator = separator->right) {
+        if (!separator->left || separator->left->data.type != nodeType::FUNCTION_DEFINITION) {
+            continue;
+        }
+
+        if (writeDataToBuffer(functions, &separator->left, 1) != bufferError::NO_BUFFER_ERROR) {
+            return translationError::BUFFER_BAD_POINTER;
+        }
+    }
+
+    return translationError::NO_ERRORS;
+}
+
+// markReachableFunctions over the front-end tree, names are still counted with the keywords here.
+// a shared expression is walked once per parent, it holds no calls anyway
+static translationError markReachableHandoff(const astHandoff *handoff, Buffer<node<astNode> *> *functions, bool *isLoaded) {
+    size_t functionsCount = functions->currentIndex;
+    size_t namesCount     = handoff->nameTable->currentIndex;
+
+    size_t *functionByName = (size_t *)calloc(namesCount,     sizeof(size_t));
+    size_t *stack          = (size_t *)calloc(functionsCount, sizeof(size_t));
+
+    Buffer<node<astNode> *> nodes = {};
+
+    if (!functionByName || !stack || bufferInitialize(&nodes) != bufferError::NO_BUFFER_ERROR) {
+        FREE_(functionByName);
+        FREE_(stack);
+
+        return translationError::BUFFER_BAD_POINTER;
+    }
+
+    for (size_t nameIndex = 0; nameIndex < namesCount; nameIndex++) {
+        functionByName[nameIndex] = functionsCount;
+    }
+
+    for (size_t functionIndex = 0; functionIndex < functionsCount; functionIndex++) {
+        functionByName[functions->data[functionIndex]->data.data.nameTableIndex] = functionIndex;
+    }
+
+    size_t stackSize = 0;
+
+    if (handoff->entryPoint < namesCount && functionByName[handoff->entryPoint] < functionsCount) {
+        stack[stackSize++]                            = functionByName[handoff->entryPoint];
+        isLoaded[functionByName[handoff->entryPoint]] = true;
+    } else {
+        memset(isLoaded, true, functionsCount * sizeof(bool));
+    }
+
+    translationError error = translationError::NO_ERRORS;
+
+    while (stackSize > 0 && error == translationError::NO_ERRORS) {
+        nodes.currentIndex = 0;
+
+        if (writeDataToBuffer(&nodes, &functions->data[stack[--stackSize]], 1) != bufferError::NO_BUFFER_ERROR) {
+            error = translationError::BUFFER_BAD_POINTER;
+        }
+
+        while (nodes.currentIndex > 0 && error == translationError::NO_ERRORS) {
+            node<astNode> *currentNode = nodes.data[--nodes.currentIndex];
+            node<astNode> *callee      = currentNode->right;
+
+            if ((currentNode->left  && writeDataToBuffer(&nodes, &currentNode->left,  1) != bufferError::NO_BUFFER_ERROR) ||
+                (currentNode->right && writeDataToBuffer(&nodes, &currentNode->right, 1) != bufferError::NO_BUFFER_ERROR)) {
+                error = translationError::BUFFER_BAD_POINTER;
+                break;
+            }
+
+            if (currentNode->data.type != nodeType::FUNCTION_CALL ||
+                !callee || callee->data.type != nodeType::STRING || callee->data.data.nameTableIndex >= namesCount) {
+                continue;
+            }
+
+            size_t calleeIndex = functionByName[callee->data.data.nameTableIndex];
+
+            if (calleeIndex < functionsCount && !isLoaded[calleeIndex]) {
+                isLoaded[calleeIndex] = true;
+                stack[stackSize++]    = calleeIndex;
+            }
+        }
+    }
+
+    bufferDestruct(&nodes);
+
+    FREE_(functionByName);
+    FREE_(stack);
+
+    return error;
+}
+
+// readBinaryNodes with the front-end tree in place of the nodes section: every node is encoded the way buildBinaryNodes
+// would have saved it and built right away. a shared expression is copied for each parent, the back-end reads parent
+static translationError readHandoffNodes(translationContext *context, const astHandoff *handoff) {
+    astNodeEncoder          encoder   = {{}, handoff->nameTable, handoff->keywordsCount};
+    Buffer<node<astNode> *> functions = {};
+    Buffer<handoffFrame>    frames    = {};
+
+    if (bufferInitialize(&functions) != bufferError::NO_BUFFER_ERROR || bufferInitialize(&frames) != bufferError::NO_BUFFER_ERROR) {
+        bufferDestruct(&functions);
+
+        return translationError::BUFFER_BAD_POINTER;
+    }
+
+    translationError error    = collectHandoffFunctions(handoff, &encoder, &functions);
+    bool            *isLoaded = (bool *)calloc(functions.currentIndex + 1, sizeof(bool));
+
+    if (!isLoaded) {
+        error = translationError::BUFFER_BAD_POINTER;
+    }
+
+    if (error == translationError::NO_ERRORS) {
+        error = markReachableHandoff(handoff, &functions, isLoaded);
+    }
+
+    handoffFrame rootFrame     = {.current = handoff->AST->root, .parent = AST_NO_NODE, .isRight = false};
+    size_t       functionIndex = 0;
+
+    if (error == translationError::NO_ERRORS && writeDataToBuffer(&frames, &rootFrame, 1) != bufferError::NO_BUFFER_ERROR) {
+        error = translationError::BUFFER_BAD_POINTER;
+    }
+
+    while (error == translationError::NO_ERRORS && frames.currentIndex > 0) {
+        handoffFrame frame = frames.data[--frames.currentIndex];
+
+        // functions come up in preorder in the order they were collected, so one cursor is enough
+        if (functionIndex < functions.currentIndex && frame.current == functions.data[functionIndex] && !isLoaded[functionIndex++]) {
+            continue;
+        }
+
+        // unlike the image, the front-end tree still knows where every node came from
+        binaryASTNode   record   = encoder.visit(frame.current);
+        compactNode     newNode  = {.type = static_cast<nodeType>(record.type)};
+        compactLocation location = {.line = frame.current->data.line};
+        astHandle       handle   = AST_NO_NODE;
+
+        setNodePayload(&newNode, record.payload);
+
+        if (internASTFile(context->AST, frame.current->data.file, &location.fileID) != bufferError::NO_BUFFER_ERROR ||
+            appendCompactNode(context->AST, &newNode, &location, frame.parent, frame.isRight, &handle) != bufferError::NO_BUFFER_ERROR) {
+            error = translationError::NODE_BAD_POINTER;
+            break;
+        }
+
+        if (frame.parent == AST_NO_NODE) {
+            context->AST->root = handle;
+        }
+
+        handoffFrame rightFrame = {.current = frame.current->right, .parent = handle, .isRight = true};
+        handoffFrame leftFrame  = {.current = frame.current->left,  .parent = handle, .isRight = false};
+
+        if ((rightFrame.current && writeDataToBuffer(&frames, &rightFrame, 1) != bufferError::NO_BUFFER_ERROR) ||
+            (leftFrame.current  && writeDataToBuffer(&frames, &leftFrame,  1) != bufferError::NO_BUFFER_ERROR)) {
+            error = translationError::BUFFER_BAD_POINTER;
+        }
+    }
+
+    bufferDestruct(&functions);
+    bufferDestruct(&frames);
+
+    FREE_(isLoaded);
+
+    return error;
+}
+
+translationError importASTHandoff(translationContext *context, const astHandoff *handoff) {
+    customWarning(context,                                    translationError::CONTEXT_BAD_POINTER);
+    customWarning(handoff,                                    translationError::AST_BAD_POINTER);
+    customWarning(handoff->AST && handoff->AST->root,         translationError::AST_BAD_POINTER);
+    customWarning(handoff->nameTable && handoff->localTables, translationError::NAME_TABLE_ERROR);
+
+    translationError error = readHandoffNameTable(context, handoff);
+
+    // the same number the binary header holds, a missing entry point is left for generateIR to report
+    context->entryPoint = (uint32_t) (handoff->entryPoint - handoff->keywordsCount);
+
+    if (error == translationError::NO_ERRORS) {
+        error = readHandoffNodes(context, handoff);
+    }
+
+    return error;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
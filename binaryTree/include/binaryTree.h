@@ -54,7 +54,7 @@ template<typename DT>
 inline binaryTreeError treeInitialize(binaryTree<DT> *tree) {
     customWarning(tree != NULL, binaryTreeError::TREE_NULL_POINTER);
 
-    if (nodeInitialize(&tree->root) != binaryTreeError::NO_ERRORS) {
+    if (nodeInitialize(tree, &tree->root) != binaryTreeError::NO_ERRORS) {
         return binaryTreeError::ROOT_NULL_POINTER;
     }
 
@@ -68,20 +68,72 @@ template<typename DT>
 inline binaryTreeError treeDestruct(binaryTree<DT> *tree) {
     customWarning(tree != NULL, binaryTreeError::TREE_NULL_POINTER);
 
-    if (tree->root) {
-        nodeDestruct(tree, &(tree->root));
+    treeNodesDestruct(tree);
+
+    if (tree->infoData) {
+        binaryTreeInfoDestruct(tree);
     }
 
-    binaryTreeInfoDestruct(tree);
+    return binaryTreeError::NO_ERRORS;
+}
+
+// releases every node the tree has ever allocated, the ones not linked to the root anymore included
+template<typename DT>
+inline binaryTreeError treeNodesDestruct(binaryTree<DT> *tree) {
+    customWarning(tree != NULL, binaryTreeError::TREE_NULL_POINTER);
+
+    while (tree->arena.blocks) {
+        nodeArenaBlock<DT> *nextBlock = tree->arena.blocks->next;
+
+        FREE_(tree->arena.blocks);
+
+        tree->arena.blocks = nextBlock;
+    }
+
+    tree->arena.freeNodes = NULL;
+    tree->root            = NULL;
 
     return binaryTreeError::NO_ERRORS;
 }
 
 template<typename DT>
-inline binaryTreeError nodeInitialize(node<DT> **currentNode) {
-    *currentNode = (node<DT> *)calloc(1, sizeof(node<DT>));
+inline binaryTreeError nodeInitialize(binaryTree<DT> *tree, node<DT> **currentNode) {
+    customWarning(tree        != NULL, binaryTreeError::TREE_NULL_POINTER);
+    customWarning(currentNode != NULL, binaryTreeError::NODE_NULL_POINTER);
+
+    nodeArena<DT> *arena = &tree->arena;
+
+    if (arena->freeNodes) {
+        *currentNode     = arena->freeNodes;
+        arena->freeNodes = arena->freeNodes->right;
+
+        **currentNode = node<DT>{};
+
+        return binaryTreeError::NO_ERRORS;
+    }
+
+    if (!arena->blocks || arena->blocks->used == arena->blocks->capacity) {
+        size_t capacity = arena->blocks ? arena->blocks->capacity * 2 : NODE_ARENA_FIRST_BLOCK;
+
+        if (capacity > NODE_ARENA_MAX_BLOCK) {
+            capacity = NODE_ARENA_MAX_BLOCK;
+        }
+
+        nodeArenaBlock<DT> *newBlock = (nodeArenaBlock<DT> *)calloc(1, sizeof(nodeArenaBlock<DT>) + capacity * sizeof(node<DT>));
+
+        *currentNode = NULL;
+        customWarning(newBlock != NULL, binaryTreeError::CALLOC_ERROR);
+
+        newBlock->next     = arena->blocks;
+        newBlock->nodes    = (node<DT> *)(newBlock + 1);
+        newBlock->capacity = capacity;
+        newBlock->used     = 0;
+
+        arena->blocks = newBlock;
+    }
 
-    customWarning(*currentNode != NULL, binaryTreeError::NODE_NULL_POINTER);
+    // blocks come zeroed from calloc, same as a node of its own used to
+    *currentNode = &arena->blocks->nodes[arena->blocks->used++];
 
     return binaryTreeError::NO_ERRORS;
 }
@@ -119,7 +171,7 @@ inline binaryTreeError nodeLink(binaryTree<DT> *tree, node<DT> *currentNode, lin
     }
 
     node<DT> *newNode = {};
-    nodeInitialize(&newNode);
+    nodeInitialize(tree, &newNode);
 
     newNode->parent = currentNode;
     newNode->left   =        NULL;
@@ -131,26 +183,190 @@ inline binaryTreeError nodeLink(binaryTree<DT> *tree, node<DT> *currentNode, lin
     return binaryTreeError::NO_ERRORS;
 }
 
+// the nodes go back to the arena of the tree, a whole tree is cheaper to drop with treeNodesDestruct
 template<typename DT>
-inline binaryTreeError nodeDestruct(binaryTree<DT> *tree, node<DT> **node) {
-    customWarning(tree         != NULL, binaryTreeError::TREE_NULL_POINTER);
-    customWarning(*node != NULL, binaryTreeError::NODE_NULL_POINTER);
+inline binaryTreeError nodeDestruct(binaryTree<DT> *tree, node<DT> **subtree) {
+    customWarning(tree     != NULL, binaryTreeError::TREE_NULL_POINTER);
+    customWarning(*subtree != NULL, binaryTreeError::NODE_NULL_POINTER);
+
+    // DUMP_(tree);
+
+    node<DT> *currentNode = *subtree;
 
-    if ((*node)->left) {
-        nodeDestruct(tree, &((*node)->left));
+    // left children are rotated up until there is none, so no path has to be remembered
+    while (currentNode) {
+        if (currentNode->left) {
+            node<DT> *leftNode = currentNode->left;
+
+            currentNode->left = leftNode->right;
+            leftNode->right   = currentNode;
+            currentNode       = leftNode;
+
+            continue;
+        }
+
+        node<DT> *nextNode = currentNode->right;
+
+        currentNode->right    = tree->arena.freeNodes;
+        tree->arena.freeNodes = currentNode;
+
+        currentNode = nextNode;
     }
 
-    if ((*node)->right) {
-        nodeDestruct(tree, &((*node)->right));
+    *subtree = NULL;
+
+    return binaryTreeError::NO_ERRORS;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+template<typename DT>
+inline binaryTreeError treeIteratorPush(treeIterator<DT> *iterator, node<DT> *currentNode) {
+    if (iterator->depth == iterator->capacity) {
+        size_t         newCapacity = iterator->capacity ? iterator->capacity * 2 : TREE_ITERATOR_FIRST_DEPTH;
+        treeFrame<DT> *newFrames   = (treeFrame<DT> *)realloc(iterator->frames, newCapacity * sizeof(treeFrame<DT>));
+
+        if (!newFrames) {
+            iterator->error = binaryTreeError::CALLOC_ERROR;
+            return binaryTreeError::CALLOC_ERROR;
+        }
+
+        iterator->frames   = newFrames;
+        iterator->capacity = newCapacity;
     }
 
-    // DUMP_(tree);
+    iterator->frames[iterator->depth++] = treeFrame<DT> {.current = currentNode, .visit = printType::PREFIX};
 
-    FREE_(*node);
+    return binaryTreeError::NO_ERRORS;
+}
+
+template<typename DT>
+inline binaryTreeError treeIteratorInitialize(treeIterator<DT> *iterator, node<DT> *root, printType order) {
+    customWarning(iterator != NULL, binaryTreeError::TREE_NULL_POINTER);
+
+    *iterator = {};
+
+    iterator->order = order;
+
+    if (root) {
+        return treeIteratorPush(iterator, root);
+    }
+
+    return binaryTreeError::NO_ERRORS;
+}
+
+template<typename DT>
+inline binaryTreeError treeWalkInitialize(treeIterator<DT> *iterator, node<DT> *root) {
+    customWarning(iterator != NULL, binaryTreeError::TREE_NULL_POINTER);
+
+    binaryTreeError error = treeIteratorInitialize(iterator, root, printType::PREFIX);
+
+    iterator->everyVisit = true;
+
+    return error;
+}
+
+template<typename DT>
+inline binaryTreeError treeIteratorDestruct(treeIterator<DT> *iterator) {
+    customWarning(iterator != NULL, binaryTreeError::TREE_NULL_POINTER);
+
+    FREE_(iterator->frames);
+
+    iterator->depth    = 0;
+    iterator->capacity = 0;
 
     return binaryTreeError::NO_ERRORS;
 }
 
+// NULL once the tree is over or a frame could not be allocated, iterator->error tells which
+template<typename DT>
+inline node<DT> *treeIteratorNext(treeIterator<DT> *iterator) {
+    customWarning(iterator != NULL, NULL);
+
+    while (iterator->depth > 0 && iterator->error == binaryTreeError::NO_ERRORS) {
+        treeFrame<DT> *frame       = &iterator->frames[iterator->depth - 1];
+        node<DT>      *currentNode = frame->current;
+        printType      visit       = frame->visit;
+
+        // the frame may move once a child is pushed
+        switch (visit) {
+            case printType::PREFIX:
+            {
+                frame->visit = printType::INFIX;
+
+                if (currentNode->left) {
+                    treeIteratorPush(iterator, currentNode->left);
+                }
+
+                break;
+            }
+
+            case printType::INFIX:
+            {
+                frame->visit = printType::POSTFIX;
+
+                if (currentNode->right) {
+                    treeIteratorPush(iterator, currentNode->right);
+                }
+
+                break;
+            }
+
+            case printType::POSTFIX:
+            default:
+            {
+                iterator->depth--;
+                break;
+            }
+        }
+
+        if (iterator->everyVisit || iterator->order == visit) {
+            iterator->visit = visit;
+            return currentNode;
+        }
+    }
+
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+template<typename DT>
+inline binaryTreeError chainIteratorInitialize(chainIterator<DT> *iterator, node<DT> *chain, bool (*isLink)(node<DT> *)) {
+    customWarning(iterator != NULL, binaryTreeError::TREE_NULL_POINTER);
+    customWarning(isLink   != NULL, binaryTreeError::TREE_NULL_POINTER);
+
+    iterator->link   = chain;
+    iterator->isLink = isLink;
+
+    return binaryTreeError::NO_ERRORS;
+}
+
+// the left child of every link in order, empty ones skipped, then the node that ends the chain if it is not a link
+template<typename DT>
+inline node<DT> *chainIteratorNext(chainIterator<DT> *iterator) {
+    customWarning(iterator != NULL, NULL);
+
+    while (iterator->link) {
+        node<DT> *link = iterator->link;
+
+        if (!iterator->isLink(link)) {
+            iterator->link = NULL;
+            return link;
+        }
+
+        iterator->link = link->right;
+
+        if (link->left) {
+            return link->left;
+        }
+    }
+
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
 template<typename DT>
 inline binaryTreeError callPrintBinaryTree(binaryTree<DT> *tree, printType type, FILE *stream) {
     customWarning(tree   != NULL, binaryTreeError::TREE_NULL_POINTER);
@@ -166,31 +382,27 @@ inline binaryTreeError printBinaryTree(node<DT> *currentNode, printType type, FI
     customWarning(currentNode   != NULL, binaryTreeError::NODE_NULL_POINTER);
     customWarning(stream        != NULL, binaryTreeError::BAD_STREAM_POINTER);
 
-    fprintf(stream, "(");
-
-    if (type == printType::PREFIX) {
-        printNode(currentNode, stream);
-    }
-
-    if (currentNode->left) {
-        printBinaryTree(currentNode->left, type, stream);
-    }
+    treeIterator<DT> iterator = {};
+    treeWalkInitialize(&iterator, currentNode);
 
-    if (type == printType::INFIX) {
-        printNode(currentNode, stream);
-    }
+    while (node<DT> *visitedNode = treeIteratorNext(&iterator)) {
+        if (iterator.visit == printType::PREFIX) {
+            fprintf(stream, "(");
+        }
 
-    if (currentNode->right) {
-        printBinaryTree(currentNode->right, type, stream);
-    }
+        if (iterator.visit == type) {
+            printNode(visitedNode, stream);
+        }
 
-    if (type == printType::POSTFIX) {
-        printNode(currentNode, stream);
+        if (iterator.visit == printType::POSTFIX) {
+            fprintf(stream, ")");
+        }
     }
 
-    fprintf(stream, ")");
+    binaryTreeError error = iterator.error;
+    treeIteratorDestruct(&iterator);
 
-    return binaryTreeError::NO_ERRORS;
+    return error;
 }
 
 template<typename DT>
@@ -316,10 +528,10 @@ inline binaryTreeError binaryTreeInfoDestruct(binaryTree<DT> *tree) {
 // }
 
 template<typename DT>
-node<DT> *emplaceNode(node<DT> currentNode) {
+node<DT> *emplaceNode(binaryTree<DT> *tree, node<DT> currentNode) {
     node<DT> *newNode = NULL;
 
-    nodeInitialize(&newNode);
+    nodeInitialize(tree, &newNode);
     customWarning(newNode != NULL, NULL);
 
     *newNode = currentNode;
@@ -64,6 +64,9 @@ static inline const size_t MAX_PATH_TO_FILE     =  100;
 static inline const size_t MAX_CMD_BUFFER_SIZE  =  100;
 static inline const size_t MAX_HEADER_SIZE      =  500;
 
+static inline const size_t NODE_ARENA_FIRST_BLOCK =   256;
+static inline const size_t NODE_ARENA_MAX_BLOCK   = 65536;
+
 template<typename DT>
 struct node {
     DT        data   =   {};
@@ -72,10 +75,56 @@ struct node {
     node<DT> *parent = NULL;
 };
 
+// the nodes live right after the header, in the same allocation
+template<typename DT>
+struct nodeArenaBlock {
+    nodeArenaBlock<DT> *next     = NULL;
+    node<DT>           *nodes    = NULL;
+    size_t              capacity = 0;
+    size_t              used     = 0;
+};
+
+// nodes are bumped out of the newest block in allocation order, so a tree built top-down lies contiguously in preorder
+template<typename DT>
+struct nodeArena {
+    nodeArenaBlock<DT> *blocks    = NULL; // newest first
+    node<DT>           *freeNodes = NULL; // given back by nodeDestruct, linked through right
+};
+
 template<typename DT>
 struct binaryTree {
     node<DT> *root           = NULL;
     binaryTreeInfo *infoData = NULL;
+    nodeArena<DT>   arena    = {};
+};
+
+static inline const size_t TREE_ITERATOR_FIRST_DEPTH = 16;
+
+template<typename DT>
+struct treeFrame {
+    node<DT> *current = NULL;
+    printType visit   = printType::PREFIX; // the next visit of current
+};
+
+// the path to the current node is kept on the heap, so deep trees don't grow the native stack
+template<typename DT>
+struct treeIterator {
+    treeFrame<DT>  *frames     = NULL;
+    size_t          depth      = 0;
+    size_t          capacity   = 0;
+
+    printType       order      = printType::PREFIX;
+    bool            everyVisit = false;                     // a walk returns each node on all three visits
+    printType       visit      = printType::PREFIX;         // visit of the node returned last
+    binaryTreeError error      = binaryTreeError::NO_ERRORS;
+};
+
+// a list kept as a chain of link nodes, each holding an element on the left and the rest of the list on the right.
+// the chain is followed in a loop, so a long list costs no native stack however it is visited
+template<typename DT>
+struct chainIterator {
+    node<DT> *link                = NULL; // the next link, or the node that ends the chain
+    bool    (*isLink)(node<DT> *) = NULL;
 };
 
 template<typename DT>
@@ -83,11 +132,27 @@ binaryTreeError treeInitialize         (binaryTree<DT> *tree);
 template<typename DT>
 binaryTreeError treeDestruct           (binaryTree<DT> *tree);
 template<typename DT>
-binaryTreeError nodeInitialize         (node<DT>      **currentNode);
+binaryTreeError treeNodesDestruct      (binaryTree<DT> *tree);
+template<typename DT>
+binaryTreeError nodeInitialize         (binaryTree<DT> *tree, node<DT> **currentNode);
 template<typename DT>
 binaryTreeError nodeLink               (binaryTree<DT> *tree, node<DT> *currentNode, linkDirection direction);
 template<typename DT>
-binaryTreeError nodeDestruct           (binaryTree<DT> *tree, node<DT> **node);
+binaryTreeError nodeDestruct           (binaryTree<DT> *tree, node<DT> **subtree);
+
+template<typename DT>
+binaryTreeError treeIteratorInitialize (treeIterator<DT> *iterator, node<DT> *root, printType order);
+template<typename DT>
+binaryTreeError treeWalkInitialize     (treeIterator<DT> *iterator, node<DT> *root);
+template<typename DT>
+binaryTreeError treeIteratorDestruct   (treeIterator<DT> *iterator);
+template<typename DT>
+node<DT>       *treeIteratorNext       (treeIterator<DT> *iterator);
+
+template<typename DT>
+binaryTreeError chainIteratorInitialize(chainIterator<DT> *iterator, node<DT> *chain, bool (*isLink)(node<DT> *));
+template<typename DT>
+node<DT>       *chainIteratorNext      (chainIterator<DT> *iterator);
 
 template<typename DT>
 binaryTreeError callPrintBinaryTree    (binaryTree<DT> *tree,        printType type, FILE *stream);
@@ -106,6 +171,6 @@ template<typename DT>
 binaryTreeError binaryTreeSetInfo      (binaryTree<DT> *tree);
 
 template<typename DT>
-node<DT>       *emplaceNode            (node<DT> currentNode);
+node<DT>       *emplaceNode            (binaryTree<DT> *tree, node<DT> currentNode);
 
 #endif // BINARY_TREE_DEF_H_
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef COMPILATION_CACHE_H_
+#define COMPILATION_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "buffer.h"
+#include "contentHash.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+enum class cacheError {
+    NO_ERRORS        = 0,
+    BAD_POINTER      = 1 << 0,
+    DIRECTORY_ERROR  = 1 << 1,
+    FILE_READ_ERROR  = 1 << 2,
+    FILE_WRITE_ERROR = 1 << 3,
+    BUFFER_ERROR     = 1 << 4,
+    NOT_FOUND        = 1 << 5
+};
+
+// goes into every key, so it has to change with anything that changes the .bin or the .s the compiler writes:
+// buildBinaryAST, generateIR and generateASM say so where that text is made
+static const char   COMPILER_VERSION[]     = "prison-compiler 4";
+
+static const size_t CACHE_DEFAULT_CAPACITY = 64 << 20;
+static const size_t CACHE_KEY_LENGTH       = 2 * CONTENT_HASH_SIZE;
+
+// what a key is built from, a front-end entry comes from the source file, a back-end one from the AST image
+// and a function one from the fingerprint of its definition
+static const char   CACHE_SOURCE_STAGE[]   = "source";
+static const char   CACHE_IMAGE_STAGE[]    = "image";
+static const char   CACHE_FUNCTION_STAGE[] = "function";
+
+// entries are <directory>/<key>.<kind>
+static const char   CACHE_AST_KIND[]       = "bin";
+static const char   CACHE_ASM_KIND[]       = "s";
+static const char   CACHE_FUNCTION_KIND[]  = "fn";     // the assembly of one function
+
+struct cacheKey {
+    char name[CACHE_KEY_LENGTH + 1] = {}; // hex digest
+};
+
+struct cacheStatistics {
+    uint64_t hits      = 0;
+    uint64_t misses    = 0;
+    uint64_t stores    = 0;
+    uint64_t evictions = 0;
+};
+
+struct compilationCache {
+    const char      *directory  = NULL;
+    size_t           capacity   = 0;    // bytes of entries kept, the least recently used go first
+    cacheStatistics  statistics = {};   // this run only, closeCompilationCache adds it to the directory ones
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+cacheError openCompilationCache (compilationCache *cache, const char *directory, size_t capacity);
+cacheError closeCompilationCache(compilationCache *cache, cacheStatistics *total);
+
+cacheError makeDataCacheKey     (cacheKey *key, const char *stage, const void *data, size_t size, const char *options);
+
+// a hit counts as a use for eviction, a store replaces the entry atomically so concurrent compiles never see half of one.
+// entries over the capacity are evicted when the cache is closed
+cacheError loadCacheEntry       (compilationCache *cache, const cacheKey *key, const char *kind, Buffer<char> *content);
+// a loaded entry the caller could not use after all: its hit is counted as a miss, the caller stores the entry again
+cacheError rejectCacheEntry     (compilationCache *cache);
+cacheError storeCacheEntry      (compilationCache *cache, const cacheKey *key, const char *kind, const void *data, size_t size);
+cacheError loadCacheFile        (compilationCache *cache, const cacheKey *key, const char *kind, const char *fileName);
+cacheError storeCacheFile       (compilationCache *cache, const cacheKey *key, const char *kind, const char *fileName);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // COMPILATION_CACHE_H_
@@ -0,0 +1,60 @@
+#ifndef COMPILER_STAGES_H_
+#define COMPILER_STAGES_H_
+
+#include "buffer.h"
+#include "astHandoff.h"
+#include "compilationCache.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+enum class driverError {
+    NO_ERRORS       = 0,
+    BAD_ARGUMENTS   = 1 << 0,
+    SOURCE_ERROR    = 1 << 1,
+    FRONT_END_ERROR = 1 << 2,
+    BACK_END_ERROR  = 1 << 3,
+    OUTPUT_ERROR    = 1 << 4
+};
+
+struct driverOptions {
+    const char *sourceFileName   = NULL;
+    const char *outputFileName   = NULL;
+
+    bool        saveAST          = false; // tree/<date>.bin, the file frontend writes for backend
+    bool        shareExpressions = false;
+
+    const char *cacheDirectory   = NULL;  // no cache without one
+    size_t      cacheCapacity    = 0;
+    bool        printCacheStats  = false;
+    bool        incremental      = false; // functions whose fingerprint is in the cache are not lowered again
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// sourceInput.h and core.h belong to the front-end, the back stage never sees more than the names
+struct sourceInput;
+struct compilationContext;
+
+// the source is opened once, so the cache key is taken over the very bytes the lexer reads
+driverError openSourceFile (const driverOptions *options, sourceInput **source);
+driverError closeSourceFile(sourceInput **source);
+// the whole source, a stream is read to its end first
+driverError getSourceBytes (sourceInput *source, const char **data, size_t *size);
+
+// the stages meet in an astHandoff.h handoff: the context stays open until the back-end has taken its tree,
+// closeFrontEnd is called either way
+driverError runFrontEnd  (const driverOptions *options, sourceInput *source, compilationContext **context, astHandoff *handoff);
+driverError closeFrontEnd(compilationContext **context);
+// a binaryAST.h image is only built for the cache and for options->saveAST
+driverError buildASTImage(compilationContext *context, Buffer<char> *image);
+
+// without a handoff the tree is read from image, which then came from the cache.
+// cache may be NULL, the back-end only keeps function fragments there with options->incremental
+driverError runBackEnd   (const driverOptions *options, const astHandoff *handoff, Buffer<char> *image, compilationCache *cache);
+
+driverError checkASTImage(const Buffer<char> *image);
+driverError saveASTImage (const Buffer<char> *image);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // COMPILER_STAGES_H_
@@ -0,0 +1,27 @@
+#ifndef CONTENT_HASH_H_
+#define CONTENT_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const size_t CONTENT_HASH_SIZE       = 32; // SHA-256
+static const size_t CONTENT_HASH_BLOCK_SIZE = 64;
+
+struct contentHash {
+    uint32_t      state[8]                       = {};
+    uint64_t      length                         = 0; // bytes hashed so far
+    unsigned char block[CONTENT_HASH_BLOCK_SIZE] = {};
+    size_t        blockSize                      = 0;
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+void initializeContentHash(contentHash *hash);
+void updateContentHash    (contentHash *hash, const void *data, size_t size);
+void finishContentHash    (contentHash *hash, unsigned char digest[CONTENT_HASH_SIZE]);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // CONTENT_HASH_H_
@@ -0,0 +1,191 @@
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "compilerStages.h"
+#include "compilationCache.h"
+#include "buffer.h"
+
+static const char *SAVE_AST_FLAG          = "--save-ast";
+static const char *SHARE_EXPRESSIONS_FLAG = "--share-expressions";
+static const char *CACHE_FLAG             = "--cache";
+static const char *CACHE_SIZE_FLAG        = "--cache-size";
+static const char *CACHE_STATS_FLAG       = "--cache-stats";
+static const char *INCREMENTAL_FLAG       = "--incremental";
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static driverError getAST      (const driverOptions *options, compilationCache *cache, compilationContext **frontEnd,
+                                astHandoff *handoff, Buffer<char> *image);
+static driverError getAssembly (const driverOptions *options, compilationCache *cache, const astHandoff *handoff, Buffer<char> *image);
+static bool        parseOptions(int argc, char *argv[], driverOptions *options);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// compiler source.prison output.s [--save-ast] [--share-expressions]
+//          [--cache directory [--cache-size bytes] [--cache-stats] [--incremental]]
+int main(int argc, char *argv[]) {
+    driverOptions options = {};
+
+    if (!parseOptions(argc, argv, &options)) {
+        fprintf(stderr, "usage: %s source.prison output.s [%s] [%s] [%s directory [%s bytes] [%s] [%s]]\n", argv[0],
+                SAVE_AST_FLAG, SHARE_EXPRESSIONS_FLAG, CACHE_FLAG, CACHE_SIZE_FLAG, CACHE_STATS_FLAG, INCREMENTAL_FLAG);
+        return 1;
+    }
+
+    // a cache that can't be opened only costs the time it would save
+    compilationCache  cacheStorage = {};
+    compilationCache *cache        = NULL;
+
+    if (options.cacheDirectory) {
+        if (openCompilationCache(&cacheStorage, options.cacheDirectory, options.cacheCapacity) == cacheError::NO_ERRORS) {
+            cache = &cacheStorage;
+        } else {
+            fprintf(stderr, "can't open cache \"%s\", compiling without it\n", options.cacheDirectory);
+        }
+    }
+
+    Buffer<char>        image    = {};
+    compilationContext *frontEnd = NULL;
+    astHandoff          handoff  = {};
+
+    if (bufferInitialize(&image) != bufferError::NO_BUFFER_ERROR) {
+        return 1;
+    }
+
+    driverError error = getAST(&options, cache, &frontEnd, &handoff, &image);
+
+    if (error == driverError::NO_ERRORS && options.saveAST) {
+        error = saveASTImage(&image);
+    }
+
+    if (error == driverError::NO_ERRORS) {
+        error = getAssembly(&options, cache, frontEnd ? &handoff : NULL, &image);
+    }
+
+    closeFrontEnd(&frontEnd);
+    bufferDestruct(&image);
+
+    if (cache) {
+        cacheStatistics run   = cache->statistics;
+        cacheStatistics total = {};
+
+        if (closeCompilationCache(cache, &total) == cacheError::NO_ERRORS && options.printCacheStats) {
+            fprintf(stderr, "cache: %" PRIu64 " hits, %" PRIu64 " misses this run; "
+                            "%" PRIu64 " hits, %" PRIu64 " misses, %" PRIu64 " stores, %" PRIu64 " evictions in total\n",
+                    run.hits, run.misses, total.hits, total.misses, total.stores, total.evictions);
+        }
+    }
+
+    if (error != driverError::NO_ERRORS) {
+        fprintf(stderr, "can't compile \"%s\" (error %d)\n", options.sourceFileName, (int) error);
+        return 1;
+    }
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// checked before the source is lexed, the key covers the source bytes and every option that reaches the front-end.
+// a hit leaves *frontEnd NULL and the tree in image, otherwise the tree is in handoff and image is only filled when needed
+static driverError getAST(const driverOptions *options, compilationCache *cache, compilationContext **frontEnd,
+                          astHandoff *handoff, Buffer<char> *image) {
+    sourceInput *source = NULL;
+
+    if (openSourceFile(options, &source) != driverError::NO_ERRORS) {
+        return driverError::SOURCE_ERROR;
+    }
+
+    const char *keyOptions = options->shareExpressions ? SHARE_EXPRESSIONS_FLAG : "";
+    const char *sourceData = NULL;
+    size_t      sourceSize = 0;
+
+    cacheKey key   = {};
+    bool     keyed = cache && getSourceBytes(source, &sourceData, &sourceSize) == driverError::NO_ERRORS &&
+                     makeDataCacheKey(&key, CACHE_SOURCE_STAGE, sourceData ? sourceData : "", sourceSize, keyOptions) == cacheError::NO_ERRORS;
+
+    if (keyed && loadCacheEntry(cache, &key, CACHE_AST_KIND, image) == cacheError::NO_ERRORS) {
+        if (checkASTImage(image) == driverError::NO_ERRORS) {
+            closeSourceFile(&source);
+
+            return driverError::NO_ERRORS;
+        }
+
+        rejectCacheEntry(cache);
+    }
+
+    // a broken entry is compiled again and replaced, a failed store only means the next compile does the work again
+    driverError error = runFrontEnd(options, source, frontEnd, handoff);
+
+    if (error == driverError::NO_ERRORS && (cache || options->saveAST)) {
+        error = buildASTImage(*frontEnd, image);
+    }
+
+    if (error == driverError::NO_ERRORS && keyed) {
+        storeCacheEntry(cache, &key, CACHE_AST_KIND, image->data, image->currentIndex);
+    }
+
+    closeSourceFile(&source);
+
+    return error;
+}
+
+// checked before generateIR, the image already stands for the source and the front-end options
+static driverError getAssembly(const driverOptions *options, compilationCache *cache, const astHandoff *handoff, Buffer<char> *image) {
+    cacheKey key   = {};
+    bool     keyed = cache && makeDataCacheKey(&key, CACHE_IMAGE_STAGE, image->data, image->currentIndex, "") == cacheError::NO_ERRORS;
+
+    if (keyed && loadCacheFile(cache, &key, CACHE_ASM_KIND, options->outputFileName) == cacheError::NO_ERRORS) {
+        return driverError::NO_ERRORS;
+    }
+
+    // with options->incremental a miss here still reuses the functions that didn't change
+    driverError error = runBackEnd(options, handoff, image, cache);
+
+    if (error == driverError::NO_ERRORS && keyed) {
+        storeCacheFile(cache, &key, CACHE_ASM_KIND, options->outputFileName);
+    }
+
+    return error;
+}
+
+static bool parseOptions(int argc, char *argv[], driverOptions *options) {
+    options->cacheCapacity = CACHE_DEFAULT_CAPACITY;
+
+    for (int argumentIndex = 1; argumentIndex < argc; argumentIndex++) {
+        const char *argument = argv[argumentIndex];
+
+        if (strcmp(argument, SAVE_AST_FLAG) == 0) {
+            options->saveAST = true;
+        } else if (strcmp(argument, SHARE_EXPRESSIONS_FLAG) == 0) {
+            options->shareExpressions = true;
+        } else if (strcmp(argument, CACHE_STATS_FLAG) == 0) {
+            options->printCacheStats = true;
+        } else if (strcmp(argument, INCREMENTAL_FLAG) == 0) {
+            options->incremental = true;
+        } else if (strcmp(argument, CACHE_FLAG) == 0 && argumentIndex + 1 < argc) {
+            options->cacheDirectory = argv[++argumentIndex];
+        } else if (strcmp(argument, CACHE_SIZE_FLAG) == 0 && argumentIndex + 1 < argc) {
+            char *end = NULL;
+
+            options->cacheCapacity = (size_t) strtoull(argv[++argumentIndex], &end, 10);
+
+            if (*end != '\0') {
+                return false;
+            }
+        } else if (!options->sourceFileName) {
+            options->sourceFileName = argument;
+        } else if (!options->outputFileName) {
+            options->outputFileName = argument;
+        } else {
+            return false;
+        }
+    }
+
+    // the fragments of the previous build are kept in the cache
+    return options->sourceFileName && options->outputFileName && (!options->incremental || options->cacheDirectory);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -0,0 +1,297 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "compilerStages.h"
+#include "compilationCache.h"
+#include "contentHash.h"
+#include "core.h"
+#include "treeReader.h"
+#include "binaryAST.h"
+#include "IRBasics.h"
+#include "IRGenerator.h"
+#include "ASMGenerator.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static driverError generateIncrementally(const driverOptions *options, compilationCache *cache, IR_Context *IRContext);
+static void        hashModuleSignature  (IR_Context *IRContext, unsigned char digest[CONTENT_HASH_SIZE]);
+static size_t      countParameters      (compactAST *AST, compactNode *definition);
+static bufferError describeFunction     (IR_Context *IRContext, astHandle definition,
+                                         const unsigned char signature[CONTENT_HASH_SIZE], Buffer<char> *description);
+static bufferError describeNode         (IR_Context *IRContext, compactNode *currentNode, Buffer<char> *description);
+static driverError writeFragments       (const driverOptions *options, IR_Context *IRContext, Buffer<char> *fragments);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+driverError runBackEnd(const driverOptions *options, const astHandoff *handoff, Buffer<char> *image, compilationCache *cache) {
+    customWarning(options, driverError::BAD_ARGUMENTS);
+    customWarning(image,   driverError::BAD_ARGUMENTS);
+
+    binaryAST ast = {};
+
+    if (!handoff && viewBinaryAST(&ast, image->data, image->currentIndex) != binaryASTError::NO_ERRORS) {
+        return driverError::BACK_END_ERROR;
+    }
+
+    translationContext ASTContext = {};
+    initializeTranslationContext(&ASTContext);
+
+    IR_Context IRContext = {};
+    initializeIRContext(&IRContext, &ASTContext);
+
+    driverError error = driverError::NO_ERRORS;
+
+    translationError importError = handoff ? importASTHandoff(&ASTContext, handoff) : importBinaryAST(&ASTContext, &ast);
+
+    if (importError != translationError::NO_ERRORS) {
+        error = driverError::BACK_END_ERROR;
+    }
+
+    if (error == driverError::NO_ERRORS && options->incremental && cache) {
+        error = generateIncrementally(options, cache, &IRContext);
+    } else if (error == driverError::NO_ERRORS) {
+        if (generateIR(&IRContext) != IR_Error::NO_ERRORS) {
+            error = driverError::BACK_END_ERROR;
+        } else if (generateASM(&IRContext, IRContext.representation, options->outputFileName) != IR_Error::NO_ERRORS) {
+            error = driverError::OUTPUT_ERROR;
+        }
+    }
+
+    destroyTranslationContext(&ASTContext);
+    destroyIRContext         (&IRContext);
+
+    return error;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// a function is lowered only when the cache has no assembly for its fingerprint, the file is put together from
+// the fragments in the order generateASM writes them.
+// only lowering is skipped: the whole module is still imported and every function is hashed on each build
+static driverError generateIncrementally(const driverOptions *options, compilationCache *cache, IR_Context *IRContext) {
+    if (prepareIR(IRContext) != IR_Error::NO_ERRORS) {
+        return driverError::BACK_END_ERROR;
+    }
+
+    size_t functionsCount = IRContext->functions.size();
+
+    bool         *lower     = (bool *)        calloc(functionsCount, sizeof(bool));
+    cacheKey     *keys      = (cacheKey *)    calloc(functionsCount, sizeof(cacheKey));
+    Buffer<char> *fragments = (Buffer<char> *)calloc(functionsCount, sizeof(Buffer<char>));
+
+    Buffer<char> description = {};
+    driverError  error       = driverError::NO_ERRORS;
+
+    if (!lower || !keys || !fragments || bufferInitialize(&description) != bufferError::NO_BUFFER_ERROR) {
+        error = driverError::BACK_END_ERROR;
+    }
+
+    unsigned char signature[CONTENT_HASH_SIZE] = {};
+    hashModuleSignature(IRContext, signature);
+
+    for (size_t functionIndex = 0; functionIndex < functionsCount && error == driverError::NO_ERRORS; functionIndex++) {
+        if (bufferInitialize(&fragments[functionIndex]) != bufferError::NO_BUFFER_ERROR ||
+            describeFunction(IRContext, IRContext->functions[functionIndex], signature, &description) != bufferError::NO_BUFFER_ERROR) {
+            error = driverError::BACK_END_ERROR;
+            break;
+        }
+
+        makeDataCacheKey(&keys[functionIndex], CACHE_FUNCTION_STAGE, description.data, description.currentIndex, "");
+
+        lower[functionIndex] = loadCacheEntry(cache, &keys[functionIndex], CACHE_FUNCTION_KIND,
+                                              &fragments[functionIndex]) != cacheError::NO_ERRORS;
+    }
+
+    if (error == driverError::NO_ERRORS && generateFunctionsIR(IRContext, lower) != IR_Error::NO_ERRORS) {
+        error = driverError::BACK_END_ERROR;
+    }
+
+    for (size_t functionIndex = 0; functionIndex < functionsCount && error == driverError::NO_ERRORS; functionIndex++) {
+        if (!lower[functionIndex]) {
+            continue;
+        }
+
+        std::string text;
+
+        if (generateFunctionASM(IRContext, IRContext->representation, functionIndex, text) != IR_Error::NO_ERRORS) {
+            error = driverError::BACK_END_ERROR;
+            break;
+        }
+
+        fragments[functionIndex].currentIndex = 0;
+
+        if (writeDataToBuffer(&fragments[functionIndex], text.data(), text.size()) != bufferError::NO_BUFFER_ERROR) {
+            error = driverError::BACK_END_ERROR;
+            break;
+        }
+
+        // a fragment that can't be stored is lowered again next time
+        storeCacheEntry(cache, &keys[functionIndex], CACHE_FUNCTION_KIND, text.data(), text.size());
+    }
+
+    if (error == driverError::NO_ERRORS) {
+        error = writeFragments(options, IRContext, fragments);
+    }
+
+    for (size_t functionIndex = 0; fragments && functionIndex < functionsCount; functionIndex++) {
+        bufferDestruct(&fragments[functionIndex]);
+    }
+
+    bufferDestruct(&description);
+
+    FREE_(lower);
+    FREE_(keys);
+    FREE_(fragments);
+
+    return error;
+}
+
+// what a caller's assembly may take from the rest of the module: the functions, their order and their parameters.
+// a change here is rare and lowers every function again
+static void hashModuleSignature(IR_Context *IRContext, unsigned char digest[CONTENT_HASH_SIZE]) {
+    contentHash hash = {};
+    initializeContentHash(&hash);
+
+    for (size_t functionIndex = 0; functionIndex < IRContext->functions.size(); functionIndex++) {
+        compactAST  *AST        = IRContext->ASTContext->AST;
+        compactNode *definition = getCompactNode(AST, IRContext->functions[functionIndex]);
+        const char  *name       = IRContext->ASTContext->nameTable->data[definition->data.nameTableIndex].name;
+        uint64_t     parameters = countParameters(AST, definition);
+
+        updateContentHash(&hash, name,        strlen(name) + 1);
+        updateContentHash(&hash, &parameters, sizeof(parameters));
+    }
+
+    uint64_t entryPointIndex = IRContext->representation->entryPointIndex;
+    updateContentHash(&hash, &entryPointIndex, sizeof(entryPointIndex));
+
+    finishContentHash(&hash, digest);
+}
+
+static size_t countParameters(compactAST *AST, compactNode *definition) {
+    size_t       parametersCount = 0;
+    compactNode *parameters      = getCompactRight(AST, definition);
+
+    for (compactNode *parameter = parameters ? getCompactLeft(AST, parameters) : NULL;
+         parameter && parameter->type == nodeType::VARIABLE_DECLARATION; parameter = getCompactRight(AST, parameter)) {
+        parametersCount++;
+    }
+
+    return parametersCount;
+}
+
+// the fingerprint covers the module signature, the local table of the function and its whole subtree
+static bufferError describeFunction(IR_Context *IRContext, astHandle definition,
+                                    const unsigned char signature[CONTENT_HASH_SIZE], Buffer<char> *description) {
+    description->currentIndex = 0;
+
+    bufferError error = writeDataToBuffer(description, signature, CONTENT_HASH_SIZE);
+
+    translationContext *ASTContext = IRContext->ASTContext;
+    compactAST         *AST        = ASTContext->AST;
+    auto                localTable = ASTContext->functionToLocalTable.find(getCompactNode(AST, definition)->data.nameTableIndex);
+
+    if (localTable != ASTContext->functionToLocalTable.end()) {
+        localNameTable *table = &ASTContext->localTables->data[localTable->second];
+
+        for (size_t elementIndex = 0; elementIndex < table->size && error == bufferError::NO_BUFFER_ERROR; elementIndex++) {
+            uint64_t element[2] = {table->elements.data[elementIndex].globalNameID,
+                                   (uint64_t) table->elements.data[elementIndex].type};
+
+            error = writeDataToBuffer(description, element, sizeof(element));
+        }
+    }
+
+    Buffer<astHandle> stack = {};
+
+    if (error != bufferError::NO_BUFFER_ERROR || bufferInitialize(&stack) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
+    error = writeDataToBuffer(&stack, &definition, 1);
+
+    // preorder with the children a node has, which is enough to tell two shapes apart
+    while (error == bufferError::NO_BUFFER_ERROR && stack.currentIndex > 0) {
+        compactNode *currentNode = getCompactNode(AST, stack.data[--stack.currentIndex]);
+
+        error = describeNode(IRContext, currentNode, description);
+
+        if (currentNode->right != AST_NO_NODE && error == bufferError::NO_BUFFER_ERROR) {
+            error = writeDataToBuffer(&stack, &currentNode->right, 1);
+        }
+
+        if (currentNode->left != AST_NO_NODE && error == bufferError::NO_BUFFER_ERROR) {
+            error = writeDataToBuffer(&stack, &currentNode->left, 1);
+        }
+    }
+
+    bufferDestruct(&stack);
+
+    return error;
+}
+
+// names go in as text too: a call is written with the name of its callee
+static bufferError describeNode(IR_Context *IRContext, compactNode *currentNode, Buffer<char> *description) {
+    nodeType type    = currentNode->type;
+    int64_t  payload = 0;
+    char     shape   = (char) ((currentNode->left != AST_NO_NODE ? 1 : 0) | (currentNode->right != AST_NO_NODE ? 2 : 0));
+
+    if (type == nodeType::CONSTANT) {
+        payload = currentNode->data.number;
+    } else if (type == nodeType::KEYWORD) {
+        payload = (int64_t) currentNode->data.keyword;
+    } else if (hasNodePayload(type)) {
+        payload = (int64_t) currentNode->data.nameTableIndex;
+    }
+
+    uint32_t    storedType = (uint32_t) type;
+    bufferError error      = writeDataToBuffer(description, &storedType, sizeof(storedType));
+
+    if (error == bufferError::NO_BUFFER_ERROR) {
+        error = writeDataToBuffer(description, &payload, sizeof(payload));
+    }
+
+    if (error == bufferError::NO_BUFFER_ERROR) {
+        error = writeDataToBuffer(description, &shape, 1);
+    }
+
+    if (error == bufferError::NO_BUFFER_ERROR && hasNodePayload(type) &&
+        type != nodeType::CONSTANT && type != nodeType::KEYWORD) {
+        const char *name = IRContext->ASTContext->nameTable->data[payload].name;
+
+        error = writeDataToBuffer(description, name, strlen(name) + 1);
+    }
+
+    return error;
+}
+
+static driverError writeFragments(const driverOptions *options, IR_Context *IRContext, Buffer<char> *fragments) {
+    std::string header;
+
+    if (generateASMHeader(IRContext, header) != IR_Error::NO_ERRORS) {
+        return driverError::BACK_END_ERROR;
+    }
+
+    FILE *outputFile = fopen(options->outputFileName, "w");
+    customWarning(outputFile, driverError::OUTPUT_ERROR);
+
+    bool   written         = fwrite(header.data(), sizeof(char), header.size(), outputFile) == header.size();
+    size_t entryPointIndex = IRContext->representation->entryPointIndex;
+
+    // the entry point first, then the rest in the order of the tree, as generateFunctionsIR lowers them
+    for (size_t order = 0; order < IRContext->functions.size() && written; order++) {
+        size_t        functionIndex = order == 0 ? entryPointIndex : (order <= entryPointIndex ? order - 1 : order);
+        Buffer<char> *fragment      = &fragments[functionIndex];
+
+        written = fwrite(fragment->data, sizeof(char), fragment->currentIndex, outputFile) == fragment->currentIndex;
+    }
+
+    if (fclose(outputFile) != 0 || !written) {
+        return driverError::OUTPUT_ERROR;
+    }
+
+    return driverError::NO_ERRORS;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -0,0 +1,474 @@
+#include <cerrno>
+#include <cinttypes>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "customWarning.h"
+#include "compilationCache.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const char   CACHE_STATISTICS_FILE[] = "statistics";
+static const char   CACHE_TEMPORARY_KIND[]  = "tmp";
+static const size_t CACHE_CHUNK_SIZE        = 1 << 14;
+static const time_t CACHE_STALE_SECONDS     = 60 * 60; // a temporary file this old was left by a compile that died
+
+struct cacheEntryInfo {
+    char   name[NAME_MAX + 1] = {};
+    size_t size               = 0;
+    time_t lastUse            = 0;
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static void       startCacheKey        (contentHash *hash, const char *stage, const char *options);
+static void       finishCacheKey       (contentHash *hash, cacheKey *key);
+static bool       getEntryPath         (char *path, const compilationCache *cache, const char *name);
+static bool       isCacheEntryName     (const char *name);
+static bool       isTemporaryName      (const char *name);
+static int        compareEntriesByUse  (const void *first, const void *second);
+static cacheError readDescriptor       (int descriptor, Buffer<char> *content);
+static cacheError writeDescriptor      (int descriptor, const void *data, size_t size);
+static cacheError trimCompilationCache (compilationCache *cache);
+static void       parseCacheStatistics (const char *text, cacheStatistics *statistics);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+cacheError openCompilationCache(compilationCache *cache, const char *directory, size_t capacity) {
+    customWarning(cache,     cacheError::BAD_POINTER);
+    customWarning(directory, cacheError::BAD_POINTER);
+
+    *cache = {};
+
+    // a compile running next to us may create it first
+    if (mkdir(directory, 0755) != 0 && errno != EEXIST) {
+        return cacheError::DIRECTORY_ERROR;
+    }
+
+    struct stat directoryStat = {};
+
+    if (stat(directory, &directoryStat) != 0 || !S_ISDIR(directoryStat.st_mode)) {
+        return cacheError::DIRECTORY_ERROR;
+    }
+
+    cache->directory = directory;
+    cache->capacity  = capacity;
+
+    return cacheError::NO_ERRORS;
+}
+
+// the directory is trimmed once per run, a run that stores every function of a module doesn't scan it for each one.
+// the counters of every run are added up under a lock, so none is lost when compiles finish together.
+// total gets the sums with this run in them, it may be NULL
+cacheError closeCompilationCache(compilationCache *cache, cacheStatistics *total) {
+    customWarning(cache, cacheError::BAD_POINTER);
+
+    if (!cache->directory) {
+        return cacheError::NO_ERRORS;
+    }
+
+    if (cache->statistics.stores > 0) {
+        trimCompilationCache(cache);
+    }
+
+    char path[PATH_MAX] = {};
+
+    if (!getEntryPath(path, cache, CACHE_STATISTICS_FILE)) {
+        return cacheError::DIRECTORY_ERROR;
+    }
+
+    int descriptor = open(path, O_RDWR | O_CREAT, 0644);
+    customWarning(descriptor >= 0, cacheError::FILE_WRITE_ERROR);
+
+    cacheError   error = cacheError::NO_ERRORS;
+    Buffer<char> text  = {};
+
+    if (flock(descriptor, LOCK_EX) != 0 || bufferInitialize(&text) != bufferError::NO_BUFFER_ERROR) {
+        close(descriptor);
+
+        return cacheError::FILE_WRITE_ERROR;
+    }
+
+    error = readDescriptor(descriptor, &text);
+
+    if (error == cacheError::NO_ERRORS && writeDataToBuffer(&text, "", 1) != bufferError::NO_BUFFER_ERROR) {
+        error = cacheError::BUFFER_ERROR;
+    }
+
+    if (error == cacheError::NO_ERRORS) {
+        cacheStatistics sums = {};
+        parseCacheStatistics(text.data, &sums);
+
+        sums.hits      += cache->statistics.hits;
+        sums.misses    += cache->statistics.misses;
+        sums.stores    += cache->statistics.stores;
+        sums.evictions += cache->statistics.evictions;
+
+        if (total) {
+            *total = sums;
+        }
+
+        char updated[256] = {};
+        int  length       = snprintf(updated, sizeof(updated), "hits %" PRIu64 "\nmisses %" PRIu64 "\nstores %" PRIu64 "\nevictions %" PRIu64 "\n",
+                                     sums.hits, sums.misses, sums.stores, sums.evictions);
+
+        if (ftruncate(descriptor, 0) != 0 || lseek(descriptor, 0, SEEK_SET) != 0) {
+            error = cacheError::FILE_WRITE_ERROR;
+        } else {
+            error = writeDescriptor(descriptor, updated, (size_t) length);
+        }
+    }
+
+    bufferDestruct(&text);
+
+    // closing drops the lock
+    close(descriptor);
+
+    *cache = {};
+
+    return error;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+cacheError makeDataCacheKey(cacheKey *key, const char *stage, const void *data, size_t size, const char *options) {
+    customWarning(key,     cacheError::BAD_POINTER);
+    customWarning(stage,   cacheError::BAD_POINTER);
+    customWarning(data,    cacheError::BAD_POINTER);
+    customWarning(options, cacheError::BAD_POINTER);
+
+    contentHash hash = {};
+    startCacheKey(&hash, stage, options);
+
+    updateContentHash(&hash, data, size);
+    finishCacheKey   (&hash, key);
+
+    return cacheError::NO_ERRORS;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+cacheError loadCacheEntry(compilationCache *cache, const cacheKey *key, const char *kind, Buffer<char> *content) {
+    customWarning(cache,   cacheError::BAD_POINTER);
+    customWarning(key,     cacheError::BAD_POINTER);
+    customWarning(kind,    cacheError::BAD_POINTER);
+    customWarning(content, cacheError::BAD_POINTER);
+
+    char name[NAME_MAX + 1] = {};
+    char path[PATH_MAX]     = {};
+
+    snprintf(name, sizeof(name), "%s.%s", key->name, kind);
+
+    int descriptor = getEntryPath(path, cache, name) ? open(path, O_RDONLY) : -1;
+
+    if (descriptor < 0) {
+        cache->statistics.misses++;
+
+        return cacheError::NOT_FOUND;
+    }
+
+    cacheError error = readDescriptor(descriptor, content);
+
+    // the modification time is the last use, it works on filesystems mounted with noatime too
+    if (error == cacheError::NO_ERRORS) {
+        futimens(descriptor, NULL);
+    }
+
+    close(descriptor);
+
+    if (error != cacheError::NO_ERRORS) {
+        cache->statistics.misses++;
+
+        return error;
+    }
+
+    cache->statistics.hits++;
+
+    return cacheError::NO_ERRORS;
+}
+
+cacheError rejectCacheEntry(compilationCache *cache) {
+    customWarning(cache,                       cacheError::BAD_POINTER);
+    customWarning(cache->statistics.hits != 0, cacheError::NOT_FOUND);
+
+    cache->statistics.hits--;
+    cache->statistics.misses++;
+
+    return cacheError::NO_ERRORS;
+}
+
+// written next to the entry and renamed over it, a reader gets either the old file or the whole new one
+cacheError storeCacheEntry(compilationCache *cache, const cacheKey *key, const char *kind, const void *data, size_t size) {
+    customWarning(cache, cacheError::BAD_POINTER);
+    customWarning(key,   cacheError::BAD_POINTER);
+    customWarning(kind,  cacheError::BAD_POINTER);
+    customWarning(data,  cacheError::BAD_POINTER);
+
+    char name         [NAME_MAX + 1] = {};
+    char temporaryName[NAME_MAX + 1] = {};
+    char path         [PATH_MAX]     = {};
+    char temporaryPath[PATH_MAX]     = {};
+
+    snprintf(name,          sizeof(name),          "%s.%s",        key->name, kind);
+    snprintf(temporaryName, sizeof(temporaryName), "%s.%s.%ld.%s", key->name, kind, (long) getpid(), CACHE_TEMPORARY_KIND);
+
+    if (!getEntryPath(path, cache, name) || !getEntryPath(temporaryPath, cache, temporaryName)) {
+        return cacheError::DIRECTORY_ERROR;
+    }
+
+    int descriptor = open(temporaryPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    customWarning(descriptor >= 0, cacheError::FILE_WRITE_ERROR);
+
+    cacheError error = writeDescriptor(descriptor, data, size);
+
+    if (close(descriptor) != 0 && error == cacheError::NO_ERRORS) {
+        error = cacheError::FILE_WRITE_ERROR;
+    }
+
+    if (error == cacheError::NO_ERRORS && rename(temporaryPath, path) != 0) {
+        error = cacheError::FILE_WRITE_ERROR;
+    }
+
+    if (error != cacheError::NO_ERRORS) {
+        unlink(temporaryPath);
+
+        return error;
+    }
+
+    cache->statistics.stores++;
+
+    return cacheError::NO_ERRORS;
+}
+
+cacheError loadCacheFile(compilationCache *cache, const cacheKey *key, const char *kind, const char *fileName) {
+    customWarning(fileName, cacheError::BAD_POINTER);
+
+    Buffer<char> content = {};
+
+    if (bufferInitialize(&content) != bufferError::NO_BUFFER_ERROR) {
+        return cacheError::BUFFER_ERROR;
+    }
+
+    cacheError error = loadCacheEntry(cache, key, kind, &content);
+
+    if (error == cacheError::NO_ERRORS) {
+        int descriptor = open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        error = descriptor >= 0 ? writeDescriptor(descriptor, content.data, content.currentIndex) : cacheError::FILE_WRITE_ERROR;
+
+        if (descriptor >= 0 && close(descriptor) != 0) {
+            error = cacheError::FILE_WRITE_ERROR;
+        }
+    }
+
+    bufferDestruct(&content);
+
+    return error;
+}
+
+cacheError storeCacheFile(compilationCache *cache, const cacheKey *key, const char *kind, const char *fileName) {
+    customWarning(fileName, cacheError::BAD_POINTER);
+
+    Buffer<char> content = {};
+
+    if (bufferInitialize(&content) != bufferError::NO_BUFFER_ERROR) {
+        return cacheError::BUFFER_ERROR;
+    }
+
+    int        descriptor = open(fileName, O_RDONLY);
+    cacheError error      = descriptor >= 0 ? readDescriptor(descriptor, &content) : cacheError::FILE_READ_ERROR;
+
+    if (descriptor >= 0) {
+        close(descriptor);
+    }
+
+    if (error == cacheError::NO_ERRORS) {
+        error = storeCacheEntry(cache, key, kind, content.data, content.currentIndex);
+    }
+
+    bufferDestruct(&content);
+
+    return error;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// every part is null-terminated so no two different inputs hash the same bytes
+static void startCacheKey(contentHash *hash, const char *stage, const char *options) {
+    initializeContentHash(hash);
+
+    updateContentHash(hash, COMPILER_VERSION, sizeof(COMPILER_VERSION));
+    updateContentHash(hash, stage,            strlen(stage)   + 1);
+    updateContentHash(hash, options,          strlen(options) + 1);
+}
+
+static void finishCacheKey(contentHash *hash, cacheKey *key) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+
+    unsigned char digest[CONTENT_HASH_SIZE] = {};
+    finishContentHash(hash, digest);
+
+    for (size_t byteIndex = 0; byteIndex < CONTENT_HASH_SIZE; byteIndex++) {
+        key->name[byteIndex * 2]     = HEX_DIGITS[digest[byteIndex] >> 4];
+        key->name[byteIndex * 2 + 1] = HEX_DIGITS[digest[byteIndex] & 0xF];
+    }
+
+    key->name[CACHE_KEY_LENGTH] = '\0';
+}
+
+static bool getEntryPath(char *path, const compilationCache *cache, const char *name) {
+    int length = snprintf(path, PATH_MAX, "%s/%s", cache->directory, name);
+
+    return length > 0 && length < PATH_MAX;
+}
+
+// <key>.<kind>, the statistics and temporary files are never evicted as entries
+static bool isCacheEntryName(const char *name) {
+    for (size_t charIndex = 0; charIndex < CACHE_KEY_LENGTH; charIndex++) {
+        if (name[charIndex] == '\0' || !strchr("0123456789abcdef", name[charIndex])) {
+            return false;
+        }
+    }
+
+    const char *kind = name + CACHE_KEY_LENGTH;
+
+    return kind[0] == '.' && (strcmp(kind + 1, CACHE_AST_KIND) == 0 || strcmp(kind + 1, CACHE_ASM_KIND) == 0 ||
+                              strcmp(kind + 1, CACHE_FUNCTION_KIND) == 0);
+}
+
+static bool isTemporaryName(const char *name) {
+    const char *kind = strrchr(name, '.');
+
+    return kind && strcmp(kind + 1, CACHE_TEMPORARY_KIND) == 0;
+}
+
+static int compareEntriesByUse(const void *first, const void *second) {
+    time_t firstUse  = ((const cacheEntryInfo *) first)->lastUse;
+    time_t secondUse = ((const cacheEntryInfo *) second)->lastUse;
+
+    return (firstUse > secondUse) - (firstUse < secondUse);
+}
+
+static cacheError readDescriptor(int descriptor, Buffer<char> *content) {
+    char    chunk[CACHE_CHUNK_SIZE] = {};
+    ssize_t readCount               = 0;
+
+    content->currentIndex = 0;
+
+    while ((readCount = read(descriptor, chunk, sizeof(chunk))) > 0) {
+        if (writeDataToBuffer(content, chunk, (size_t) readCount) != bufferError::NO_BUFFER_ERROR) {
+            return cacheError::BUFFER_ERROR;
+        }
+    }
+
+    return readCount == 0 ? cacheError::NO_ERRORS : cacheError::FILE_READ_ERROR;
+}
+
+static cacheError writeDescriptor(int descriptor, const void *data, size_t size) {
+    const char *bytes = (const char *) data;
+
+    while (size > 0) {
+        ssize_t writeCount = write(descriptor, bytes, size);
+
+        if (writeCount < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (writeCount <= 0) {
+            return cacheError::FILE_WRITE_ERROR;
+        }
+
+        bytes += writeCount;
+        size  -= (size_t) writeCount;
+    }
+
+    return cacheError::NO_ERRORS;
+}
+
+// oldest uses go first until the entries fit, a file another compile removed already is simply skipped
+static cacheError trimCompilationCache(compilationCache *cache) {
+    DIR *directory = opendir(cache->directory);
+    customWarning(directory, cacheError::DIRECTORY_ERROR);
+
+    Buffer<cacheEntryInfo> entries = {};
+
+    if (bufferInitialize(&entries) != bufferError::NO_BUFFER_ERROR) {
+        closedir(directory);
+
+        return cacheError::BUFFER_ERROR;
+    }
+
+    cacheError     error     = cacheError::NO_ERRORS;
+    size_t         totalSize = 0;
+    time_t         now       = time(NULL);
+    struct dirent *entry     = NULL;
+
+    while ((entry = readdir(directory)) != NULL && error == cacheError::NO_ERRORS) {
+        bool isEntry     = isCacheEntryName(entry->d_name);
+        bool isTemporary = !isEntry && isTemporaryName(entry->d_name);
+
+        char        path[PATH_MAX] = {};
+        struct stat entryStat      = {};
+
+        if ((!isEntry && !isTemporary) || !getEntryPath(path, cache, entry->d_name) || stat(path, &entryStat) != 0) {
+            continue;
+        }
+
+        if (isTemporary) {
+            if (now - entryStat.st_mtime > CACHE_STALE_SECONDS) {
+                unlink(path);
+            }
+
+            continue;
+        }
+
+        cacheEntryInfo info = {};
+
+        strncpy(info.name, entry->d_name, NAME_MAX);
+        info.size    = (size_t) entryStat.st_size;
+        info.lastUse = entryStat.st_mtime;
+
+        totalSize += info.size;
+
+        if (writeDataToBuffer(&entries, &info, 1) != bufferError::NO_BUFFER_ERROR) {
+            error = cacheError::BUFFER_ERROR;
+        }
+    }
+
+    closedir(directory);
+
+    if (error == cacheError::NO_ERRORS && totalSize > cache->capacity) {
+        qsort(entries.data, entries.currentIndex, sizeof(cacheEntryInfo), compareEntriesByUse);
+
+        for (size_t entryIndex = 0; entryIndex < entries.currentIndex && totalSize > cache->capacity; entryIndex++) {
+            char path[PATH_MAX] = {};
+
+            if (getEntryPath(path, cache, entries.data[entryIndex].name) && unlink(path) == 0) {
+                cache->statistics.evictions++;
+            }
+
+            totalSize -= entries.data[entryIndex].size;
+        }
+    }
+
+    bufferDestruct(&entries);
+
+    return error;
+}
+
+static void parseCacheStatistics(const char *text, cacheStatistics *statistics) {
+    *statistics = {};
+
+    sscanf(text, "hits %" SCNu64 " misses %" SCNu64 " stores %" SCNu64 " evictions %" SCNu64,
+           &statistics->hits, &statistics->misses, &statistics->stores, &statistics->evictions);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
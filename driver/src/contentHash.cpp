@@ -0,0 +1,141 @@
+#include <cstring>
+
+#include "contentHash.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const uint32_t ROUND_CONSTANTS[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t INITIAL_STATE[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static inline uint32_t rotateRight(uint32_t value, int shift) {
+    return (value >> shift) | (value << (32 - shift));
+}
+
+static void compressBlock(contentHash *hash, const unsigned char *block);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+void initializeContentHash(contentHash *hash) {
+    *hash = {};
+
+    memcpy(hash->state, INITIAL_STATE, sizeof(INITIAL_STATE));
+}
+
+void updateContentHash(contentHash *hash, const void *data, size_t size) {
+    const unsigned char *bytes = (const unsigned char *) data;
+
+    hash->length += size;
+
+    if (hash->blockSize > 0) {
+        size_t copied = CONTENT_HASH_BLOCK_SIZE - hash->blockSize < size ? CONTENT_HASH_BLOCK_SIZE - hash->blockSize : size;
+
+        memcpy(hash->block + hash->blockSize, bytes, copied);
+
+        hash->blockSize += copied;
+        bytes           += copied;
+        size            -= copied;
+
+        if (hash->blockSize < CONTENT_HASH_BLOCK_SIZE) {
+            return;
+        }
+
+        compressBlock(hash, hash->block);
+        hash->blockSize = 0;
+    }
+
+    // whole blocks are hashed straight from data
+    for (; size >= CONTENT_HASH_BLOCK_SIZE; bytes += CONTENT_HASH_BLOCK_SIZE, size -= CONTENT_HASH_BLOCK_SIZE) {
+        compressBlock(hash, bytes);
+    }
+
+    memcpy(hash->block, bytes, size);
+    hash->blockSize = size;
+}
+
+void finishContentHash(contentHash *hash, unsigned char digest[CONTENT_HASH_SIZE]) {
+    uint64_t bitsCount = hash->length * 8;
+
+    hash->block[hash->blockSize++] = 0x80;
+
+    if (hash->blockSize > CONTENT_HASH_BLOCK_SIZE - sizeof(bitsCount)) {
+        memset(hash->block + hash->blockSize, 0, CONTENT_HASH_BLOCK_SIZE - hash->blockSize);
+        compressBlock(hash, hash->block);
+        hash->blockSize = 0;
+    }
+
+    memset(hash->block + hash->blockSize, 0, CONTENT_HASH_BLOCK_SIZE - sizeof(bitsCount) - hash->blockSize);
+
+    for (size_t byteIndex = 0; byteIndex < sizeof(bitsCount); byteIndex++) {
+        hash->block[CONTENT_HASH_BLOCK_SIZE - 1 - byteIndex] = (unsigned char) (bitsCount >> (8 * byteIndex));
+    }
+
+    compressBlock(hash, hash->block);
+
+    for (size_t wordIndex = 0; wordIndex < 8; wordIndex++) {
+        for (size_t byteIndex = 0; byteIndex < 4; byteIndex++) {
+            digest[wordIndex * 4 + byteIndex] = (unsigned char) (hash->state[wordIndex] >> (24 - 8 * byteIndex));
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static void compressBlock(contentHash *hash, const unsigned char *block) {
+    uint32_t schedule[64] = {};
+
+    for (size_t wordIndex = 0; wordIndex < 16; wordIndex++) {
+        schedule[wordIndex] = (uint32_t) block[wordIndex * 4]     << 24 | (uint32_t) block[wordIndex * 4 + 1] << 16 |
+                              (uint32_t) block[wordIndex * 4 + 2] <<  8 | (uint32_t) block[wordIndex * 4 + 3];
+    }
+
+    for (size_t wordIndex = 16; wordIndex < 64; wordIndex++) {
+        uint32_t first  = schedule[wordIndex - 15];
+        uint32_t second = schedule[wordIndex - 2];
+
+        schedule[wordIndex] = schedule[wordIndex - 16] + (rotateRight(first, 7) ^ rotateRight(first, 18) ^ (first >> 3)) +
+                              schedule[wordIndex - 7]  + (rotateRight(second, 17) ^ rotateRight(second, 19) ^ (second >> 10));
+    }
+
+    uint32_t a = hash->state[0], b = hash->state[1], c = hash->state[2], d = hash->state[3];
+    uint32_t e = hash->state[4], f = hash->state[5], g = hash->state[6], h = hash->state[7];
+
+    for (size_t round = 0; round < 64; round++) {
+        uint32_t first  = h + (rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25)) + ((e & f) ^ (~e & g)) +
+                          ROUND_CONSTANTS[round] + schedule[round];
+        uint32_t second = (rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + first;
+        d = c;
+        c = b;
+        b = a;
+        a = first + second;
+    }
+
+    hash->state[0] += a;
+    hash->state[1] += b;
+    hash->state[2] += c;
+    hash->state[3] += d;
+    hash->state[4] += e;
+    hash->state[5] += f;
+    hash->state[6] += g;
+    hash->state[7] += h;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -0,0 +1,175 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "compilerStages.h"
+#include "core.h"
+#include "lexer.h"
+#include "parser.h"
+#include "treeSaver.h"
+#include "binaryAST.h"
+#include "sourceInput.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static bool printSyntaxErrors(compilationContext *context);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+driverError openSourceFile(const driverOptions *options, sourceInput **source) {
+    customWarning(options, driverError::BAD_ARGUMENTS);
+    customWarning(source,  driverError::BAD_ARGUMENTS);
+
+    *source = (sourceInput *)calloc(1, sizeof(sourceInput));
+    customWarning(*source, driverError::SOURCE_ERROR);
+
+    if (openSourceInput(*source, options->sourceFileName) != sourceInputError::NO_ERRORS) {
+        fprintf(stderr, "can't open source file \"%s\"\n", options->sourceFileName);
+        FREE_(*source);
+
+        return driverError::SOURCE_ERROR;
+    }
+
+    return driverError::NO_ERRORS;
+}
+
+driverError closeSourceFile(sourceInput **source) {
+    customWarning(source, driverError::BAD_ARGUMENTS);
+
+    if (*source) {
+        closeSourceInput(*source);
+        FREE_(*source);
+    }
+
+    return driverError::NO_ERRORS;
+}
+
+// a mapped file is there as a whole already, the lexer then reads a stream from what is buffered here
+driverError getSourceBytes(sourceInput *source, const char **data, size_t *size) {
+    customWarning(source, driverError::BAD_ARGUMENTS);
+    customWarning(data,   driverError::BAD_ARGUMENTS);
+    customWarning(size,   driverError::BAD_ARGUMENTS);
+
+    while (!source->isComplete) {
+        if (readSourceChunk(source) != sourceInputError::NO_ERRORS) {
+            return driverError::SOURCE_ERROR;
+        }
+    }
+
+    *data = source->data;
+    *size = source->size;
+
+    return driverError::NO_ERRORS;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+driverError runFrontEnd(const driverOptions *options, sourceInput *source, compilationContext **context, astHandoff *handoff) {
+    customWarning(options, driverError::BAD_ARGUMENTS);
+    customWarning(source,  driverError::BAD_ARGUMENTS);
+    customWarning(context, driverError::BAD_ARGUMENTS);
+    customWarning(handoff, driverError::BAD_ARGUMENTS);
+
+    *context = (compilationContext *)calloc(1, sizeof(compilationContext));
+    customWarning(*context, driverError::FRONT_END_ERROR);
+
+    // a context that failed halfway has nothing destroyCompilationContext could walk safely, as in lexicalAnalysisParallel
+    if (initializeCompilationContext(*context, source) != compilationError::NO_ERRORS) {
+        FREE_(*context);
+
+        return driverError::FRONT_END_ERROR;
+    }
+
+    driverError error = driverError::NO_ERRORS;
+
+    if (options->shareExpressions && enableExpressionSharing(*context) != compilationError::NO_ERRORS) {
+        error = driverError::FRONT_END_ERROR;
+    }
+
+    if (error == driverError::NO_ERRORS &&
+        (lexicalAnalysisParallel(*context, 0) != compilationError::NO_ERRORS ||
+         parseCode(*context)                  != compilationError::NO_ERRORS)) {
+        error = driverError::FRONT_END_ERROR;
+    }
+
+    // a syntax error is only in errorBuffer, parseCode still returns the declarations before it
+    if (printSyntaxErrors(*context) ||
+        (error == driverError::NO_ERRORS && (!(*context)->AST->root || getASTHandoff(*context, handoff) != compilationError::NO_ERRORS))) {
+        error = driverError::FRONT_END_ERROR;
+    }
+
+    if (error != driverError::NO_ERRORS) {
+        closeFrontEnd(context);
+    }
+
+    return error;
+}
+
+driverError closeFrontEnd(compilationContext **context) {
+    customWarning(context, driverError::BAD_ARGUMENTS);
+
+    if (*context) {
+        destroyCompilationContext(*context);
+        FREE_(*context);
+    }
+
+    return driverError::NO_ERRORS;
+}
+
+driverError buildASTImage(compilationContext *context, Buffer<char> *image) {
+    customWarning(context, driverError::BAD_ARGUMENTS);
+    customWarning(image,   driverError::BAD_ARGUMENTS);
+
+    return buildBinaryAST(context, image) == saveDataError::NO_ERRORS ? driverError::NO_ERRORS : driverError::FRONT_END_ERROR;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// an image from the cache went through the disk, it is checked before the back-end trusts it
+driverError checkASTImage(const Buffer<char> *image) {
+    customWarning(image, driverError::BAD_ARGUMENTS);
+
+    binaryAST ast = {};
+
+    return viewBinaryAST(&ast, image->data, image->currentIndex) == binaryASTError::NO_ERRORS ? driverError::NO_ERRORS
+                                                                                               : driverError::SOURCE_ERROR;
+}
+
+// the same file saveBinaryAST writes, an image taken from the cache is saved like a fresh one
+driverError saveASTImage(const Buffer<char> *image) {
+    customWarning(image, driverError::BAD_ARGUMENTS);
+
+    char *fileName = getFileName();
+    customWarning(fileName, driverError::OUTPUT_ERROR);
+
+    strcat(fileName, BINARY_AST_EXTENSION);
+
+    FILE *file = fopen(fileName, "wb");
+
+    FREE_(fileName);
+
+    customWarning(file, driverError::OUTPUT_ERROR);
+
+    size_t written = fwrite(image->data, sizeof(char), image->currentIndex, file);
+
+    if (fclose(file) != 0 || written != image->currentIndex) {
+        return driverError::OUTPUT_ERROR;
+    }
+
+    return driverError::NO_ERRORS;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static bool printSyntaxErrors(compilationContext *context) {
+    Buffer<errorData> *errors = context->errorBuffer;
+
+    for (size_t errorIndex = 0; errorIndex < errors->currentIndex; errorIndex++) {
+        fprintf(stderr, "%s:%d: syntax error %lld\n", errors->data[errorIndex].file ? errors->data[errorIndex].file : "-",
+                        errors->data[errorIndex].line, (long long) errors->data[errorIndex].error);
+    }
+
+    return errors->currentIndex != 0;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
\ No newline at end of file
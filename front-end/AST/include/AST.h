@@ -28,7 +28,8 @@ union nodeData {
 struct astNode {
     nodeType type  = nodeType::CONSTANT;
     nodeData data  = {.number = POISON_VALUE};
-    int      line  = 0;
+    int      line  = 0;      // counted from the first line of its top-level declaration
+    unsigned references = 0; // parents of an expression interned in expressionTable, 0 when it is not interned
     char    *file  = NULL;
 
     size_t   localTableOtherElementsCount = 0;
@@ -37,12 +38,21 @@ struct astNode {
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
+// the parent of an expression the parser has just linked, an expression with more than one reference keeps none
+inline void linkExpression(node<astNode> *expression, node<astNode> *parent) {
+    if (expression) {
+        expression->parent = expression->data.references > 1 ? NULL : parent;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
 #define _CONST_(NUMBER)                                 \
-    emplaceNode(node<astNode>                           \
+    emplaceNode(context->AST, node<astNode>             \
         {.data =                                        \
             {.type = nodeType::CONSTANT,                \
              .data = {.number = NUMBER},                \
-             .line = context->currentLine               \
+             .line = getNodeLine(context)               \
             },                                          \
         .left   = NULL,                                 \
         .right  = NULL,                                 \
@@ -51,11 +61,11 @@ struct astNode {
     )
 
 #define _NAME_(INDEX)                                   \
-    emplaceNode(node<astNode>                           \
+    emplaceNode(context->AST, node<astNode>             \
         {.data =                                        \
             {.type = nodeType::STRING,                  \
              .data = {.nameTableIndex = INDEX},         \
-             .line = context->currentLine               \
+             .line = getNodeLine(context)               \
             },                                          \
         .left   = NULL,                                 \
         .right  = NULL,                                 \
@@ -64,11 +74,11 @@ struct astNode {
     )
 
 #define _FUNCTION_DEFINITION_(LEFT, RIGHT, ID_INDEX)    \
-    emplaceNode(node<astNode>                           \
+    emplaceNode(context->AST, node<astNode>             \
         {.data =                                        \
             {.type = nodeType::FUNCTION_DEFINITION,     \
              .data = {.nameTableIndex = ID_INDEX},      \
-             .line = context->currentLine               \
+             .line = getNodeLine(context)               \
             },                                          \
         .left   = LEFT,                                 \
         .right  = RIGHT,                                \
@@ -77,11 +87,11 @@ struct astNode {
     )
 
 #define _VARIABLE_DECLARATION_(LEFT, RIGHT, ID_INDEX)   \
-    emplaceNode(node<astNode>                           \
+    emplaceNode(context->AST, node<astNode>             \
         {.data =                                        \
             {.type = nodeType::VARIABLE_DECLARATION,    \
              .data = {.nameTableIndex = ID_INDEX},      \
-             .line = context->currentLine               \
+             .line = getNodeLine(context)               \
             },                                          \
         .left   = LEFT,                                 \
         .right  = RIGHT,                                \
@@ -90,7 +100,7 @@ struct astNode {
     )
 
 #define _PARAMETERS_(LEFT, RIGHT)                       \
-    emplaceNode(node<astNode>                           \
+    emplaceNode(context->AST, node<astNode>             \
         {.data =                                        \
             {.type = nodeType::PARAMETERS},             \
         .left   = LEFT,                                 \
@@ -100,7 +110,7 @@ struct astNode {
     )
 
 #define _FUNCTION_CALL_(LEFT, RIGHT)                    \
-    emplaceNode(node<astNode>                           \
+    emplaceNode(context->AST, node<astNode>             \
         {.data =                                        \
             {.type = nodeType::FUNCTION_CALL},          \
         .left   = LEFT,                                 \
@@ -110,7 +120,7 @@ struct astNode {
     )
 
 #define _TERMINATOR_()                                  \
-    emplaceNode(node<astNode>                           \
+    emplaceNode(context->AST, node<astNode>             \
         {.data =                                        \
             {.type = nodeType::TERMINATOR},             \
         .left   = NULL,                                 \
@@ -129,7 +139,7 @@ struct astNode {
     do {                                                \
         SEPARATOR->left   = LEFT;                       \
         SEPARATOR->right  = RIGHT;                      \
-        if (LEFT) LEFT->parent = SEPARATOR;             \
+        linkExpression(LEFT, SEPARATOR);                \
         if (RIGHT) RIGHT->parent = SEPARATOR;           \
     } while (0)
 
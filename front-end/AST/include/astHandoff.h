@@ -0,0 +1,75 @@
+#ifndef AST_HANDOFF_H_
+#define AST_HANDOFF_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "AST.h"
+#include "astVisitor.h"
+#include "binaryAST.h"
+#include "nameTable.h"
+#include "buffer.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// a parsed source as the front-end leaves it, for the back-end to take without an image in between.
+// only types both of them know are in here, so neither has to see the core.h of the other.
+// everything is still owned by the front-end and has to outlive whoever reads it
+struct astHandoff {
+    binaryTree<astNode>      *AST           = NULL; // a shared expression may have several parents
+    Buffer<nameTableElement> *nameTable     = NULL; // keywords first, then identifiers
+    Buffer<localNameTable>   *localTables   = NULL;
+
+    size_t                    keywordsCount = 0;
+    size_t                    entryPoint    = 0;    // counted with the keywords, as in nameTable
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// separators become keyword nodes, names are numbered from the first identifier on:
+// the text and binary formats write what this gives, and the back-end builds its nodes from it
+struct astNodeEncoder : astVisitor<astNodeEncoder, binaryASTNode> {
+    Buffer<nameTableElement> *nameTable     = NULL;
+    size_t                    keywordsCount = 0;
+
+    Keyword getNodeKeyword(node<astNode> *currentNode) {
+        if (currentNode->data.type == nodeType::STRING) {
+            return nameTable->data[currentNode->data.data.nameTableIndex].keyword;
+        }
+
+        return astVisitor::getNodeKeyword(currentNode);
+    }
+
+    binaryASTNode encodeNode(nodeType type, int64_t payload) {
+        binaryASTNode record = {};
+
+        record.type    = (uint32_t) type;
+        record.payload = payload;
+
+        return record;
+    }
+
+    binaryASTNode encodeNamedNode(node<astNode> *currentNode) {
+        return encodeNode(currentNode->data.type, (int64_t) (currentNode->data.data.nameTableIndex - keywordsCount));
+    }
+
+    binaryASTNode visitNode(node<astNode> *currentNode) {
+        return encodeNode(currentNode->data.type, 0);
+    }
+
+    binaryASTNode visitConstant(node<astNode> *currentNode) {
+        return encodeNode(nodeType::CONSTANT, currentNode->data.data.number);
+    }
+
+    binaryASTNode visitKeyword(node<astNode> *currentNode, Keyword keyword) {
+        return encodeNode(nodeType::KEYWORD, (int64_t) keyword);
+    }
+
+    binaryASTNode visitString             (node<astNode> *currentNode) { return encodeNamedNode(currentNode); }
+    binaryASTNode visitFunctionDefinition (node<astNode> *currentNode) { return encodeNamedNode(currentNode); }
+    binaryASTNode visitVariableDeclaration(node<astNode> *currentNode) { return encodeNamedNode(currentNode); }
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // AST_HANDOFF_H_
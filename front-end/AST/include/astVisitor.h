@@ -0,0 +1,190 @@
+#ifndef AST_VISITOR_H_
+#define AST_VISITOR_H_
+
+#include <cstddef>
+
+#include "AST.h"
+#include "compactAST.h"
+#include "keywordTable.h"
+#include "binaryTree.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static constexpr size_t NODE_TYPES_COUNT    = (size_t) nodeType::FUNCTION_CALL + 1;     // FUNCTION_CALL is the last node type
+static constexpr size_t VISITOR_SLOTS_COUNT = NODE_TYPES_COUNT + KEYWORD_NUMBERS_COUNT; // node types first, then keyword numbers
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// the two layouts a pass may walk: the tree the parser links and the flat one the back-end reads into
+inline nodeType getVisitedType(node<astNode> *currentNode) { return currentNode->data.type; }
+inline nodeType getVisitedType(compactNode   *currentNode) { return currentNode->type;      }
+
+inline nodeData getVisitedData(node<astNode> *currentNode) { return currentNode->data.data; }
+inline nodeData getVisitedData(compactNode   *currentNode) { return currentNode->data;      }
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// a pass derives from astVisitor<pass, result, extra arguments> over node<astNode> *, or from compactVisitor over compactNode *,
+// and defines only the handlers it needs:
+//     visitTerminator, visitConstant, visitString, visitFunctionDefinition, visitParameters, visitVariableDeclaration,
+//     visitFunctionCall and visit<NAME> for every keyword of keywords.def.
+// a keyword handler that is not defined falls back to visitKeyword, every other one to visitNode.
+// handlers are looked up by name at compile time, so nothing here is virtual.
+template <typename Pass, typename NodeRef, typename Result, typename... Args>
+struct visitorThunks {
+    static Result visitTerminator         (Pass *pass, NodeRef currentNode, Args... args) { return pass->visitTerminator         (currentNode, args...); }
+    static Result visitConstant           (Pass *pass, NodeRef currentNode, Args... args) { return pass->visitConstant           (currentNode, args...); }
+    static Result visitString             (Pass *pass, NodeRef currentNode, Args... args) { return pass->visitString             (currentNode, args...); }
+    static Result visitFunctionDefinition (Pass *pass, NodeRef currentNode, Args... args) { return pass->visitFunctionDefinition (currentNode, args...); }
+    static Result visitParameters         (Pass *pass, NodeRef currentNode, Args... args) { return pass->visitParameters         (currentNode, args...); }
+    static Result visitVariableDeclaration(Pass *pass, NodeRef currentNode, Args... args) { return pass->visitVariableDeclaration(currentNode, args...); }
+    static Result visitFunctionCall       (Pass *pass, NodeRef currentNode, Args... args) { return pass->visitFunctionCall       (currentNode, args...); }
+
+    // a keyword node without a keyword, or with a number keywords.def does not use
+    static Result visitUnknownKeyword(Pass *pass, NodeRef currentNode, Args... args) {
+        return pass->visitKeyword(currentNode, pass->getNodeKeyword(currentNode), args...);
+    }
+
+    #define KEYWORD(NAME, ...)                                                          \
+        static Result visit##NAME(Pass *pass, NodeRef currentNode, Args... args) {      \
+            return pass->visit##NAME(currentNode, args...);                             \
+        }
+
+    #include "keywords.def"
+
+    #undef KEYWORD
+};
+
+template <typename Pass, typename NodeRef, typename Result, typename... Args>
+struct visitorTable {
+    Result (*handlers[VISITOR_SLOTS_COUNT])(Pass *pass, NodeRef currentNode, Args... args) = {};
+};
+
+template <typename Pass, typename NodeRef, typename Result, typename... Args>
+constexpr visitorTable<Pass, NodeRef, Result, Args...> buildVisitorTable() {
+    typedef visitorThunks<Pass, NodeRef, Result, Args...> thunks;
+
+    visitorTable<Pass, NodeRef, Result, Args...> table = {};
+
+    for (size_t slot = 0; slot < VISITOR_SLOTS_COUNT; slot++) {
+        table.handlers[slot] = &thunks::visitUnknownKeyword;
+    }
+
+    table.handlers[(size_t) nodeType::TERMINATOR]           = &thunks::visitTerminator;
+    table.handlers[(size_t) nodeType::CONSTANT]             = &thunks::visitConstant;
+    table.handlers[(size_t) nodeType::STRING]               = &thunks::visitString;
+    table.handlers[(size_t) nodeType::FUNCTION_DEFINITION]  = &thunks::visitFunctionDefinition;
+    table.handlers[(size_t) nodeType::PARAMETERS]           = &thunks::visitParameters;
+    table.handlers[(size_t) nodeType::VARIABLE_DECLARATION] = &thunks::visitVariableDeclaration;
+    table.handlers[(size_t) nodeType::FUNCTION_CALL]        = &thunks::visitFunctionCall;
+
+    #define KEYWORD(NAME, NUMBER, ...) table.handlers[NODE_TYPES_COUNT + NUMBER] = &thunks::visit##NAME;
+
+    #include "keywords.def"
+
+    #undef KEYWORD
+
+    return table;
+}
+
+template <typename Pass, typename NodeRef, typename Result, typename... Args>
+inline constexpr visitorTable<Pass, NodeRef, Result, Args...> VISITOR_TABLE = buildVisitorTable<Pass, NodeRef, Result, Args...>();
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+template <typename Pass, typename NodeRef, typename Result, typename... Args>
+struct nodeVisitor {
+    // currentNode must not be NULL, a node that fits no slot goes to visitNode
+    Result visit(NodeRef currentNode, Args... args) {
+        Pass   *pass    = static_cast<Pass *>(this);
+        Keyword keyword = pass->getNodeKeyword(currentNode);
+        size_t  slot    = keyword == Keyword::UNDEFINED ? (size_t) getVisitedType(currentNode) : NODE_TYPES_COUNT + (size_t) keyword;
+
+        if (slot >= VISITOR_SLOTS_COUNT) {
+            return pass->visitNode(currentNode, args...);
+        }
+
+        return VISITOR_TABLE<Pass, NodeRef, Result, Args...>.handlers[slot](pass, currentNode, args...);
+    }
+
+    // the back-end keeps keywords in keyword nodes, the front-end passes that need them look separators up in the name table
+    Keyword getNodeKeyword(NodeRef currentNode) {
+        return getVisitedType(currentNode) == nodeType::KEYWORD ? getVisitedData(currentNode).keyword : Keyword::UNDEFINED;
+    }
+
+    Result visitNode(NodeRef currentNode, Args... args) {
+        return Result();
+    }
+
+    Result visitKeyword(NodeRef currentNode, Keyword keyword, Args... args) {
+        return static_cast<Pass *>(this)->visitNode(currentNode, args...);
+    }
+
+    #define NODE_HANDLER(NAME)                                                          \
+        Result NAME(NodeRef currentNode, Args... args) {                                \
+            return static_cast<Pass *>(this)->visitNode(currentNode, args...);          \
+        }
+
+    NODE_HANDLER(visitTerminator)
+    NODE_HANDLER(visitConstant)
+    NODE_HANDLER(visitString)
+    NODE_HANDLER(visitFunctionDefinition)
+    NODE_HANDLER(visitParameters)
+    NODE_HANDLER(visitVariableDeclaration)
+    NODE_HANDLER(visitFunctionCall)
+
+    #undef NODE_HANDLER
+
+    #define KEYWORD(NAME, ...)                                                          \
+        Result visit##NAME(NodeRef currentNode, Args... args) {                         \
+            return static_cast<Pass *>(this)->visitKeyword(currentNode, Keyword::NAME, args...); \
+        }
+
+    #include "keywords.def"
+
+    #undef KEYWORD
+};
+
+template <typename Pass, typename Result, typename... Args>
+struct astVisitor : nodeVisitor<Pass, node<astNode> *, Result, Args...> {};
+
+// the tree is not handed to the handlers, a pass keeps the compactAST it follows the handles in
+template <typename Pass, typename Result, typename... Args>
+struct compactVisitor : nodeVisitor<Pass, compactNode *, Result, Args...> {};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// several passes over one walk, each node is handed to them in the order they are listed
+template <typename... Passes>
+binaryTreeError visitAST(node<astNode> *root, printType order, Passes *...passes) {
+    treeIterator<astNode> iterator = {};
+    treeIteratorInitialize(&iterator, root, order);
+
+    while (node<astNode> *currentNode = treeIteratorNext(&iterator)) {
+        (passes->visit(currentNode), ...);
+    }
+
+    binaryTreeError error = iterator.error;
+    treeIteratorDestruct(&iterator);
+
+    return error;
+}
+
+template <typename... Passes>
+bufferError visitCompactAST(compactAST *ast, astHandle root, printType order, Passes *...passes) {
+    compactIterator iterator = {};
+    compactIteratorInitialize(&iterator, ast, root, order);
+
+    while (compactNode *currentNode = compactIteratorNext(&iterator)) {
+        (passes->visit(currentNode), ...);
+    }
+
+    bufferError error = iterator.error;
+    compactIteratorDestruct(&iterator);
+
+    return error;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // AST_VISITOR_H_
@@ -0,0 +1,140 @@
+#ifndef BINARY_AST_H_
+#define BINARY_AST_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "AST.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// a node is addressed by its index in the nodes section
+typedef uint32_t astHandle;
+
+static const astHandle AST_NO_NODE   = UINT32_MAX;
+static const size_t    AST_MAX_NODES = UINT32_MAX; // the last handle is taken by AST_NO_NODE
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+enum class binaryASTError {
+    NO_ERRORS        = 0,
+    BAD_POINTER      = 1 << 0,
+    FILE_OPEN_ERROR  = 1 << 1,
+    FILE_READ_ERROR  = 1 << 2,
+    BAD_FORMAT       = 1 << 3,
+    BAD_VERSION      = 1 << 4
+};
+
+static const char     BINARY_AST_MAGIC[4]    = {'P', 'A', 'S', 'T'};
+static const uint32_t BINARY_AST_VERSION     = 3;
+static const size_t   BINARY_AST_ALIGNMENT   = 8;
+static const char     BINARY_AST_EXTENSION[] = ".bin";
+
+// offsets are counted from the start of the file, every section starts on BINARY_AST_ALIGNMENT.
+// the function directory comes first, right after the header
+struct binaryASTHeader {
+    char     magic[4]            = {};
+    uint32_t version             = 0;
+
+    uint32_t root                = AST_NO_NODE;
+    uint32_t nodesCount          = 0;
+    uint32_t namesCount          = 0;
+    uint32_t localTablesCount    = 0;
+    uint32_t localElementsCount  = 0;
+    uint32_t stringsSize         = 0;
+    uint32_t functionsCount      = 0;
+    uint32_t entryPoint          = 0; // name index of the function the program starts in
+
+    uint64_t functionsOffset     = 0;
+    uint64_t nodesOffset         = 0;
+    uint64_t namesOffset         = 0;
+    uint64_t localTablesOffset   = 0;
+    uint64_t localElementsOffset = 0;
+    uint64_t stringsOffset       = 0;
+};
+
+// the same node the text format writes: separators are keyword nodes, names are counted from the first identifier.
+// nodes are stored in preorder, so a parent always comes before its children
+struct binaryASTNode {
+    int64_t   payload = 0;      // constant, keyword number or name index, unused by the types without one
+    uint32_t  type    = 0;
+    astHandle left    = AST_NO_NODE;
+    astHandle right   = AST_NO_NODE;
+    astHandle parent  = AST_NO_NODE;
+};
+
+// a function definition hanging off the top-level separator chain: its subtree is the run of size bytes of nodes
+// at offset, and no node outside it links into it, so it can be decoded on its own or not at all.
+// entries are in file order
+struct binaryASTFunction {
+    uint32_t nameIndex = 0;     // the payload of its FUNCTION_DEFINITION node
+    uint32_t reserved  = 0;
+    uint64_t offset    = 0;
+    uint64_t size      = 0;
+};
+
+// a name of the global table, strings holds it null-terminated
+struct binaryASTName {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+struct binaryASTLocalTable {
+    int32_t  nameTableID   = 0;
+    uint32_t firstElement  = 0; // index in the local elements section
+    uint32_t elementsCount = 0;
+};
+
+struct binaryASTLocalElement {
+    uint32_t globalNameID = 0;
+    uint32_t type         = 0;
+};
+
+// a read-only view of a mapped file or of an image in memory, every pointer goes into data
+struct binaryAST {
+    const binaryASTHeader       *header        = NULL;
+    const binaryASTFunction     *functions     = NULL;
+    const binaryASTNode         *nodes         = NULL;
+    const binaryASTName         *names         = NULL;
+    const binaryASTLocalTable   *localTables   = NULL;
+    const binaryASTLocalElement *localElements = NULL;
+    const char                  *strings       = NULL;
+
+    const void                  *data          = NULL;
+    size_t                       size          = 0;
+    bool                         isMapped      = false; // data is unmapped by unmapBinaryAST, an image is left to its owner
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// both check every section and every link once, nothing is parsed
+binaryASTError mapBinaryAST  (binaryAST *ast, const char *fileName);
+binaryASTError viewBinaryAST (binaryAST *ast, const void *data, size_t size);
+binaryASTError unmapBinaryAST(binaryAST *ast);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// the text format writes no payload for these
+inline bool hasNodePayload(nodeType type) {
+    return type != nodeType::TERMINATOR && type != nodeType::PARAMETERS && type != nodeType::FUNCTION_CALL;
+}
+
+inline const binaryASTNode *getBinaryNode(const binaryAST *ast, astHandle handle) {
+    return handle == AST_NO_NODE ? NULL : &ast->nodes[handle];
+}
+
+inline const char *getBinaryName(const binaryAST *ast, uint32_t nameIndex) {
+    return ast->strings + ast->names[nameIndex].offset;
+}
+
+inline uint32_t getFunctionFirstNode(const binaryAST *ast, const binaryASTFunction *function) {
+    return (uint32_t) ((function->offset - ast->header->nodesOffset) / sizeof(binaryASTNode));
+}
+
+inline uint32_t getFunctionNodesCount(const binaryASTFunction *function) {
+    return (uint32_t) (function->size / sizeof(binaryASTNode));
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // BINARY_AST_H_
@@ -0,0 +1,129 @@
+#ifndef COMPACT_AST_H_
+#define COMPACT_AST_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "AST.h"
+#include "buffer.h"
+#include "binaryAST.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const uint32_t AST_NO_FILE = UINT32_MAX;
+
+// what every walk reads, 24 bytes against 72 of a node<astNode>
+struct compactNode {
+    nodeData  data   = {.number = POISON_VALUE};
+    nodeType  type   = nodeType::CONSTANT;
+    astHandle left   = AST_NO_NODE;
+    astHandle right  = AST_NO_NODE;
+    astHandle parent = AST_NO_NODE;
+};
+
+// only diagnostics and dumps look here
+struct compactLocation {
+    int      line   = 0;
+    uint32_t fileID = AST_NO_FILE;
+};
+
+// filled by the back-end passes that need it, there are none until annotateCompactAST is called
+struct compactAnnotation {
+    int rbpOffset = 0;
+};
+
+// locations and annotations are parallel to nodes. the readers append nodes in preorder,
+// so a walk from the root goes through the array mostly forward
+struct compactAST {
+    Buffer<compactNode>       nodes       = {};
+    Buffer<compactLocation>   locations   = {};
+    Buffer<compactAnnotation> annotations = {};
+    Buffer<char *>            files       = {}; // interned copies, fileID indexes them
+
+    astHandle                 root        = AST_NO_NODE;
+};
+
+struct compactFrame {
+    astHandle current = AST_NO_NODE;
+    printType visit   = printType::PREFIX; // the next visit of current
+};
+
+// treeIterator over handles
+struct compactIterator {
+    compactAST          *ast    = NULL;
+    Buffer<compactFrame> frames = {};
+
+    printType            order  = printType::PREFIX;
+    bufferError          error  = bufferError::NO_BUFFER_ERROR;
+};
+
+// chainIterator over handles
+struct compactChainIterator {
+    compactAST  *ast                     = NULL;
+    compactNode *link                    = NULL; // the next link, or the node that ends the chain
+    bool       (*isLink)(compactNode *)  = NULL;
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError initializeCompactAST(compactAST *ast);
+bufferError destroyCompactAST   (compactAST *ast);
+
+// links the new node under parent, the buffers may move, so only the handle it gets is safe to keep
+bufferError appendCompactNode   (compactAST *ast, const compactNode *newNode, const compactLocation *location,
+                                 astHandle parent, bool isRight, astHandle *handle);
+// flattens the tree in preorder, a shared expression is copied for each of its parents
+bufferError buildCompactAST     (compactAST *ast, node<astNode> *root);
+
+bufferError annotateCompactAST  (compactAST *ast);
+bufferError internASTFile       (compactAST *ast, const char *fileName, uint32_t *fileID);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError  compactIteratorInitialize     (compactIterator *iterator, compactAST *ast, astHandle root, printType order);
+bufferError  compactIteratorDestruct       (compactIterator *iterator);
+compactNode *compactIteratorNext           (compactIterator *iterator);
+
+bufferError  compactChainIteratorInitialize(compactChainIterator *iterator, compactAST *ast, compactNode *chain,
+                                            bool (*isLink)(compactNode *));
+compactNode *compactChainIteratorNext      (compactChainIterator *iterator);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+inline compactNode *getCompactNode(compactAST *ast, astHandle handle) {
+    return handle == AST_NO_NODE ? NULL : &ast->nodes.data[handle];
+}
+
+inline astHandle getCompactHandle(compactAST *ast, const compactNode *currentNode) {
+    return currentNode ? (astHandle) (currentNode - ast->nodes.data) : AST_NO_NODE;
+}
+
+inline compactNode *getCompactLeft(compactAST *ast, const compactNode *currentNode) {
+    return getCompactNode(ast, currentNode->left);
+}
+
+inline compactNode *getCompactRight(compactAST *ast, const compactNode *currentNode) {
+    return getCompactNode(ast, currentNode->right);
+}
+
+inline compactNode *getCompactParent(compactAST *ast, const compactNode *currentNode) {
+    return getCompactNode(ast, currentNode->parent);
+}
+
+inline int getCompactLine(compactAST *ast, const compactNode *currentNode) {
+    return ast->locations.data[getCompactHandle(ast, currentNode)].line;
+}
+
+inline const char *getCompactFile(compactAST *ast, const compactNode *currentNode) {
+    uint32_t fileID = ast->locations.data[getCompactHandle(ast, currentNode)].fileID;
+
+    return fileID == AST_NO_FILE ? NULL : ast->files.data[fileID];
+}
+
+inline compactAnnotation *getCompactAnnotation(compactAST *ast, const compactNode *currentNode) {
+    return &ast->annotations.data[getCompactHandle(ast, currentNode)];
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // COMPACT_AST_H_
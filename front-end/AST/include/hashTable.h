@@ -0,0 +1,73 @@
+#ifndef HASH_TABLE_H_
+#define HASH_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "buffer.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const uint32_t FNV_OFFSET_BASIS            = 2166136261u;
+static const uint32_t FNV_PRIME                   = 16777619u;
+
+static const size_t   HASH_TABLE_INITIAL_CAPACITY = 16;          // must be a power of two
+static const size_t   HASH_REMOVED_VALUE          = (size_t) -1; // a slot given up by its value, probing goes on past it
+
+// the table only knows a value by its hash, what the value stands for and what makes two keys equal is up to its owner
+struct hashSlot {
+    uint32_t hash  = 0;
+    size_t   value = 0; // 0 marks an empty slot
+};
+
+// open addressing with linear probing over a power-of-two array of slots.
+// the slots double before an insertion would fill more than 3/4 of them: probe chains stay short,
+// and a probe always ends on an empty slot. a removed slot is reused by the next insertion probing past it
+// and dropped when the slots double
+struct hashTable {
+    hashSlot *slots    = NULL;
+    size_t    capacity = 0;
+    size_t    count    = 0; // removed slots included
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError initializeHashTable(hashTable *table, size_t capacity);
+bufferError destroyHashTable   (hashTable *table);
+bufferError clearHashTable     (hashTable *table);
+
+// the value must be neither 0 nor HASH_REMOVED_VALUE
+bufferError insertHashValue    (hashTable *table, uint32_t hash, size_t value);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// FNV-1a, the one hash every table of the compiler uses: start from FNV_OFFSET_BASIS and feed each part of a key in turn
+constexpr uint32_t hashBytes(uint32_t hash, const char *bytes, size_t size) {
+    for (size_t byteIndex = 0; byteIndex < size; byteIndex++) {
+        hash = (hash ^ (unsigned char) bytes[byteIndex]) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+template<typename T>
+inline uint32_t hashValue(uint32_t hash, const T &value) {
+    char bytes[sizeof(T)] = {};
+    memcpy(bytes, &value, sizeof(T));
+
+    return hashBytes(hash, bytes, sizeof(T));
+}
+
+// every probe goes for (slotIndex = getFirstHashSlot(...); slots[slotIndex].value; slotIndex = getNextHashSlot(...))
+inline size_t getFirstHashSlot(const hashTable *table, uint32_t hash) {
+    return hash & (table->capacity - 1);
+}
+
+inline size_t getNextHashSlot(const hashTable *table, size_t slotIndex) {
+    return (slotIndex + 1) & (table->capacity - 1);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // HASH_TABLE_H_
@@ -0,0 +1,159 @@
+#ifndef KEYWORD_TABLE_H_
+#define KEYWORD_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "nameTable.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// OPERATION_PRIORITIES in keywords.def, the parser turns them into binding powers
+static const unsigned NOT_AN_OPERATION         = 0;
+static const unsigned UNARY_OPERATION          = 1 << 1;
+static const unsigned MULTIPLICATIVE_OPERATION = 1 << 2;
+static const unsigned ADDITIVE_OPERATION       = 1 << 3;
+static const unsigned COMPARISON_OPERATION     = 1 << 4;
+static const unsigned LOGICAL_OPERATION        = 1 << 5;
+
+struct keywordInfo {
+    Keyword     keyword    = Keyword::UNDEFINED;
+    const char *lexeme     = NULL;
+    size_t      length     = 0;
+    nameType    type       = nameType::IDENTIFIER;
+    unsigned    priorities = NOT_AN_OPERATION;
+};
+
+// in keywords.def order, which is also the order initializeNameTable interns them in
+static constexpr keywordInfo KEYWORDS[] = {
+    #define KEYWORD(NAME, NUMBER, LEXEME, TYPE, PRIORITIES) {Keyword::NAME, LEXEME, sizeof(LEXEME) - 1, TYPE, PRIORITIES},
+
+    #include "keywords.def"
+
+    #undef KEYWORD
+};
+
+static constexpr size_t KEYWORDS_COUNT = sizeof(KEYWORDS) / sizeof(KEYWORDS[0]);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static constexpr size_t KEYWORD_NUMBERS_COUNT = 128; // every NUMBER in keywords.def is below it
+static constexpr size_t KEYWORD_HASH_SIZE     = 256; // power of two
+static constexpr size_t KEYWORD_NO_INDEX      = (size_t) -1;
+
+constexpr size_t getMaxKeywordLength() {
+    size_t maxLength = 0;
+
+    for (size_t keywordIndex = 0; keywordIndex < KEYWORDS_COUNT; keywordIndex++) {
+        maxLength = KEYWORDS[keywordIndex].length > maxLength ? KEYWORDS[keywordIndex].length : maxLength;
+    }
+
+    return maxLength;
+}
+
+static constexpr size_t KEYWORD_MAX_LENGTH = getMaxKeywordLength();
+
+constexpr bool areKeywordNumbersInRange() {
+    for (size_t keywordIndex = 0; keywordIndex < KEYWORDS_COUNT; keywordIndex++) {
+        if ((size_t) KEYWORDS[keywordIndex].keyword >= KEYWORD_NUMBERS_COUNT) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static_assert(areKeywordNumbersInRange(), "a NUMBER in keywords.def does not fit KEYWORD_NUMBERS_COUNT");
+
+constexpr uint32_t hashKeyword(const char *text, size_t length, uint32_t seed) {
+    uint32_t hash = hashBytes(FNV_OFFSET_BASIS ^ seed, text, length);
+
+    return hash ^ (hash >> 15);
+}
+
+// the first seed under which no two lexemes share a slot, equal lexemes would never get one
+constexpr uint32_t findKeywordHashSeed() {
+    for (uint32_t seed = 0; seed < (1u << 16); seed++) {
+        bool isSlotUsed[KEYWORD_HASH_SIZE] = {};
+        bool isPerfect                     = true;
+
+        for (size_t keywordIndex = 0; keywordIndex < KEYWORDS_COUNT && isPerfect; keywordIndex++) {
+            size_t slot = hashKeyword(KEYWORDS[keywordIndex].lexeme, KEYWORDS[keywordIndex].length, seed) & (KEYWORD_HASH_SIZE - 1);
+
+            isPerfect        = !isSlotUsed[slot];
+            isSlotUsed[slot] = true;
+        }
+
+        if (isPerfect) {
+            return seed;
+        }
+    }
+
+    return UINT32_MAX;
+}
+
+static constexpr uint32_t KEYWORD_HASH_SEED = findKeywordHashSeed();
+
+static_assert(KEYWORD_HASH_SEED != UINT32_MAX, "keywords.def has no perfect hash, check it for repeated lexemes");
+
+struct keywordTables {
+    size_t hashSlots  [KEYWORD_HASH_SIZE]     = {}; // index in KEYWORDS or KEYWORD_NO_INDEX
+    size_t nameIndices[KEYWORD_NUMBERS_COUNT] = {}; // Keyword number -> index in KEYWORDS and in the global name table
+};
+
+constexpr keywordTables buildKeywordTables() {
+    keywordTables tables = {};
+
+    for (size_t slot = 0; slot < KEYWORD_HASH_SIZE; slot++) {
+        tables.hashSlots[slot] = KEYWORD_NO_INDEX;
+    }
+
+    for (size_t number = 0; number < KEYWORD_NUMBERS_COUNT; number++) {
+        tables.nameIndices[number] = KEYWORD_NO_INDEX;
+    }
+
+    for (size_t keywordIndex = 0; keywordIndex < KEYWORDS_COUNT; keywordIndex++) {
+        size_t slot = hashKeyword(KEYWORDS[keywordIndex].lexeme, KEYWORDS[keywordIndex].length, KEYWORD_HASH_SEED) & (KEYWORD_HASH_SIZE - 1);
+
+        tables.hashSlots  [slot]                                     = keywordIndex;
+        tables.nameIndices[(size_t) KEYWORDS[keywordIndex].keyword] = keywordIndex;
+    }
+
+    return tables;
+}
+
+static constexpr keywordTables KEYWORD_TABLES = buildKeywordTables();
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// index in KEYWORDS of the keyword spelled exactly text[0, length), KEYWORD_NO_INDEX otherwise
+inline size_t findKeywordIndex(const char *text, size_t length) {
+    if (length == 0 || length > KEYWORD_MAX_LENGTH) {
+        return KEYWORD_NO_INDEX;
+    }
+
+    size_t keywordIndex = KEYWORD_TABLES.hashSlots[hashKeyword(text, length, KEYWORD_HASH_SEED) & (KEYWORD_HASH_SIZE - 1)];
+
+    if (keywordIndex == KEYWORD_NO_INDEX || KEYWORDS[keywordIndex].length != length ||
+        memcmp(KEYWORDS[keywordIndex].lexeme, text, length) != 0) {
+        return KEYWORD_NO_INDEX;
+    }
+
+    return keywordIndex;
+}
+
+inline Keyword findKeyword(const char *text, size_t length) {
+    size_t keywordIndex = findKeywordIndex(text, length);
+
+    return keywordIndex == KEYWORD_NO_INDEX ? Keyword::UNDEFINED : KEYWORDS[keywordIndex].keyword;
+}
+
+// keywords are interned first and in keywords.def order, so this is also their global name table index
+constexpr size_t getKeywordNameIndex(Keyword keyword) {
+    return (size_t) keyword < KEYWORD_NUMBERS_COUNT ? KEYWORD_TABLES.nameIndices[(size_t) keyword] : KEYWORD_NO_INDEX;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // KEYWORD_TABLE_H_
@@ -2,8 +2,10 @@
 #define NAME_TABLE_H_
 
 #include <cstddef>
+#include <cstdint>
 
 #include "buffer.h"
+#include "hashTable.h"
 
 enum class nameType {
     IDENTIFIER = 1 << 0,
@@ -28,6 +30,18 @@ struct nameTableElement {
     Keyword  keyword = Keyword::UNDEFINED;
 
     size_t rbpOffset = 0;
+
+    size_t nameOffset = 0; // offset of the name inside nameInterner::arena
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const size_t INTERNER_INITIAL_CAPACITY = 64; // must be a power of two
+
+// every name lives in one arena as [size_t length][bytes]['\0'], a name is found through the hash of its bytes
+struct nameInterner {
+    Buffer<char> *arena = {};
+    hashTable     names = {}; // values are indices in the global name table + 1
 };
 
 enum class localNameType {
@@ -50,8 +64,17 @@ struct localNameTable {
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-bufferError initializeNameTable    (Buffer<nameTableElement> *nameTable,       bool  isGlobal);
-bufferError addIdentifier          (Buffer<nameTableElement> *nameTable, const char *identifier);
+bufferError initializeNameTable    (Buffer<nameTableElement> *nameTable, nameInterner *interner, bool isGlobal);
+bufferError destroyNameTable       (Buffer<nameTableElement> *nameTable, nameInterner *interner);
+
+bufferError addIdentifier          (Buffer<nameTableElement> *nameTable, nameInterner *interner, const char *identifier, size_t length);
+bufferError internName             (Buffer<nameTableElement> *nameTable, nameInterner *interner, const char *name,       size_t length,
+                                    nameType type, Keyword keyword, size_t *nameIndex);
+int         findName               (Buffer<nameTableElement> *nameTable, nameInterner *interner, const char *name,       size_t length);
+
+size_t      getNameLength          (const nameTableElement *element);
+size_t      getKeywordsCount       (const Buffer<nameTableElement> *nameTable);
+const char *getKeywordLexeme       (Keyword keyword);
 
 bufferError addLocalIdentifier     (int nameTableIndex, Buffer<localNameTable> *localTables, localNameTableElement newElement, size_t idSize);
 
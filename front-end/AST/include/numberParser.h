@@ -0,0 +1,24 @@
+#ifndef NUMBER_PARSER_H_
+#define NUMBER_PARSER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+enum class numberParserError {
+    NO_ERRORS       = 0,
+    POINTER_IS_NULL = 1 << 0,
+    NOT_A_NUMBER    = 1 << 1,
+    NUMBER_OVERFLOW = 1 << 2
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// both skip leading spaces and never read past text[available - 1], *length counts every consumed byte (like %n)
+numberParserError parseInt (const char *text, size_t available, int    *number, size_t *length);
+numberParserError parseSize(const char *text, size_t available, size_t *number, size_t *length);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // NUMBER_PARSER_H_
@@ -0,0 +1,279 @@
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "customWarning.h"
+#include "binaryAST.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const size_t NODE_TYPES_LAST = (size_t) nodeType::FUNCTION_CALL;
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static binaryASTError checkBinaryAST (binaryAST *ast);
+static bool           isSectionInside(const binaryAST *ast, uint64_t offset, uint64_t count, size_t elementSize);
+static binaryASTError checkSections  (binaryAST *ast);
+static binaryASTError checkNodes     (const binaryAST *ast);
+static binaryASTError checkNameTable (const binaryAST *ast);
+static binaryASTError checkFunctions (const binaryAST *ast);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+binaryASTError mapBinaryAST(binaryAST *ast, const char *fileName) {
+    customWarning(ast,      binaryASTError::BAD_POINTER);
+    customWarning(fileName, binaryASTError::BAD_POINTER);
+
+    *ast = {};
+
+    int descriptor = open(fileName, O_RDONLY);
+    customWarning(descriptor >= 0, binaryASTError::FILE_OPEN_ERROR);
+
+    struct stat fileStat = {};
+
+    if (fstat(descriptor, &fileStat) != 0 || (size_t) fileStat.st_size < sizeof(binaryASTHeader)) {
+        close(descriptor);
+
+        return binaryASTError::BAD_FORMAT;
+    }
+
+    void *mapping = mmap(NULL, (size_t) fileStat.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+    // the mapping stays valid without the descriptor
+    close(descriptor);
+
+    if (mapping == MAP_FAILED) {
+        return binaryASTError::FILE_READ_ERROR;
+    }
+
+    ast->data     = mapping;
+    ast->size     = (size_t) fileStat.st_size;
+    ast->isMapped = true;
+
+    binaryASTError error = checkBinaryAST(ast);
+
+    if (error != binaryASTError::NO_ERRORS) {
+        unmapBinaryAST(ast);
+    }
+
+    return error;
+}
+
+// data has to stay alive and aligned like any malloc'd block as long as the view is used
+binaryASTError viewBinaryAST(binaryAST *ast, const void *data, size_t size) {
+    customWarning(ast,  binaryASTError::BAD_POINTER);
+    customWarning(data, binaryASTError::BAD_POINTER);
+
+    *ast = {};
+
+    if (size < sizeof(binaryASTHeader)) {
+        return binaryASTError::BAD_FORMAT;
+    }
+
+    ast->data = data;
+    ast->size = size;
+
+    binaryASTError error = checkBinaryAST(ast);
+
+    if (error != binaryASTError::NO_ERRORS) {
+        *ast = {};
+    }
+
+    return error;
+}
+
+binaryASTError unmapBinaryAST(binaryAST *ast) {
+    customWarning(ast, binaryASTError::BAD_POINTER);
+
+    if (ast->isMapped) {
+        munmap((void *) ast->data, ast->size);
+    }
+
+    *ast = {};
+
+    return binaryASTError::NO_ERRORS;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static binaryASTError checkBinaryAST(binaryAST *ast) {
+    binaryASTError error = checkSections(ast);
+
+    if (error == binaryASTError::NO_ERRORS) {
+        error = checkNodes(ast);
+    }
+
+    if (error == binaryASTError::NO_ERRORS) {
+        error = checkNameTable(ast);
+    }
+
+    if (error == binaryASTError::NO_ERRORS) {
+        error = checkFunctions(ast);
+    }
+
+    return error;
+}
+
+static bool isSectionInside(const binaryAST *ast, uint64_t offset, uint64_t count, size_t elementSize) {
+    return offset % BINARY_AST_ALIGNMENT == 0 && offset <= ast->size &&
+           count <= (ast->size - offset) / elementSize;
+}
+
+static binaryASTError checkSections(binaryAST *ast) {
+    const binaryASTHeader *header = (const binaryASTHeader *) ast->data;
+    const char            *base   = (const char *)            ast->data;
+
+    if (memcmp(header->magic, BINARY_AST_MAGIC, sizeof(BINARY_AST_MAGIC)) != 0) {
+        return binaryASTError::BAD_FORMAT;
+    }
+
+    if (header->version != BINARY_AST_VERSION) {
+        return binaryASTError::BAD_VERSION;
+    }
+
+    if (!isSectionInside(ast, header->functionsOffset,     header->functionsCount,     sizeof(binaryASTFunction))     ||
+        !isSectionInside(ast, header->nodesOffset,         header->nodesCount,         sizeof(binaryASTNode))         ||
+        !isSectionInside(ast, header->namesOffset,         header->namesCount,         sizeof(binaryASTName))         ||
+        !isSectionInside(ast, header->localTablesOffset,   header->localTablesCount,   sizeof(binaryASTLocalTable))   ||
+        !isSectionInside(ast, header->localElementsOffset, header->localElementsCount, sizeof(binaryASTLocalElement)) ||
+        !isSectionInside(ast, header->stringsOffset,       header->stringsSize,        sizeof(char))) {
+        return binaryASTError::BAD_FORMAT;
+    }
+
+    ast->header        = header;
+    ast->functions     = (const binaryASTFunction *)     (base + header->functionsOffset);
+    ast->nodes         = (const binaryASTNode *)         (base + header->nodesOffset);
+    ast->names         = (const binaryASTName *)         (base + header->namesOffset);
+    ast->localTables   = (const binaryASTLocalTable *)   (base + header->localTablesOffset);
+    ast->localElements = (const binaryASTLocalElement *) (base + header->localElementsOffset);
+    ast->strings       = base + header->stringsOffset;
+
+    return binaryASTError::NO_ERRORS;
+}
+
+// every child has to point back at the node that holds it and come after it, so one pass in file order can link the tree
+static binaryASTError checkNodes(const binaryAST *ast) {
+    uint32_t nodesCount = ast->header->nodesCount;
+
+    if (nodesCount == 0) {
+        return ast->header->root == AST_NO_NODE ? binaryASTError::NO_ERRORS : binaryASTError::BAD_FORMAT;
+    }
+
+    if (ast->header->root != 0 || ast->nodes[0].parent != AST_NO_NODE) {
+        return binaryASTError::BAD_FORMAT;
+    }
+
+    for (uint32_t nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++) {
+        const binaryASTNode *currentNode = &ast->nodes[nodeIndex];
+
+        if (currentNode->type < 1 || currentNode->type > NODE_TYPES_LAST) {
+            return binaryASTError::BAD_FORMAT;
+        }
+
+        astHandle children[] = {currentNode->left, currentNode->right};
+
+        for (size_t childIndex = 0; childIndex < 2; childIndex++) {
+            astHandle child = children[childIndex];
+
+            if (child == AST_NO_NODE) {
+                continue;
+            }
+
+            if (child <= nodeIndex || child >= nodesCount || ast->nodes[child].parent != nodeIndex) {
+                return binaryASTError::BAD_FORMAT;
+            }
+        }
+
+        // and every node but the root is held by its parent
+        if (nodeIndex > 0) {
+            if (currentNode->parent >= nodeIndex) {
+                return binaryASTError::BAD_FORMAT;
+            }
+
+            const binaryASTNode *parent = &ast->nodes[currentNode->parent];
+
+            if (parent->left != nodeIndex && parent->right != nodeIndex) {
+                return binaryASTError::BAD_FORMAT;
+            }
+        }
+    }
+
+    return binaryASTError::NO_ERRORS;
+}
+
+static binaryASTError checkNameTable(const binaryAST *ast) {
+    const binaryASTHeader *header = ast->header;
+
+    if (header->stringsSize > 0 && ast->strings[header->stringsSize - 1] != '\0') {
+        return binaryASTError::BAD_FORMAT;
+    }
+
+    if (header->namesCount > 0 && header->entryPoint >= header->namesCount) {
+        return binaryASTError::BAD_FORMAT;
+    }
+
+    for (uint32_t nameIndex = 0; nameIndex < header->namesCount; nameIndex++) {
+        const binaryASTName *name = &ast->names[nameIndex];
+
+        if (name->offset >= header->stringsSize || name->length >= header->stringsSize - name->offset ||
+            ast->strings[name->offset + name->length] != '\0') {
+            return binaryASTError::BAD_FORMAT;
+        }
+    }
+
+    for (uint32_t tableIndex = 0; tableIndex < header->localTablesCount; tableIndex++) {
+        const binaryASTLocalTable *table = &ast->localTables[tableIndex];
+
+        if (table->firstElement > header->localElementsCount ||
+            table->elementsCount > header->localElementsCount - table->firstElement) {
+            return binaryASTError::BAD_FORMAT;
+        }
+    }
+
+    return binaryASTError::NO_ERRORS;
+}
+
+// a function has to be a whole subtree: nothing inside it is held from outside and nothing inside it holds a node past it
+static binaryASTError checkFunctions(const binaryAST *ast) {
+    const binaryASTHeader *header      = ast->header;
+    uint64_t               nodesSize   = (uint64_t) header->nodesCount * sizeof(binaryASTNode);
+    uint32_t               sectionsEnd = 0;
+
+    for (uint32_t functionIndex = 0; functionIndex < header->functionsCount; functionIndex++) {
+        const binaryASTFunction *function = &ast->functions[functionIndex];
+
+        if (function->offset < header->nodesOffset || function->offset - header->nodesOffset > nodesSize ||
+            function->size == 0 || function->size > nodesSize - (function->offset - header->nodesOffset) ||
+            (function->offset - header->nodesOffset) % sizeof(binaryASTNode) != 0 || function->size % sizeof(binaryASTNode) != 0) {
+            return binaryASTError::BAD_FORMAT;
+        }
+
+        uint32_t firstNode = getFunctionFirstNode(ast, function);
+        uint32_t lastNode  = firstNode + getFunctionNodesCount(function);
+
+        // in file order and apart
+        if (firstNode < sectionsEnd || function->nameIndex >= header->namesCount ||
+            ast->nodes[firstNode].type    != (uint32_t) nodeType::FUNCTION_DEFINITION ||
+            ast->nodes[firstNode].payload != (int64_t)  function->nameIndex) {
+            return binaryASTError::BAD_FORMAT;
+        }
+
+        for (uint32_t nodeIndex = firstNode; nodeIndex < lastNode; nodeIndex++) {
+            const binaryASTNode *currentNode = &ast->nodes[nodeIndex];
+
+            if ((nodeIndex > firstNode && currentNode->parent < firstNode) ||
+                (currentNode->left  != AST_NO_NODE && currentNode->left  >= lastNode) ||
+                (currentNode->right != AST_NO_NODE && currentNode->right >= lastNode)) {
+                return binaryASTError::BAD_FORMAT;
+            }
+        }
+
+        sectionsEnd = lastNode;
+    }
+
+    return binaryASTError::NO_ERRORS;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
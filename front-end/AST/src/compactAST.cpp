@@ -0,0 +1,306 @@
+#include <cstdlib>
+#include <cstring>
+
+#include "customWarning.h"
+#include "compactAST.h"
+#include "buffer.h"
+#include "binaryTree.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+struct flattenFrame {
+    node<astNode> *current = NULL;
+    astHandle      parent  = AST_NO_NODE;
+    bool           isRight = false;
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError initializeCompactAST(compactAST *ast) {
+    customWarning(ast, bufferError::POINTER_IS_NULL);
+
+    if (bufferInitialize(&ast->nodes)       != bufferError::NO_BUFFER_ERROR ||
+        bufferInitialize(&ast->locations)   != bufferError::NO_BUFFER_ERROR ||
+        bufferInitialize(&ast->annotations) != bufferError::NO_BUFFER_ERROR ||
+        bufferInitialize(&ast->files)       != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
+    ast->root = AST_NO_NODE;
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+bufferError destroyCompactAST(compactAST *ast) {
+    customWarning(ast, bufferError::POINTER_IS_NULL);
+
+    for (size_t fileID = 0; fileID < ast->files.currentIndex; fileID++) {
+        FREE_(ast->files.data[fileID]);
+    }
+
+    bufferDestruct(&ast->nodes);
+    bufferDestruct(&ast->locations);
+    bufferDestruct(&ast->annotations);
+    bufferDestruct(&ast->files);
+
+    ast->root = AST_NO_NODE;
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError appendCompactNode(compactAST *ast, const compactNode *newNode, const compactLocation *location,
+                              astHandle parent, bool isRight, astHandle *handle) {
+    customWarning(ast,      bufferError::POINTER_IS_NULL);
+    customWarning(newNode,  bufferError::POINTER_IS_NULL);
+    customWarning(location, bufferError::POINTER_IS_NULL);
+    customWarning(handle,   bufferError::POINTER_IS_NULL);
+
+    if (ast->nodes.currentIndex >= AST_MAX_NODES) {
+        return bufferError::BUFFER_ENDED;
+    }
+
+    compactNode linkedNode = *newNode;
+
+    linkedNode.left   = AST_NO_NODE;
+    linkedNode.right  = AST_NO_NODE;
+    linkedNode.parent = parent;
+
+    if (writeDataToBuffer(&ast->nodes,     &linkedNode, 1) != bufferError::NO_BUFFER_ERROR ||
+        writeDataToBuffer(&ast->locations, location,    1) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
+    *handle = (astHandle) (ast->nodes.currentIndex - 1);
+
+    if (parent == AST_NO_NODE) {
+        return bufferError::NO_BUFFER_ERROR;
+    }
+
+    if (isRight) {
+        ast->nodes.data[parent].right = *handle;
+    } else {
+        ast->nodes.data[parent].left  = *handle;
+    }
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// the right child goes on the stack first, so the left subtree comes out before it
+bufferError buildCompactAST(compactAST *ast, node<astNode> *root) {
+    customWarning(ast, bufferError::POINTER_IS_NULL);
+
+    ast->root = AST_NO_NODE;
+
+    if (!root) {
+        return bufferError::NO_BUFFER_ERROR;
+    }
+
+    Buffer<flattenFrame> frames = {};
+
+    if (bufferInitialize(&frames) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
+    flattenFrame rootFrame = {.current = root, .parent = AST_NO_NODE, .isRight = false};
+    bufferError  error     = writeDataToBuffer(&frames, &rootFrame, 1);
+
+    while (error == bufferError::NO_BUFFER_ERROR && frames.currentIndex > 0) {
+        flattenFrame    frame    = frames.data[--frames.currentIndex];
+        compactNode     newNode  = {.data = frame.current->data.data, .type = frame.current->data.type};
+        compactLocation location = {.line = frame.current->data.line};
+        astHandle       handle   = AST_NO_NODE;
+
+        error = internASTFile(ast, frame.current->data.file, &location.fileID);
+
+        if (error == bufferError::NO_BUFFER_ERROR) {
+            error = appendCompactNode(ast, &newNode, &location, frame.parent, frame.isRight, &handle);
+        }
+
+        if (error != bufferError::NO_BUFFER_ERROR) {
+            break;
+        }
+
+        if (frame.parent == AST_NO_NODE) {
+            ast->root = handle;
+        }
+
+        flattenFrame rightFrame = {.current = frame.current->right, .parent = handle, .isRight = true};
+        flattenFrame leftFrame  = {.current = frame.current->left,  .parent = handle, .isRight = false};
+
+        if (rightFrame.current) {
+            error = writeDataToBuffer(&frames, &rightFrame, 1);
+        }
+
+        if (leftFrame.current && error == bufferError::NO_BUFFER_ERROR) {
+            error = writeDataToBuffer(&frames, &leftFrame, 1);
+        }
+    }
+
+    bufferDestruct(&frames);
+
+    return error;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError annotateCompactAST(compactAST *ast) {
+    customWarning(ast, bufferError::POINTER_IS_NULL);
+
+    compactAnnotation emptyAnnotation = {};
+
+    while (ast->annotations.currentIndex < ast->nodes.currentIndex) {
+        if (writeDataToBuffer(&ast->annotations, &emptyAnnotation, 1) != bufferError::NO_BUFFER_ERROR) {
+            return bufferError::CALLOC_ERROR;
+        }
+    }
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// a program comes from a handful of files, a linear search is enough
+bufferError internASTFile(compactAST *ast, const char *fileName, uint32_t *fileID) {
+    customWarning(ast,    bufferError::POINTER_IS_NULL);
+    customWarning(fileID, bufferError::POINTER_IS_NULL);
+
+    *fileID = AST_NO_FILE;
+
+    if (!fileName) {
+        return bufferError::NO_BUFFER_ERROR;
+    }
+
+    for (size_t fileIndex = 0; fileIndex < ast->files.currentIndex; fileIndex++) {
+        if (strcmp(ast->files.data[fileIndex], fileName) == 0) {
+            *fileID = (uint32_t) fileIndex;
+            return bufferError::NO_BUFFER_ERROR;
+        }
+    }
+
+    char *fileCopy = strdup(fileName);
+    customWarning(fileCopy, bufferError::CALLOC_ERROR);
+
+    if (writeDataToBuffer(&ast->files, &fileCopy, 1) != bufferError::NO_BUFFER_ERROR) {
+        FREE_(fileCopy);
+        return bufferError::CALLOC_ERROR;
+    }
+
+    *fileID = (uint32_t) (ast->files.currentIndex - 1);
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError compactIteratorInitialize(compactIterator *iterator, compactAST *ast, astHandle root, printType order) {
+    customWarning(iterator, bufferError::POINTER_IS_NULL);
+    customWarning(ast,      bufferError::POINTER_IS_NULL);
+
+    *iterator = {};
+
+    iterator->ast   = ast;
+    iterator->order = order;
+    iterator->error = bufferInitialize(&iterator->frames);
+
+    compactFrame rootFrame = {.current = root, .visit = printType::PREFIX};
+
+    if (root != AST_NO_NODE && iterator->error == bufferError::NO_BUFFER_ERROR) {
+        iterator->error = writeDataToBuffer(&iterator->frames, &rootFrame, 1);
+    }
+
+    return iterator->error;
+}
+
+bufferError compactIteratorDestruct(compactIterator *iterator) {
+    customWarning(iterator, bufferError::POINTER_IS_NULL);
+
+    bufferDestruct(&iterator->frames);
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// treeIteratorNext with the frames in a buffer
+compactNode *compactIteratorNext(compactIterator *iterator) {
+    customWarning(iterator, NULL);
+
+    Buffer<compactFrame> *frames = &iterator->frames;
+
+    while (frames->currentIndex > 0 && iterator->error == bufferError::NO_BUFFER_ERROR) {
+        compactFrame *frame       = &frames->data[frames->currentIndex - 1];
+        compactNode  *currentNode = &iterator->ast->nodes.data[frame->current];
+        printType     visit       = frame->visit;
+        compactFrame  childFrame  = {};
+
+        // the frame may move once a child is pushed
+        switch (visit) {
+            case printType::PREFIX:
+            {
+                frame->visit = printType::INFIX;
+                childFrame   = {.current = currentNode->left,  .visit = printType::PREFIX};
+                break;
+            }
+
+            case printType::INFIX:
+            {
+                frame->visit = printType::POSTFIX;
+                childFrame   = {.current = currentNode->right, .visit = printType::PREFIX};
+                break;
+            }
+
+            case printType::POSTFIX:
+            default:
+            {
+                frames->currentIndex--;
+                break;
+            }
+        }
+
+        if (childFrame.current != AST_NO_NODE) {
+            iterator->error = writeDataToBuffer(frames, &childFrame, 1);
+        }
+
+        if (iterator->order == visit) {
+            return currentNode;
+        }
+    }
+
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError compactChainIteratorInitialize(compactChainIterator *iterator, compactAST *ast, compactNode *chain,
+                                           bool (*isLink)(compactNode *)) {
+    customWarning(iterator, bufferError::POINTER_IS_NULL);
+    customWarning(isLink,   bufferError::POINTER_IS_NULL);
+
+    iterator->ast    = ast;
+    iterator->link   = chain;
+    iterator->isLink = isLink;
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// the left child of every link in order, empty ones skipped, then the node that ends the chain if it is not a link
+compactNode *compactChainIteratorNext(compactChainIterator *iterator) {
+    customWarning(iterator, NULL);
+
+    while (iterator->link) {
+        compactNode *link = iterator->link;
+
+        if (!iterator->isLink(link)) {
+            iterator->link = NULL;
+            return link;
+        }
+
+        iterator->link = getCompactRight(iterator->ast, link);
+
+        if (link->left != AST_NO_NODE) {
+            return getCompactLeft(iterator->ast, link);
+        }
+    }
+
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -0,0 +1,110 @@
+#include <cstdlib>
+
+#include "customWarning.h"
+#include "hashTable.h"
+#include "buffer.h"
+#include "binaryTreeDef.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static bufferError growHashTable(hashTable *table);
+static void        placeHashSlot(hashTable *table, uint32_t hash, size_t value);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError initializeHashTable(hashTable *table, size_t capacity) {
+    customWarning(table,                                    bufferError::POINTER_IS_NULL);
+    customWarning(capacity && !(capacity & (capacity - 1)), bufferError::CALLOC_ERROR);
+
+    table->slots = (hashSlot *)calloc(capacity, sizeof(hashSlot));
+    customWarning(table->slots, bufferError::CALLOC_ERROR);
+
+    table->capacity = capacity;
+    table->count    = 0;
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+bufferError destroyHashTable(hashTable *table) {
+    customWarning(table, bufferError::POINTER_IS_NULL);
+
+    FREE_(table->slots);
+
+    table->capacity = 0;
+    table->count    = 0;
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+bufferError clearHashTable(hashTable *table) {
+    customWarning(table,        bufferError::POINTER_IS_NULL);
+    customWarning(table->slots, bufferError::NO_BUFFER);
+
+    for (size_t slotIndex = 0; slotIndex < table->capacity; slotIndex++) {
+        table->slots[slotIndex] = hashSlot{};
+    }
+
+    table->count = 0;
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+bufferError insertHashValue(hashTable *table, uint32_t hash, size_t value) {
+    customWarning(table,        bufferError::POINTER_IS_NULL);
+    customWarning(table->slots, bufferError::NO_BUFFER);
+
+    // the load factor stays at 3/4 or under
+    if ((table->count + 1) * 4 > table->capacity * 3 && growHashTable(table) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
+    placeHashSlot(table, hash, value);
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static bufferError growHashTable(hashTable *table) {
+    hashSlot *oldSlots    = table->slots;
+    size_t    oldCapacity = table->capacity;
+
+    table->slots = (hashSlot *)calloc(oldCapacity * 2, sizeof(hashSlot));
+
+    if (!table->slots) {
+        table->slots = oldSlots;
+
+        return bufferError::CALLOC_ERROR;
+    }
+
+    table->capacity = oldCapacity * 2;
+    table->count    = 0;
+
+    for (size_t slotIndex = 0; slotIndex < oldCapacity; slotIndex++) {
+        if (oldSlots[slotIndex].value && oldSlots[slotIndex].value != HASH_REMOVED_VALUE) {
+            placeHashSlot(table, oldSlots[slotIndex].hash, oldSlots[slotIndex].value);
+        }
+    }
+
+    FREE_(oldSlots);
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// the first removed slot on the way is taken back, so renames don't pile removed slots up in one probe chain
+static void placeHashSlot(hashTable *table, uint32_t hash, size_t value) {
+    size_t slotIndex = getFirstHashSlot(table, hash);
+
+    while (table->slots[slotIndex].value && table->slots[slotIndex].value != HASH_REMOVED_VALUE) {
+        slotIndex = getNextHashSlot(table, slotIndex);
+    }
+
+    if (!table->slots[slotIndex].value) {
+        table->count++;
+    }
+
+    table->slots[slotIndex].hash  = hash;
+    table->slots[slotIndex].value = value;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -1,38 +1,203 @@
+#include <cstdlib>
+#include <cstring>
+
 #include "customWarning.h"
 #include "nameTable.h"
+#include "keywordTable.h"
 #include "buffer.h"
+#include "binaryTreeDef.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static int         findHashedName     (Buffer<nameTableElement> *nameTable, nameInterner *interner, const char *name, size_t length,
+                                       uint32_t hash);
+static bool        isSameName         (Buffer<nameTableElement> *nameTable, size_t nameIndex, const char *name, size_t length);
+static bufferError writeNameToArena   (Buffer<nameTableElement> *nameTable, nameInterner *interner, const char *name, size_t length,
+                                       size_t *nameOffset);
 
-bufferError initializeNameTable(Buffer<nameTableElement> *nameTable, bool isGlobal) {
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError initializeNameTable(Buffer<nameTableElement> *nameTable, nameInterner *interner, bool isGlobal) {
     customWarning(nameTable, bufferError::POINTER_IS_NULL);
+    customWarning(interner,  bufferError::POINTER_IS_NULL);
 
     if (bufferInitialize(nameTable) != bufferError::NO_BUFFER_ERROR) {
         return bufferError::CALLOC_ERROR;
     }
 
+    interner->arena = (Buffer<char> *)calloc(1, sizeof(Buffer<char>));
+    customWarning(interner->arena, bufferError::CALLOC_ERROR);
+
+    if (bufferInitialize(interner->arena) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
+    if (initializeHashTable(&interner->names, INTERNER_INITIAL_CAPACITY) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
     if (isGlobal) {
-        #define KEYWORD(NAME, NUMBER, KEYWORD, TYPE, ...) {                                                         \
-            nameTableElement newElement = {.name = KEYWORD, .type = TYPE, .keyword = static_cast<Keyword>(NUMBER)}; \
-            if (writeDataToBuffer(nameTable, &newElement, 1) != bufferError::NO_BUFFER_ERROR) {                     \
-                return bufferError::BUFFER_ENDED;                                                                   \
-            }                                                                                                       \
-        }
+        for (size_t keywordIndex = 0; keywordIndex < KEYWORDS_COUNT; keywordIndex++) {
+            const keywordInfo *keyword   = &KEYWORDS[keywordIndex];
+            size_t             nameIndex = 0;
 
-        #include "keywords.def"
+            if (internName(nameTable, interner, keyword->lexeme, keyword->length, keyword->type, keyword->keyword, &nameIndex) !=
+                bufferError::NO_BUFFER_ERROR) {
+                return bufferError::BUFFER_ENDED;
+            }
 
-        #undef KEYWORD
+            // the lexer and the parser take keyword indices from getKeywordNameIndex without looking them up
+            customWarning(nameIndex == keywordIndex, bufferError::BUFFER_ENDED);
+        }
     }
 
     return bufferError::NO_BUFFER_ERROR;
 }
 
-bufferError addIdentifier(Buffer<nameTableElement> *nameTable, const char *identifier) {
+bufferError destroyNameTable(Buffer<nameTableElement> *nameTable, nameInterner *interner) {
+    customWarning(nameTable, bufferError::POINTER_IS_NULL);
+    customWarning(interner,  bufferError::POINTER_IS_NULL);
+
+    if (interner->arena) {
+        bufferDestruct(interner->arena);
+        FREE_(interner->arena);
+    }
+
+    destroyHashTable(&interner->names);
+
+    return bufferDestruct(nameTable);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError internName(Buffer<nameTableElement> *nameTable, nameInterner *interner, const char *name, size_t length,
+                       nameType type, Keyword keyword, size_t *nameIndex) {
+    customWarning(nameTable,             bufferError::POINTER_IS_NULL);
+    customWarning(interner,              bufferError::POINTER_IS_NULL);
+    customWarning(interner->names.slots, bufferError::NO_BUFFER);
+    customWarning(name,                  bufferError::POINTER_IS_NULL);
+    customWarning(nameIndex,             bufferError::POINTER_IS_NULL);
+
+    uint32_t hash  = hashBytes(FNV_OFFSET_BASIS, name, length);
+    int      found = findHashedName(nameTable, interner, name, length, hash);
+
+    if (found >= 0) {
+        *nameIndex = (size_t) found;
+
+        return bufferError::NO_BUFFER_ERROR;
+    }
+
+    nameTableElement newElement = {.name = NULL, .type = type, .keyword = keyword};
+
+    if (writeNameToArena(nameTable, interner, name, length, &newElement.nameOffset) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::BUFFER_ENDED;
+    }
+
+    newElement.name = interner->arena->data + newElement.nameOffset;
+
+    if (writeDataToBuffer(nameTable, &newElement, 1) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::BUFFER_ENDED;
+    }
+
+    *nameIndex = nameTable->currentIndex - 1;
+
+    return insertHashValue(&interner->names, hash, *nameIndex + 1);
+}
+
+bufferError addIdentifier(Buffer<nameTableElement> *nameTable, nameInterner *interner, const char *identifier, size_t length) {
     customWarning(identifier, bufferError::POINTER_IS_NULL);
 
-    nameTableElement newElement = {.name = (char *)identifier, .type = nameType::IDENTIFIER, .keyword = Keyword::UNDEFINED};
+    size_t nameIndex = 0;
+
+    return internName(nameTable, interner, identifier, length, nameType::IDENTIFIER, Keyword::UNDEFINED, &nameIndex);
+}
+
+int findName(Buffer<nameTableElement> *nameTable, nameInterner *interner, const char *name, size_t length) {
+    customWarning(nameTable,             -1);
+    customWarning(interner,              -1);
+    customWarning(interner->names.slots, -1);
+    customWarning(name,                  -1);
 
-    return writeDataToBuffer(nameTable, &newElement, 1);
+    return findHashedName(nameTable, interner, name, length, hashBytes(FNV_OFFSET_BASIS, name, length));
 }
 
+size_t getNameLength(const nameTableElement *element) {
+    customWarning(element,       0);
+    customWarning(element->name, 0);
+
+    size_t length = 0;
+    memcpy(&length, element->name - sizeof(size_t), sizeof(size_t));
+
+    return length;
+}
+
+// keywords are interned first, so they end where the first identifier starts
+size_t getKeywordsCount(const Buffer<nameTableElement> *nameTable) {
+    customWarning(nameTable, 0);
+
+    size_t keywordsCount = 0;
+
+    while (keywordsCount < nameTable->currentIndex && nameTable->data[keywordsCount].type != nameType::IDENTIFIER) {
+        keywordsCount++;
+    }
+
+    return keywordsCount;
+}
+
+const char *getKeywordLexeme(Keyword keyword) {
+    size_t keywordIndex = getKeywordNameIndex(keyword);
+
+    return keywordIndex == KEYWORD_NO_INDEX ? NULL : KEYWORDS[keywordIndex].lexeme;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static int findHashedName(Buffer<nameTableElement> *nameTable, nameInterner *interner, const char *name, size_t length,
+                          uint32_t hash) {
+    hashTable *names = &interner->names;
+
+    for (size_t slotIndex = getFirstHashSlot(names, hash); names->slots[slotIndex].value; slotIndex = getNextHashSlot(names, slotIndex)) {
+        if (names->slots[slotIndex].hash == hash && isSameName(nameTable, names->slots[slotIndex].value - 1, name, length)) {
+            return (int) names->slots[slotIndex].value - 1;
+        }
+    }
+
+    return -1;
+}
+
+static bool isSameName(Buffer<nameTableElement> *nameTable, size_t nameIndex, const char *name, size_t length) {
+    return getNameLength(&nameTable->data[nameIndex]) == length && !memcmp(nameTable->data[nameIndex].name, name, length);
+}
+
+static bufferError writeNameToArena(Buffer<nameTableElement> *nameTable, nameInterner *interner, const char *name, size_t length,
+                                    size_t *nameOffset) {
+    char *oldArena = interner->arena->data;
+
+    if (writeDataToBuffer(interner->arena, (char *)&length, sizeof(size_t)) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::BUFFER_ENDED;
+    }
+
+    *nameOffset = interner->arena->currentIndex;
+
+    char terminator = '\0';
+
+    if (writeDataToBuffer(interner->arena, (char *)name, length) != bufferError::NO_BUFFER_ERROR ||
+        writeDataToBuffer(interner->arena, &terminator,  1)      != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::BUFFER_ENDED;
+    }
+
+    // the arena may have been reallocated, names already handed out point into the old block
+    if (interner->arena->data != oldArena) {
+        for (size_t nameIndex = 0; nameIndex < nameTable->currentIndex; nameIndex++) {
+            nameTable->data[nameIndex].name = interner->arena->data + nameTable->data[nameIndex].nameOffset;
+        }
+    }
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
 bufferError addLocalIdentifier(int nameTableIndex, Buffer<localNameTable> *localTables, localNameTableElement newElement, size_t idSize) {
     customWarning(localTables, bufferError::POINTER_IS_NULL);
 
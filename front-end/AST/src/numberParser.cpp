@@ -0,0 +1,146 @@
+#include <climits>
+#include <cstring>
+
+#include "customWarning.h"
+#include "numberParser.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const uint64_t SWAR_ZEROS      = 0x3030303030303030ull;
+static const size_t   SWAR_CHUNK_SIZE = sizeof(uint64_t);
+
+static size_t            skipSpaces    (const char *text, size_t available);
+static numberParserError parseDigits   (const char *text, size_t available, uint64_t *number, size_t *length);
+
+static bool              isEightDigits (uint64_t chunk);
+static uint64_t          convertEight  (uint64_t chunk);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+numberParserError parseInt(const char *text, size_t available, int *number, size_t *length) {
+    customWarning(text,   numberParserError::POINTER_IS_NULL);
+    customWarning(number, numberParserError::POINTER_IS_NULL);
+    customWarning(length, numberParserError::POINTER_IS_NULL);
+
+    size_t position   = skipSpaces(text, available);
+    bool   isNegative = false;
+
+    if (position < available && (text[position] == '-' || text[position] == '+')) {
+        isNegative = text[position] == '-';
+        position++;
+    }
+
+    uint64_t          magnitude    = 0;
+    size_t            digitsLength = 0;
+    numberParserError error        = parseDigits(text + position, available - position, &magnitude, &digitsLength);
+
+    if (error != numberParserError::NO_ERRORS) {
+        return error;
+    }
+
+    if (magnitude > (uint64_t)INT_MAX + (isNegative ? 1 : 0)) {
+        return numberParserError::NUMBER_OVERFLOW;
+    }
+
+    *number = isNegative ? (int)(0 - magnitude) : (int)magnitude;
+    *length = position + digitsLength;
+
+    return numberParserError::NO_ERRORS;
+}
+
+numberParserError parseSize(const char *text, size_t available, size_t *number, size_t *length) {
+    customWarning(text,   numberParserError::POINTER_IS_NULL);
+    customWarning(number, numberParserError::POINTER_IS_NULL);
+    customWarning(length, numberParserError::POINTER_IS_NULL);
+
+    size_t position = skipSpaces(text, available);
+
+    uint64_t          value        = 0;
+    size_t            digitsLength = 0;
+    numberParserError error        = parseDigits(text + position, available - position, &value, &digitsLength);
+
+    if (error != numberParserError::NO_ERRORS) {
+        return error;
+    }
+
+    if (value > SIZE_MAX) {
+        return numberParserError::NUMBER_OVERFLOW;
+    }
+
+    *number = (size_t)value;
+    *length = position + digitsLength;
+
+    return numberParserError::NO_ERRORS;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static size_t skipSpaces(const char *text, size_t available) {
+    size_t position = 0;
+
+    while (position < available && (text[position] == ' ' || (text[position] >= '\t' && text[position] <= '\r'))) {
+        position++;
+    }
+
+    return position;
+}
+
+static numberParserError parseDigits(const char *text, size_t available, uint64_t *number, size_t *length) {
+    uint64_t value    = 0;
+    size_t   position = 0;
+
+    #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        // eight digits at a time while the whole chunk is digits
+        while (position + SWAR_CHUNK_SIZE <= available) {
+            uint64_t chunk = 0;
+            memcpy(&chunk, text + position, SWAR_CHUNK_SIZE);
+
+            if (!isEightDigits(chunk)) {
+                break;
+            }
+
+            if (__builtin_mul_overflow(value, 100000000ull, &value) ||
+                __builtin_add_overflow(value, convertEight(chunk), &value)) {
+                return numberParserError::NUMBER_OVERFLOW;
+            }
+
+            position += SWAR_CHUNK_SIZE;
+        }
+    #endif
+
+    while (position < available && text[position] >= '0' && text[position] <= '9') {
+        if (__builtin_mul_overflow(value, 10ull, &value) ||
+            __builtin_add_overflow(value, (uint64_t)(text[position] - '0'), &value)) {
+            return numberParserError::NUMBER_OVERFLOW;
+        }
+
+        position++;
+    }
+
+    if (position == 0) {
+        return numberParserError::NOT_A_NUMBER;
+    }
+
+    *number = value;
+    *length = position;
+
+    return numberParserError::NO_ERRORS;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static bool isEightDigits(uint64_t chunk) {
+    return ((chunk & 0xf0f0f0f0f0f0f0f0ull) | (((chunk + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+// first byte is the most significant digit: merge neighbours into pairs, then pairs into quads, then the two quads
+static uint64_t convertEight(uint64_t chunk) {
+    chunk -= SWAR_ZEROS;
+    chunk  = (chunk * 10) + (chunk >> 8);
+    chunk  = (((chunk & 0x000000ff000000ffull) * (100 + (1000000ull << 32))) +
+              (((chunk >> 16) & 0x000000ff000000ffull) * (1 + (10000ull << 32)))) >> 32;
+
+    return chunk;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -5,6 +5,7 @@
 
 #include "customWarning.h"
 #include "AST.h"
+#include "compactAST.h"
 #include "core.h"
 
 enum class dumpError {
@@ -39,8 +40,9 @@ dumpError destroyDumpContext   (dumpContext *dumpContext);
 
 char     *getASTFileName(binaryTree<astNode> *tree);
 
+// dumpTree flattens the tree, dumpNode walks a subtree of the compact copy
 dumpError dumpTree(compilationContext *context, dumpContext *dumpContext, binaryTree<astNode> *tree);
-dumpError dumpNode(compilationContext *context, dumpContext *dumpContext, node<astNode> *node);
+dumpError dumpNode(compilationContext *context, dumpContext *dumpContext, compactAST *tree, astHandle subtree);
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
@@ -1,7 +1,15 @@
 #ifndef CORE_H_
 #define CORE_H_
 
+#include <cstddef>
+
 #include "nameTable.h"
+#include "nameTrie.h"
+#include "tokenStream.h"
+#include "sourceInput.h"
+#include "scopeChain.h"
+#include "expressionTable.h"
+#include "astHandoff.h"
 #include "buffer.h"
 #include "AST.h"
 
@@ -39,43 +47,81 @@ enum class compilationError: long long int {
     VARIABLE_NOT_DECLARED        = 1 << 29,
     OPERATOR_NOT_FOUND           = 1 << 30,
     ALLOCATION_ERROR             = 1 << 31,
+    CONSTANT_OVERFLOW            = 1ll << 32,
 };
 
 struct errorData {
     compilationError error = compilationError::NO_ERRORS;
     int              line  = 0;
-    char            *file  = NULL;
+    const char      *file  = NULL;
+};
+
+// tokens and function calls of one top-level declaration, enough to parse it again on its own.
+// lines of its nodes are counted from the line of its first token, so an edit above it moves it without touching them.
+// a declaration parsed again has its tokens and calls appended at the end, the old ones stay unused until a full parse
+struct declarationRange {
+    size_t         firstToken  = 0;
+    size_t         tokensCount = 0;  // including the separator after the declaration
+    size_t         firstCall   = 0;  // index in compilationContext::functionCalls
+    size_t         callsCount  = 0;
+    int            localTable  = -1; // of a function definition
+
+    node<astNode> *separator   = NULL; // separator->left is the declaration
+
+    // the declarations are also a Fenwick tree of how far edits moved them since their tokens were lexed:
+    // a token is at its offset and line plus the prefix sum up to its declaration
+    ptrdiff_t      offsetShift = 0;
+    int            lineShift   = 0;
 };
 
 struct compilationContext {
     Buffer<nameTableElement> *nameTable   = {};
+    nameInterner             *interner    = {};
     Buffer<localNameTable>   *localTables = {};
-    Buffer<node<astNode> *>  *tokens      = {};
+    Buffer<nameScope>        *scopes      = {}; // innermost last, indexes localTables for declaration checks
+    tokenStream              *tokens      = {};
+
+    nameTrie                 *trie        = {};
 
     size_t tokenIndex  = 0;
 
     int    currentLine = 0;
+    int    lineBase    = 0; // first line of the top-level declaration being parsed
 
     compilationError   error       = compilationError::NO_ERRORS;
     Buffer<errorData> *errorBuffer = {};
 
     binaryTree<astNode> *AST = {};
 
-    char  *fileContent = NULL;
-    size_t fileSize    = 0;
+    sourceInput *source      = NULL; // owned by the caller
+    char        *fileContent = NULL; // view into source->data, not null-terminated and contiguous up to source->gapBegin
+    size_t       fileSize    = 0;
 
     size_t entryPoint  = 0; // IR?
 
     Buffer<node<astNode> *> *functionCalls = {}; // IR?
+
+    Buffer<declarationRange> *declarations  = {}; // top-level declarations in source order
+    int                       reparsedTable = -1; // local table of the function reparseDeclaration parses again
+
+    expressionTable *expressions = {}; // NULL unless identical pure expressions are shared
 };
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-compilationError initializeCompilationContext(compilationContext *context, char *fileContent);
+compilationError initializeCompilationContext(compilationContext *context, sourceInput *source);
 compilationError destroyCompilationContext   (compilationContext *context);
+compilationError enableExpressionSharing     (compilationContext *context);
+// the parsed source for the back-end, it stays valid until the context is destroyed or parses again
+compilationError getASTHandoff               (compilationContext *context, astHandoff *handoff);
 
 compilationError dumpTokenTable(compilationContext *context);
-compilationError dumpToken     (compilationContext *context, node<astNode> *token);
+compilationError dumpToken     (compilationContext *context, size_t         tokenIndex);
+
+// the line a node built at the current token gets, counted from the first line of its declaration
+inline int getNodeLine(const compilationContext *context) {
+    return context->tokens->lines.data[context->tokenIndex] - context->lineBase;
+}
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
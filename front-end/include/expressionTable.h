@@ -0,0 +1,42 @@
+#ifndef EXPRESSION_TABLE_H_
+#define EXPRESSION_TABLE_H_
+
+#include <cstddef>
+
+#include "buffer.h"
+#include "hashTable.h"
+#include "nameTable.h"
+#include "AST.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const size_t EXPRESSION_INITIAL_CAPACITY = 64; // must be a power of two
+
+// pure expressions of one top-level declaration by structure: constants, variable reads and arithmetic over them.
+// the parser asks the table before it keeps such a node, so a repeated expression is never built twice.
+// a shared node keeps the line of its first occurrence and astNode::references counts the parents pointing at it.
+// a node with more than one parent keeps none, whoever needs it takes it from the walk that reached the node, as treeSaver does
+struct expressionTable {
+    hashTable expressions = {}; // values are the node pointers
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError    initializeExpressionTable(expressionTable *table);
+bufferError    destroyExpressionTable   (expressionTable *table);
+// forgets every expression, nothing is shared between two declarations
+bufferError    clearExpressionTable     (expressionTable *table);
+
+// the node of a constant or a variable read with the data of leaf, made only if the table has none yet
+node<astNode> *internLeaf               (expressionTable *table, binaryTree<astNode> *tree, astNode leaf);
+// operation once its operands are linked, or the same operation met before: operation then goes back to the arena of tree.
+// anything that is not a pure operation over shared operands is returned as it is
+node<astNode> *internOperation          (expressionTable *table, binaryTree<astNode> *tree, Buffer<nameTableElement> *nameTable,
+                                         node<astNode> *operation);
+
+// nodeDestruct for a subtree with shared expressions in it: a shared node only loses a reference until the last one goes
+bufferError    releaseSharedSubtree     (binaryTree<astNode> *tree, node<astNode> **subtree);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // EXPRESSION_TABLE_H_
@@ -0,0 +1,31 @@
+#ifndef INCREMENTAL_H_
+#define INCREMENTAL_H_
+
+#include <cstddef>
+
+#include "core.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+struct sourceEdit {
+    size_t      offset         = 0;
+    size_t      removedLength  = 0;
+    const char *insertedText   = NULL;
+    size_t      insertedLength = 0;
+};
+
+enum class editPath {
+    INCREMENTAL = 0, // only the edited function was lexed and parsed again
+    FULL        = 1  // the whole file was
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// applies the edit to an already lexed and parsed context: an edit inside one function relexes and reparses only that
+// function, anything else falls back to a full run; name table indices of existing names never change.
+// path, if not NULL, tells which of the two it was; the first one touches nothing after the function
+compilationError applySourceEdit(compilationContext *context, const sourceEdit *edit, editPath *path);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // INCREMENTAL_H_
@@ -3,12 +3,6 @@
 
 #include "core.h"
 
-enum class stringIntersection {
-    NO_MATCH   = 0,
-    IS_BEGIN   = 1,
-    FULL_MATCH = 2
-};
-
 enum class symbolGroup {
     ENGLISH    = 1 << 0,
     CYRILLIC   = 1 << 1,
@@ -21,6 +15,14 @@ enum class symbolGroup {
     SEPARATOR  = 1 << 8
 };
 
-compilationError lexicalAnalysis(compilationContext *context);
+// sources below this size are not worth the threads, they are always lexed serially
+static const size_t PARALLEL_LEXING_MIN_SIZE   = 1 << 20;
+static const size_t PARALLEL_CHUNKS_PER_THREAD = 4;
+
+compilationError lexicalAnalysis        (compilationContext *context);
+// lexes fileContent[begin, end) into tokens without a terminator, context->currentLine ends at the line of end
+compilationError lexicalAnalysisRange   (compilationContext *context, size_t begin, size_t end, int firstLine, tokenStream *tokens);
+// threadsCount 0 means one thread per hardware thread, the result is the same as lexicalAnalysis
+compilationError lexicalAnalysisParallel(compilationContext *context, size_t threadsCount);
 
 #endif // CORE_H_
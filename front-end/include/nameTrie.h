@@ -0,0 +1,37 @@
+#ifndef NAME_TRIE_H_
+#define NAME_TRIE_H_
+
+#include <cstddef>
+
+#include "buffer.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const size_t TRIE_ROOT    =  0;
+static const size_t TRIE_NO_NODE =  0; // root is never a child, so 0 also means "no transition"
+static const int    TRIE_NO_NAME = -1;
+
+// identifiers as they are interned, keywords never go in: keywordTable.h finds them with no setup at all.
+// children of a node form a singly linked list of siblings inside one node buffer
+struct nameTrieNode {
+    char   symbol      = '\0';
+    size_t firstChild  = TRIE_NO_NODE;
+    size_t nextSibling = TRIE_NO_NODE;
+    int    nameIndex   = TRIE_NO_NAME;
+};
+
+struct nameTrie {
+    Buffer<nameTrieNode> *nodes = {};
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError initializeNameTrie(nameTrie *trie);
+bufferError destroyNameTrie   (nameTrie *trie);
+
+bufferError addNameToTrie     (nameTrie *trie, const char *name,    size_t length, size_t nameIndex);
+size_t      trieStep          (nameTrie *trie, size_t      nodeIndex, const char *symbols, size_t length);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // NAME_TRIE_H_
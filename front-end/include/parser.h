@@ -7,72 +7,53 @@
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-compilationError parseCode    (compilationContext *context);
-node<astNode>   *getExpression(compilationContext *context, int localNameTableID);
+compilationError parseCode         (compilationContext *context);
+// parses the function definition of a declaration again from its relexed tokens, appended to the stream at firstToken,
+// and splices it into the AST; nothing after the declaration is touched
+compilationError reparseDeclaration(compilationContext *context, size_t declarationIndex, size_t firstToken, size_t tokensCount);
+node<astNode>   *getExpression     (compilationContext *context, int localNameTableID);
+
+// a function being parsed again is hidden from lookups under these ids
+static const size_t REPARSED_FUNCTION_NAME  = (size_t) -1;
+static const int    REPARSED_FUNCTION_TABLE = -2;
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-#define DECLARATION_ASSERT(IDENTIFIER, IDENTIFIER_TYPE, ERROR) {    \
-    SYNTAX_ASSERT(isIdentifierDeclared(context, localNameTableID,   \
-    IDENTIFIER->data.data.nameTableIndex, IDENTIFIER_TYPE), ERROR); \
+#define DECLARATION_ASSERT(IDENTIFIER_INDEX, IDENTIFIER_TYPE, ERROR) {  \
+    SYNTAX_ASSERT(isIdentifierDeclared(context, localNameTableID,       \
+    IDENTIFIER_INDEX, IDENTIFIER_TYPE), ERROR);                         \
 }
 
-#define REDECLARATION_ASSERT(IDENTIFIER, IDENTIFIER_TYPE, ERROR) {      \
-    SYNTAX_ASSERT(!isLocalIdentifierDeclared(context, localNameTableID, \
-    IDENTIFIER->data.data.nameTableIndex, IDENTIFIER_TYPE), ERROR);     \
+#define DECLARATION_ASSERT_RETURN(IDENTIFIER_INDEX, IDENTIFIER_TYPE, ERROR, RETURN_VALUE) {  \
+    SYNTAX_ASSERT_RETURN(isIdentifierDeclared(context, localNameTableID,                     \
+    IDENTIFIER_INDEX, IDENTIFIER_TYPE), ERROR, RETURN_VALUE);                                \
 }
 
-#define TRY_GET_OPERATOR(ERROR) {                               \
-    CHECK_FOR_ERROR(expectedOperator, compilationError::ERROR); \
-    if (expectedOperator) {                                     \
-        break;                                                  \
-    }                                                           \
+#define REDECLARATION_ASSERT(IDENTIFIER_INDEX, IDENTIFIER_TYPE, ERROR) {    \
+    SYNTAX_ASSERT(!isLocalIdentifierDeclared(context, localNameTableID,     \
+    IDENTIFIER_INDEX, IDENTIFIER_TYPE), ERROR);                             \
 }
 
-#define SYNTAX_ASSERT(EXPRESSION, ERROR) do {                                \
-    if (!(EXPRESSION)) {                                                     \
-        errorData newError = errorData {                                     \
-            .error = ERROR,                                                  \
-            .line  = context->tokens->data[context->tokenIndex]->data.line,  \
-            .file  = context->tokens->data[context->tokenIndex]->data.file}; \
-                                                                             \
-        writeDataToBuffer(context->errorBuffer, &newError, 1);               \
-        return NULL;                                                         \
-    }                                                                        \
+#define SYNTAX_ASSERT_RETURN(EXPRESSION, ERROR, RETURN_VALUE) do {  \
+    if (!(EXPRESSION)) {                                            \
+        errorData newError = errorData {                            \
+            .error = ERROR,                                         \
+            .line  = currentTokenLine,                              \
+            .file  = context->source->fileName};                    \
+                                                                    \
+        writeDataToBuffer(context->errorBuffer, &newError, 1);      \
+        return RETURN_VALUE;                                        \
+    }                                                               \
 } while (0)
 
-// -------------------------------------------------------------------------------------------------------------------------------------------------- //
-
-#define currentToken context->tokens->data[context->tokenIndex]
-#define currentNameTableIndex currentToken->data.data.nameTableIndex
-
-// -------------------------------------------------------------------------------------------------------------------------------------------------- //
-
-template<typename DT>
-binaryTreeError destroySingleNode(node<DT> *currentNode) {
-    customWarning(currentNode != NULL, binaryTreeError::ROOT_NULL_POINTER);
-
-    FREE_(currentNode);
-
-    return binaryTreeError::NO_ERRORS;
-}
+#define SYNTAX_ASSERT(EXPRESSION, ERROR) SYNTAX_ASSERT_RETURN(EXPRESSION, ERROR, NULL)
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-#define DESTROY_CURRENT_NODE() do {  \
-    destroySingleNode(currentToken); \
-    currentToken = NULL;             \
-} while (0)                 
-
-#define CHECK_FOR_ERROR(NODE, ERROR) do {                                                        \
-    if (!(NODE)) {                                                                               \
-        if (context->errorBuffer->data[context->errorBuffer->currentIndex - 1].error != ERROR) { \
-            return NULL;                                                                         \
-        }                                                                                        \
-                                                                                                 \
-        context->errorBuffer->currentIndex--;                                                    \
-    }                                                                                            \
-} while (0)
+#define currentTokenKind      context->tokens->kinds.data   [context->tokenIndex]
+#define currentTokenKeyword   context->tokens->keywords.data[context->tokenIndex]
+#define currentTokenLine      context->tokens->lines.data   [context->tokenIndex]
+#define currentNameTableIndex context->tokens->values.data  [context->tokenIndex].nameTableIndex
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
@@ -80,8 +61,11 @@ node<astNode> *getStringToken (compilationContext *context, nameType type,    co
 node<astNode> *getKeyword     (compilationContext *context, Keyword  keyword, compilationError error);
 node<astNode> *getConstant    (compilationContext *context);
 node<astNode> *getFunctionCall(compilationContext *context, int localNameTableID);
+node<astNode> *getTokenNode   (compilationContext *context, size_t tokenIndex);
 
-bool getTokenAndDestroy       (compilationContext *context, Keyword keyword,      compilationError error);
+bool getNameIndex             (compilationContext *context, nameType type,        compilationError error, size_t *nameIndex);
+bool isCurrentKeyword         (compilationContext *context, Keyword keyword);
+bool skipKeyword              (compilationContext *context, Keyword keyword,      compilationError error);
 bool isIdentifierDeclared     (compilationContext *context, int localNameTableID, size_t identifierIndex, localNameType identifierType);
 bool isLocalIdentifierDeclared(compilationContext *context, int localNameTableID, size_t identifierIndex, localNameType identifierType);
 
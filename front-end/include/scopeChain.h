@@ -0,0 +1,38 @@
+#ifndef SCOPE_CHAIN_H_
+#define SCOPE_CHAIN_H_
+
+#include <cstddef>
+
+#include "buffer.h"
+#include "nameTable.h"
+#include "hashTable.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// indexes one local name table by globalNameID, the parent of a scope is the one right below it in the chain
+struct nameScope {
+    int       localTableIndex = 0;
+    hashTable elements        = {}; // values are indices in the elements of the scope's local table + 1
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// the chain starts with the scope of the global table
+bufferError initializeScopeChain(Buffer<nameScope> *scopes, int globalTableIndex);
+bufferError destroyScopeChain   (Buffer<nameScope> *scopes);
+
+bufferError pushScope           (Buffer<nameScope> *scopes, int localTableIndex);
+bufferError popScope            (Buffer<nameScope> *scopes);
+
+// writes the element into the local table of the innermost scope, the tables stay what treeSaver serializes
+bufferError declareInScope      (Buffer<nameScope> *scopes, Buffer<localNameTable> *localTables, localNameTableElement newElement);
+// index of the element in the local table of scopes->data[scopeIndex], -1 if it is not declared there
+int         findInScope         (Buffer<nameScope> *scopes, size_t scopeIndex, Buffer<localNameTable> *localTables,
+                                 size_t globalNameID, localNameType nameType);
+bool        isDeclaredInChain   (Buffer<nameScope> *scopes, Buffer<localNameTable> *localTables, size_t globalNameID, localNameType nameType);
+bufferError renameInScope       (Buffer<nameScope> *scopes, size_t scopeIndex, Buffer<localNameTable> *localTables,
+                                 size_t element, size_t globalNameID);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // SCOPE_CHAIN_H_
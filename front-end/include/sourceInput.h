@@ -0,0 +1,56 @@
+#ifndef SOURCE_INPUT_H_
+#define SOURCE_INPUT_H_
+
+#include <cstddef>
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+enum class sourceInputError {
+    NO_ERRORS        = 0,
+    BAD_POINTER      = 1 << 0,
+    FILE_OPEN_ERROR  = 1 << 1,
+    FILE_READ_ERROR  = 1 << 2,
+    ALLOCATION_ERROR = 1 << 3
+};
+
+enum class sourceInputKind {
+    MAPPED   = 1 << 0, // regular file, mapped read-only as a whole
+    STREAMED = 1 << 1, // pipe or stdin, read chunk by chunk on demand
+    EDITED   = 1 << 2  // owned copy of a source that has been edited in place
+};
+
+static const size_t SOURCE_CHUNK_SIZE = 1 << 16;
+
+struct sourceInput {
+    sourceInputKind kind       = sourceInputKind::MAPPED;
+    int             descriptor = -1;
+    const char     *fileName   = NULL; // as given to openSourceInput, "-" for stdin
+
+    char           *data       = NULL; // not null-terminated
+    size_t          size       = 0;
+    size_t          capacity   = 0;
+
+    // an edited source keeps its free space at the last edit, the text from gapBegin on is gapLength bytes further
+    size_t          gapBegin   = 0;
+    size_t          gapLength  = 0;
+
+    bool            isComplete = false;
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// fileName "-" or NULL reads stdin
+sourceInputError openSourceInput (sourceInput *input, const char *fileName);
+sourceInputError readSourceChunk (sourceInput *input);
+sourceInputError closeSourceInput(sourceInput *input);
+
+// replaces the text [offset, offset + removedLength) with text, a mapped or streamed source is copied on the first edit.
+// only the bytes between the gap and the edit are moved
+sourceInputError editSourceInput (sourceInput *input, size_t offset, size_t removedLength, const char *text, size_t textLength);
+
+// the text before offset is data[0, offset) afterwards, offset = size makes the whole text contiguous
+sourceInputError moveSourceGap   (sourceInput *input, size_t offset);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // SOURCE_INPUT_H_
@@ -0,0 +1,16 @@
+#ifndef SYMBOL_CLASSIFIER_H_
+#define SYMBOL_CLASSIFIER_H_
+
+#include <cstddef>
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// both functions scan text[begin, end) and return the length of the run that starts at begin,
+// the implementation (AVX2, SSE2 or scalar) is picked once at runtime with cpuid
+
+size_t getSpaceRunLength     (const char *text, size_t begin, size_t end, int *lineCount);
+size_t getIdentifierRunLength(const char *text, size_t begin, size_t end);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // SYMBOL_CLASSIFIER_H_
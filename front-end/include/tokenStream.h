@@ -0,0 +1,40 @@
+#ifndef TOKEN_STREAM_H_
+#define TOKEN_STREAM_H_
+
+#include <cstddef>
+
+#include "buffer.h"
+#include "nameTable.h"
+#include "AST.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+enum class tokenKind : unsigned char {
+    TERMINATOR = 0,
+    CONSTANT   = 1,
+    NAME       = 2
+};
+
+// parallel arrays indexed by token number, the parser materializes AST nodes only for tokens it keeps
+struct tokenStream {
+    Buffer<tokenKind> kinds    = {};
+    Buffer<Keyword>   keywords = {}; // resolved by the lexer, Keyword::UNDEFINED for identifiers and constants
+    Buffer<nodeData>  values   = {}; // name table index or constant value
+    Buffer<int>       lines    = {};
+    Buffer<size_t>    offsets  = {}; // offset of the token in the source
+
+    size_t count = 0;
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError initializeTokenStream(tokenStream *stream);
+bufferError destroyTokenStream   (tokenStream *stream);
+
+bufferError addToken             (tokenStream *stream, tokenKind kind, Keyword keyword, nodeData value, int line, size_t offset);
+// replaces removedCount tokens at position with the first insertedCount tokens of inserted
+bufferError spliceTokens         (tokenStream *stream, size_t position, size_t removedCount, const tokenStream *inserted, size_t insertedCount);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // TOKEN_STREAM_H_
@@ -24,12 +24,23 @@ enum class saveDataError {
     NAME_TABLE_BAD_POINTER   = 14,
 };
 
+static const size_t SAVE_STREAM_SIZE = 1 << 16;
+
+// a fixed block of output that goes to the file whenever it fills up, so saving takes the same memory for any program
+struct saveStream {
+    int     descriptor     = -1;
+    int     echoDescriptor = -1;   // gets every block as well when set
+    char   *data           = NULL; // SAVE_STREAM_SIZE bytes
+    size_t  size           = 0;
+    bool    isFailed       = false;
+};
+
 struct saveDataContext {
-    Buffer<char> *NTBuffer   = {};
-    char         *NTFileName = {};
+    saveStream NTStream   = {};
+    char      *NTFileName = {};
 
-    Buffer<char> *ASTBuffer   = {};
-    char         *ASTFileName = {};
+    saveStream ASTStream   = {};
+    char      *ASTFileName = {};
 };
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -47,7 +58,13 @@ saveDataError saveLocalNameTable(compilationContext *context, saveDataContext *s
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
 saveDataError saveASTTree   (compilationContext *context, saveDataContext *saveContext);
-saveDataError saveASTSubtree(compilationContext *context, saveDataContext *saveContext, node<astNode> *node, size_t keywordsCount);
+saveDataError saveASTSubtree(compilationContext *context, saveDataContext *saveContext, node<astNode> *subtree, size_t keywordsCount);
 saveDataError saveASTNode   (compilationContext *context, saveDataContext *saveContext, node<astNode> *node, size_t keywordsCount);
 
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// the image is what the driver caches: a change to its layout needs COMPILER_VERSION in compilationCache.h bumped
+saveDataError buildBinaryAST(compilationContext *context, Buffer<char> *image);
+saveDataError saveBinaryAST (compilationContext *context, const char *fileName);
+
 #endif // TREE_SAVER_H_
\ No newline at end of file
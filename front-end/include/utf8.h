@@ -0,0 +1,18 @@
+#ifndef UTF8_H_
+#define UTF8_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const size_t UTF8_MAX_SYMBOL_LENGTH = 4;
+
+// returns the number of bytes in the symbol at text[0], 0 if the sequence is malformed or cut off by available
+size_t decodeUtf8Symbol   (const char *text, size_t available, uint32_t *codePoint);
+
+bool   isCyrillicCodePoint(uint32_t codePoint);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#endif // UTF8_H_
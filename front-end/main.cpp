@@ -5,40 +5,80 @@
 #include "lexer.h"
 #include "parser.h"
 #include <stdio.h>
+#include <string.h>
+#include <unistd.h>
 #include "astDump.h"
 #include "treeSaver.h"
+#include "binaryAST.h"
+#include "sourceInput.h"
+
+static const char *DEFAULT_SOURCE_FILE    = "tests/factorial.prison";
+static const char *SHARE_EXPRESSIONS_FLAG = "--share-expressions";
+static const char *TEXT_AST_FLAG          = "--text-ast";
 
 int main(int argc, char *argv[]) {
-    
-    Buffer<char> fileContentBuffer = {};
-    writeFileDataToBuffer(&fileContentBuffer, "tests/factorial.prison");
+    const char *sourceFileName   = DEFAULT_SOURCE_FILE;
+    bool        sharingEnabled   = false;
+    bool        textAST          = false;
 
-    compilationContext context = {};
-    initializeCompilationContext(&context, fileContentBuffer.data);
+    for (int argumentIndex = 1; argumentIndex < argc; argumentIndex++) {
+        if (strcmp(argv[argumentIndex], SHARE_EXPRESSIONS_FLAG) == 0) {
+            sharingEnabled = true;
+        } else if (strcmp(argv[argumentIndex], TEXT_AST_FLAG) == 0) {
+            textAST = true;
+        } else {
+            sourceFileName = argv[argumentIndex];
+        }
+    }
+
+    sourceInput source = {};
+
+    if (openSourceInput(&source, sourceFileName) != sourceInputError::NO_ERRORS) {
+        fprintf(stderr, "can't open source file \"%s\"\n", sourceFileName);
+        return 1;
+    }
 
-    lexicalAnalysis(&context);
+    compilationContext context = {};
+    initializeCompilationContext(&context, &source);
 
-    for (int i = 0; i < context.tokens->currentIndex; i++) {
-        dumpToken(&context, context.tokens->data[i]);
+    if (sharingEnabled) {
+        enableExpressionSharing(&context);
     }
 
+    lexicalAnalysisParallel(&context, 0);
+
+    dumpTokenTable(&context);
+
     parseCode(&context);
 
     dumpContext dumpCtxt = {};
     dumpTree(&context, &dumpCtxt, context.AST);
     
-    saveDataContext saveCtxt = {};
-    initializeSaveDataContext(&saveCtxt, getFileName(), getFileName());
-    saveNameTable(&context, &saveCtxt);
+    char *binaryFileName = getFileName();
 
-    // printf("%s", saveCtxt.NTBuffer->data);
+    if (binaryFileName) {
+        strcat(binaryFileName, BINARY_AST_EXTENSION);
+        saveBinaryAST(&context, binaryFileName);
+        FREE_(binaryFileName);
+    }
 
-    saveASTTree(&context, &saveCtxt);   
+    // the back-end maps the binary file, the text one is only there to be read
+    if (textAST) {
+        saveDataContext saveCtxt = {};
+        initializeSaveDataContext(&saveCtxt, getFileName(), getFileName());
+        saveNameTable(&context, &saveCtxt);
 
-    printf("%s", saveCtxt.ASTBuffer->data);
+        // the tree is echoed block by block as it is saved, after everything printf has kept so far
+        fflush(stdout);
+        saveCtxt.ASTStream.echoDescriptor = STDOUT_FILENO;
+
+        saveASTTree(&context, &saveCtxt);
+
+        destroySaveDataContext(&saveCtxt);
+    }
 
-    destroySaveDataContext(&saveCtxt);
     destroyCompilationContext(&context);
+    closeSourceInput(&source);
 
     return 0;
 }
\ No newline at end of file
@@ -4,8 +4,11 @@
 #include "astDump.h"
 #include "binaryTreeDef.h"
 #include "customWarning.h"
+#include "astVisitor.h"
 #include <time.h>
-    
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
 dumpError initializeDumpContext(dumpContext *dumpContext, char *fileName) {
     customWarning(dumpContext,  dumpError::CONTEXT_BAD_POINTER);
 
@@ -78,19 +81,32 @@ dumpError dumpTree(compilationContext *context, dumpContext *dumpContext, binary
     dumpError error = initializeDumpContext(dumpContext, fileName);
     customWarning(error == dumpError::NO_ERRORS, dumpError::INITIALIZATION_ERROR);
 
-    node<astNode> *root = tree->root;
-    customWarning(root, dumpError::NODE_BAD_POINTER);
+    customWarning(tree->root, dumpError::NODE_BAD_POINTER);
+
+    // the dump walks the flat copy, every node gets its own record even if the parser shares it
+    compactAST compactTree = {};
+
+    if (initializeCompactAST(&compactTree) != bufferError::NO_BUFFER_ERROR ||
+        buildCompactAST(&compactTree, tree->root) != bufferError::NO_BUFFER_ERROR) {
+        destroyCompactAST(&compactTree);
+        FREE_(fileName);
+
+        return dumpError::ALLOCATION_ERROR;
+    }
+
+    compactNode *root = getCompactNode(&compactTree, compactTree.root);
 
     SET_DOT_HEADER(dumpContext);
 
-    if (root->left) {
-        dumpNode(context, dumpContext, root->left);
+    if (root->left != AST_NO_NODE) {
+        dumpNode(context, dumpContext, &compactTree, root->left);
     }
 
-    if (root->right) {
-        dumpNode(context, dumpContext, root->right);
+    if (root->right != AST_NO_NODE) {
+        dumpNode(context, dumpContext, &compactTree, root->right);
     }
 
+    destroyCompactAST(&compactTree);
     FREE_(fileName);
 
     SET_DOT_FOOTER(dumpContext);
@@ -118,128 +134,134 @@ static int findIdentifierInLocalTable(compilationContext *context, node<astNode>
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-#define SET_LINKS(DUMP_CONTEXT, NODE) do {                                         \
-    if ((NODE)->left) {                                                            \
-        fprintf((DUMP_CONTEXT)->file, "p%p:<l> -> p%p;\n", (NODE), (NODE)->left);  \
-    }                                                                              \
-    if ((NODE)->right) {                                                           \
-        fprintf((DUMP_CONTEXT)->file, "p%p:<l> -> p%p;\n", (NODE), (NODE)->right); \
-    }                                                                              \
+#define SET_LINKS(DUMP_CONTEXT, TREE, NODE) do {                                                 \
+    if ((NODE)->left != AST_NO_NODE) {                                                           \
+        fprintf((DUMP_CONTEXT)->file, "p%p:<l> -> p%p;\n", (NODE), getCompactLeft(TREE, NODE));  \
+    }                                                                                            \
+    if ((NODE)->right != AST_NO_NODE) {                                                          \
+        fprintf((DUMP_CONTEXT)->file, "p%p:<l> -> p%p;\n", (NODE), getCompactRight(TREE, NODE)); \
+    }                                                                                            \
 } while (0)
 
-#define DUMP_TERMINATOR(CONTEXT, DUMP_CONTEXT, NODE) do {                   \
-    fprintf((DUMP_CONTEXT)->file,                                           \
-    "p%p [label = \" { TERMINATOR | { %p | %p } } \","                      \
-    "style=\"filled\", fillcolor=\"lightgrey\", width=2.0];\n",             \
-    (NODE), (NODE)->left, (NODE)->right);                                   \
-    SET_LINKS(DUMP_CONTEXT, NODE);                                          \
+#define DUMP_TERMINATOR(DUMP_CONTEXT, TREE, NODE) do {                                     \
+    fprintf((DUMP_CONTEXT)->file,                                                          \
+    "p%p [label = \" { TERMINATOR | { %p | %p } } \","                                     \
+    "style=\"filled\", fillcolor=\"lightgrey\", width=2.0];\n",                            \
+    (NODE), getCompactLeft(TREE, NODE), getCompactRight(TREE, NODE));                      \
+    SET_LINKS(DUMP_CONTEXT, TREE, NODE);                                                   \
 } while (0)
 
-#define DUMP_CONSTANT(CONTEXT, DUMP_CONTEXT, NODE) do {                     \
-    fprintf((DUMP_CONTEXT)->file,                                           \
-    "p%p [label = \" { CONSTANT: %d | { %p | %p } } \","                    \
-    "style=\"filled\", fillcolor=\"lightblue\", width=2.0];\n",             \
-    (NODE), (NODE)->data.data.number, (NODE)->left, (NODE)->right);         \
-    SET_LINKS(DUMP_CONTEXT, NODE);                                          \
+#define DUMP_CONSTANT(DUMP_CONTEXT, TREE, NODE) do {                                       \
+    fprintf((DUMP_CONTEXT)->file,                                                          \
+    "p%p [label = \" { CONSTANT: %d | { %p | %p } } \","                                   \
+    "style=\"filled\", fillcolor=\"lightblue\", width=2.0];\n",                            \
+    (NODE), (NODE)->data.number, getCompactLeft(TREE, NODE), getCompactRight(TREE, NODE)); \
+    SET_LINKS(DUMP_CONTEXT, TREE, NODE);                                                   \
 } while (0)
 
-#define DUMP_STRING(CONTEXT, DUMP_CONTEXT, NODE, NAME, TYPE) do {           \
-    fprintf((DUMP_CONTEXT)->file,                                           \
-    "p%p [label = \" { %s:\\n%s | { %p | %p } } \","                        \
-    "style=\"filled\", fillcolor=\"lightgreen\", width=2.0];\n",            \
-    (NODE), #TYPE, NAME, (NODE)->left, (NODE)->right);                      \
-    SET_LINKS(DUMP_CONTEXT, NODE);                                          \
+#define DUMP_STRING(DUMP_CONTEXT, TREE, NODE, NAME, TYPE) do {                             \
+    fprintf((DUMP_CONTEXT)->file,                                                          \
+    "p%p [label = \" { %s:\\n%s | { %p | %p } } \","                                       \
+    "style=\"filled\", fillcolor=\"lightgreen\", width=2.0];\n",                           \
+    (NODE), #TYPE, NAME, getCompactLeft(TREE, NODE), getCompactRight(TREE, NODE));         \
+    SET_LINKS(DUMP_CONTEXT, TREE, NODE);                                                   \
 } while (0)
 
-#define DUMP_FUNCTION_DEFINITION(CONTEXT, DUMP_CONTEXT, NODE, NAME) do {    \
-    fprintf((DUMP_CONTEXT)->file,                                           \
-    "p%p [label = \" { FUNCTION: %s | { %p | %p } } \","                    \
-    "style=\"filled\", fillcolor=\"yellow\", width=2.0];\n",                \
-    (NODE), (NAME), (NODE)->left, (NODE)->right);                           \
-    SET_LINKS(DUMP_CONTEXT, NODE);                                          \
+#define DUMP_FUNCTION_DEFINITION(DUMP_CONTEXT, TREE, NODE, NAME) do {                      \
+    fprintf((DUMP_CONTEXT)->file,                                                          \
+    "p%p [label = \" { FUNCTION: %s | { %p | %p } } \","                                   \
+    "style=\"filled\", fillcolor=\"yellow\", width=2.0];\n",                               \
+    (NODE), (NAME), getCompactLeft(TREE, NODE), getCompactRight(TREE, NODE));              \
+    SET_LINKS(DUMP_CONTEXT, TREE, NODE);                                                   \
 } while (0)
 
-#define DUMP_PARAMETERS(CONTEXT, DUMP_CONTEXT, NODE) do {                   \
-    fprintf((DUMP_CONTEXT)->file,                                           \
-    "p%p [label = \" { PARAMETERS | { %p | %p } } \","                      \
-    "style=\"filled\", fillcolor=\"orange\", width=2.0];\n",                \
-    (NODE), (NODE)->left, (NODE)->right);                                   \
-    SET_LINKS(DUMP_CONTEXT, NODE);                                          \
+#define DUMP_PARAMETERS(DUMP_CONTEXT, TREE, NODE) do {                                     \
+    fprintf((DUMP_CONTEXT)->file,                                                          \
+    "p%p [label = \" { PARAMETERS | { %p | %p } } \","                                     \
+    "style=\"filled\", fillcolor=\"orange\", width=2.0];\n",                               \
+    (NODE), getCompactLeft(TREE, NODE), getCompactRight(TREE, NODE));                      \
+    SET_LINKS(DUMP_CONTEXT, TREE, NODE);                                                   \
 } while (0)
 
-#define DUMP_VARIABLE_DECLARATION(CONTEXT, DUMP_CONTEXT, NODE, NAME) do {   \
-    fprintf((DUMP_CONTEXT)->file,                                           \
-    "p%p [label = \" { VARIABLE: %s | { %p | %p } } \","                    \
-    "style=\"filled\", fillcolor=\"pink\", width=2.0];\n",                  \
-    (NODE), (NAME), (NODE)->left, (NODE)->right);                           \
-    SET_LINKS(DUMP_CONTEXT, NODE);                                          \
+#define DUMP_VARIABLE_DECLARATION(DUMP_CONTEXT, TREE, NODE, NAME) do {                     \
+    fprintf((DUMP_CONTEXT)->file,                                                          \
+    "p%p [label = \" { VARIABLE: %s | { %p | %p } } \","                                   \
+    "style=\"filled\", fillcolor=\"pink\", width=2.0];\n",                                 \
+    (NODE), (NAME), getCompactLeft(TREE, NODE), getCompactRight(TREE, NODE));              \
+    SET_LINKS(DUMP_CONTEXT, TREE, NODE);                                                   \
 } while (0)
 
-#define DUMP_FUNCTION_CALL(CONTEXT, DUMP_CONTEXT, NODE) do {                \
-    fprintf((DUMP_CONTEXT)->file,                                           \
-    "p%p [label = \" { FUNCTION_CALL | { %p | %p } } \","                   \
-    "style=\"filled\", fillcolor=\"cyan\", width=2.0];\n",                  \
-    (NODE), (NODE)->left, (NODE)->right);                                   \
-    SET_LINKS(DUMP_CONTEXT, NODE);                                          \
+#define DUMP_FUNCTION_CALL(DUMP_CONTEXT, TREE, NODE) do {                                  \
+    fprintf((DUMP_CONTEXT)->file,                                                          \
+    "p%p [label = \" { FUNCTION_CALL | { %p | %p } } \","                                  \
+    "style=\"filled\", fillcolor=\"cyan\", width=2.0];\n",                                 \
+    (NODE), getCompactLeft(TREE, NODE), getCompactRight(TREE, NODE));                      \
+    SET_LINKS(DUMP_CONTEXT, TREE, NODE);                                                   \
 } while (0)
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-dumpError dumpNode(compilationContext *context, dumpContext *dumpContext, node<astNode> *node) {
-    customWarning(context,           dumpError::CONTEXT_BAD_POINTER);
-    customWarning(dumpContext,       dumpError::DUMP_CONTEXT_BAD_POINTER);
-    customWarning(node,              dumpError::NODE_BAD_POINTER);
-    customWarning(dumpContext->file, dumpError::FILE_BAD_POINTER);
+// every separator is dumped as a name, so keywords are never told apart here
+struct astNodeDumper : compactVisitor<astNodeDumper, dumpError> {
+    compilationContext *context = NULL;
+    dumpContext        *dump    = NULL;
+    compactAST         *tree    = NULL;
 
-    if (node->left) {
-        dumpNode(context, dumpContext, node->left);
+    dumpError visitTerminator(compactNode *currentNode) {
+        DUMP_TERMINATOR(dump, tree, currentNode);
+        return dumpError::NO_ERRORS;
     }
 
-    if (node->right) {
-        dumpNode(context, dumpContext, node->right);
+    dumpError visitConstant(compactNode *currentNode) {
+        DUMP_CONSTANT(dump, tree, currentNode);
+        return dumpError::NO_ERRORS;
     }
 
-    switch (node->data.type) {
-        case nodeType::TERMINATOR:           DUMP_TERMINATOR          (context, dumpContext, node); break;
-        case nodeType::CONSTANT:             DUMP_CONSTANT            (context, dumpContext, node); break;
-
-        case nodeType::STRING: {
-            char *name = context->nameTable->data[node->data.data.nameTableIndex].name;
-            int      nameTableIndex = node->data.data.nameTableIndex;
-            nameType nodeNameType   = context->nameTable->data[nameTableIndex].type;
+    dumpError visitString(compactNode *currentNode) {
+        char *name = context->nameTable->data[currentNode->data.nameTableIndex].name;
 
-            switch (nodeNameType) {
-                case nameType::IDENTIFIER:   DUMP_STRING              (context, dumpContext, node, name, nameType::IDENTIFIER); break;
-                case nameType::OPERATOR:     DUMP_STRING              (context, dumpContext, node, name, nameType::OPERATOR);   break;
-                case nameType::TYPE_NAME:    DUMP_STRING              (context, dumpContext, node, name, nameType::TYPE_NAME);  break;
-                case nameType::SEPARATOR:    DUMP_STRING              (context, dumpContext, node, name, nameType::SEPARATOR);  break;
-            }   
-
-            break;
+        switch (context->nameTable->data[currentNode->data.nameTableIndex].type) {
+            case nameType::IDENTIFIER: DUMP_STRING(dump, tree, currentNode, name, nameType::IDENTIFIER); break;
+            case nameType::OPERATOR:   DUMP_STRING(dump, tree, currentNode, name, nameType::OPERATOR);   break;
+            case nameType::TYPE_NAME:  DUMP_STRING(dump, tree, currentNode, name, nameType::TYPE_NAME);  break;
+            case nameType::SEPARATOR:  DUMP_STRING(dump, tree, currentNode, name, nameType::SEPARATOR);  break;
         }
 
-        case nodeType::FUNCTION_DEFINITION: {
-            int      nameTableIndex = node->data.data.nameTableIndex;
-            char *name = context->nameTable->data[nameTableIndex].name;
-                                             DUMP_FUNCTION_DEFINITION (context, dumpContext, node, name);
+        return dumpError::NO_ERRORS;
+    }
 
-            break;
-        } 
-            
-        case nodeType::PARAMETERS:           DUMP_PARAMETERS          (context, dumpContext, node); break;
+    dumpError visitFunctionDefinition(compactNode *currentNode) {
+        DUMP_FUNCTION_DEFINITION(dump, tree, currentNode, context->nameTable->data[currentNode->data.nameTableIndex].name);
+        return dumpError::NO_ERRORS;
+    }
 
-        case nodeType::VARIABLE_DECLARATION: {
-            int      nameTableIndex = node->data.data.nameTableIndex;
-            char *name = context->nameTable->data[nameTableIndex].name;
-                                             DUMP_VARIABLE_DECLARATION(context, dumpContext, node, name);
+    dumpError visitParameters(compactNode *currentNode) {
+        DUMP_PARAMETERS(dump, tree, currentNode);
+        return dumpError::NO_ERRORS;
+    }
 
-            break;                                               
-        }
-        
-        case nodeType::FUNCTION_CALL:        DUMP_FUNCTION_CALL       (context, dumpContext, node); break;
+    dumpError visitVariableDeclaration(compactNode *currentNode) {
+        DUMP_VARIABLE_DECLARATION(dump, tree, currentNode, context->nameTable->data[currentNode->data.nameTableIndex].name);
+        return dumpError::NO_ERRORS;
+    }
 
-        default:                             break;
+    dumpError visitFunctionCall(compactNode *currentNode) {
+        DUMP_FUNCTION_CALL(dump, tree, currentNode);
+        return dumpError::NO_ERRORS;
     }
+};
+
+// children are dumped before their parent, as the links of a node point to already declared ones
+dumpError dumpNode(compilationContext *context, dumpContext *dumpContext, compactAST *tree, astHandle subtree) {
+    customWarning(context,                dumpError::CONTEXT_BAD_POINTER);
+    customWarning(dumpContext,            dumpError::DUMP_CONTEXT_BAD_POINTER);
+    customWarning(tree,                   dumpError::TREE_BAD_POINTER);
+    customWarning(subtree != AST_NO_NODE, dumpError::NODE_BAD_POINTER);
+    customWarning(dumpContext->file,      dumpError::FILE_BAD_POINTER);
+
+    astNodeDumper dumper = {{}, context, dumpContext, tree};
+
+    customWarning(visitCompactAST(tree, subtree, printType::POSTFIX, &dumper) == bufferError::NO_BUFFER_ERROR, dumpError::ALLOCATION_ERROR);
 
     return dumpError::NO_ERRORS;
 }
@@ -1,8 +1,7 @@
-#include <cstring>
-
 #include "core.h"
 #include "buffer.h"
 #include "nameTable.h"
+#include "nameTrie.h"
 #include "AST.h"
 #include "binaryTreeDef.h"
 
@@ -10,36 +9,56 @@ static const char *nameTypeToString(nameType type);
 
 static const bool GLOBAL = true;
 
-compilationError initializeCompilationContext(compilationContext *context, char *fileContent) {
-    customWarning(context,     compilationError::CONTEXT_ERROR);
-    customWarning(fileContent, compilationError::CONTEXT_ERROR);
+compilationError initializeCompilationContext(compilationContext *context, sourceInput *source) {
+    customWarning(context, compilationError::CONTEXT_ERROR);
+    customWarning(source,  compilationError::CONTEXT_ERROR);
 
     context->localTables = (Buffer<localNameTable> *)calloc(1, sizeof(Buffer<localNameTable>));
     customWarning(context->localTables, compilationError::ALLOCATION_ERROR);
 
+    context->scopes = (Buffer<nameScope> *)calloc(1, sizeof(Buffer<nameScope>));
+    customWarning(context->scopes, compilationError::ALLOCATION_ERROR);
+
     context->nameTable = (Buffer<nameTableElement> *)calloc(1, sizeof(Buffer<nameTableElement>));
     customWarning(context->nameTable, compilationError::ALLOCATION_ERROR);
 
-    context->tokens = (Buffer<node<astNode> *> *)calloc(1, sizeof(Buffer<node<astNode> *>));
+    context->interner = (nameInterner *)calloc(1, sizeof(nameInterner));
+    customWarning(context->interner, compilationError::ALLOCATION_ERROR);
+
+    context->tokens = (tokenStream *)calloc(1, sizeof(tokenStream));
     customWarning(context->tokens, compilationError::ALLOCATION_ERROR);
 
+    context->trie = (nameTrie *)calloc(1, sizeof(nameTrie));
+    customWarning(context->trie, compilationError::ALLOCATION_ERROR);
+
     context->errorBuffer = (Buffer<errorData> *)calloc(1, sizeof(Buffer<errorData>));
     customWarning(context->errorBuffer, compilationError::ALLOCATION_ERROR);
 
     context->functionCalls = (Buffer<node<astNode> *> *)calloc(1, sizeof(Buffer<node<astNode> *>));
     customWarning(context->functionCalls, compilationError::ALLOCATION_ERROR);
 
+    context->declarations = (Buffer<declarationRange> *)calloc(1, sizeof(Buffer<declarationRange>));
+    customWarning(context->declarations, compilationError::ALLOCATION_ERROR);
+
     if (bufferInitialize(context->localTables) != bufferError::NO_BUFFER_ERROR) {
         return compilationError::CONTEXT_ERROR;
     }
 
     addLocalNameTable(-1, context->localTables);
 
-    if (initializeNameTable(context->nameTable, GLOBAL) != bufferError::NO_BUFFER_ERROR) {
+    if (initializeScopeChain(context->scopes, 0) != bufferError::NO_BUFFER_ERROR) {
+        return compilationError::CONTEXT_ERROR;
+    }
+
+    if (initializeNameTable(context->nameTable, context->interner, GLOBAL) != bufferError::NO_BUFFER_ERROR) {
+        return compilationError::CONTEXT_ERROR;
+    }
+
+    if (initializeNameTrie(context->trie) != bufferError::NO_BUFFER_ERROR) {
         return compilationError::CONTEXT_ERROR;
     }
 
-    if (bufferInitialize(context->tokens) != bufferError::NO_BUFFER_ERROR) {
+    if (initializeTokenStream(context->tokens) != bufferError::NO_BUFFER_ERROR) {
         return compilationError::TOKEN_BUFFER_ERROR;
     }
 
@@ -51,13 +70,18 @@ compilationError initializeCompilationContext(compilationContext *context, char
         return compilationError::CONTEXT_ERROR;
     }
 
+    if (bufferInitialize(context->declarations) != bufferError::NO_BUFFER_ERROR) {
+        return compilationError::CONTEXT_ERROR;
+    }
+
     context->error = compilationError::NO_ERRORS;
 
     context->AST = (binaryTree<astNode> *)calloc(1, sizeof(binaryTree<astNode>));
     customWarning(context->AST, compilationError::ALLOCATION_ERROR);
 
-    context->fileContent = fileContent;
-    context->fileSize = strlen(fileContent);
+    context->source      = source;
+    context->fileContent = source->data;
+    context->fileSize    = source->size;
     context->currentLine = 1;
 
     return compilationError::NO_ERRORS;
@@ -67,19 +91,8 @@ compilationError destroyCompilationContext(compilationContext *context) {
     customWarning(context, compilationError::CONTEXT_ERROR);
 
     if (context->AST) {
-        if (context->AST->root) {
-            nodeDestruct(context->AST, &context->AST->root);
-        } else {
-            for (size_t tokenIndex = 0; tokenIndex < context->tokens->currentIndex; tokenIndex++) {
-                FREE_(context->tokens->data[tokenIndex]);
-            }
-        }
-    }
-
-    for (size_t nameIndex = 0; nameIndex < context->nameTable->currentIndex; nameIndex++) {
-        if (context->nameTable->data[nameIndex].type == nameType::IDENTIFIER) {
-            FREE_(context->nameTable->data[nameIndex].name);
-        }
+        treeNodesDestruct(context->AST);
+        FREE_(context->AST);
     }
 
     for (size_t localTableIndex = 0; localTableIndex < context->localTables->currentIndex; localTableIndex++) {
@@ -87,36 +100,89 @@ compilationError destroyCompilationContext(compilationContext *context) {
     }
 
     bufferDestruct(context->localTables);
-    bufferDestruct(context->nameTable);
+    destroyScopeChain(context->scopes);
+    FREE_(context->scopes);
+    destroyNameTable(context->nameTable, context->interner);
     bufferDestruct(context->errorBuffer);
-    bufferDestruct(context->tokens);
+    destroyTokenStream(context->tokens);
+    FREE_(context->tokens);
     bufferDestruct(context->functionCalls);
+    bufferDestruct(context->declarations);
+    FREE_(context->declarations);
+
+    destroyNameTrie(context->trie);
+    FREE_(context->trie);
 
-    FREE_(context->fileContent);
+    if (context->expressions) {
+        destroyExpressionTable(context->expressions);
+        FREE_(context->expressions);
+    }
+
+    FREE_(context->interner);
+
+    context->source      = NULL;
+    context->fileContent = NULL;
+    context->fileSize    = 0;
 
     return compilationError::NO_ERRORS;
 }
 
-compilationError dumpTokenTable(compilationContext *context) {
+// must be called before parseCode, every declaration parsed after it interns its pure expressions as it is built
+compilationError enableExpressionSharing(compilationContext *context) {
     customWarning(context, compilationError::CONTEXT_ERROR);
 
-    for (size_t tokenIndex = 0; tokenIndex < context->tokens->currentIndex; tokenIndex++) {
-        dumpToken(context, context->tokens->data[tokenIndex]);
+    if (context->expressions) {
+        return compilationError::NO_ERRORS;
+    }
+
+    context->expressions = (expressionTable *)calloc(1, sizeof(expressionTable));
+    customWarning(context->expressions, compilationError::ALLOCATION_ERROR);
+
+    if (initializeExpressionTable(context->expressions) != bufferError::NO_BUFFER_ERROR) {
+        FREE_(context->expressions);
+        return compilationError::ALLOCATION_ERROR;
     }
 
     return compilationError::NO_ERRORS;
 }
 
-compilationError dumpToken(compilationContext *context, node<astNode> *token) {
+compilationError getASTHandoff(compilationContext *context, astHandoff *handoff) {
+    customWarning(context,      compilationError::CONTEXT_ERROR);
+    customWarning(handoff,      compilationError::CONTEXT_ERROR);
+    customWarning(context->AST, compilationError::CONTEXT_ERROR);
+
+    handoff->AST           = context->AST;
+    handoff->nameTable     = context->nameTable;
+    handoff->localTables   = context->localTables;
+    handoff->keywordsCount = getKeywordsCount(context->nameTable);
+    handoff->entryPoint    = context->entryPoint;
+
+    return compilationError::NO_ERRORS;
+}
+
+compilationError dumpTokenTable(compilationContext *context) {
     customWarning(context, compilationError::CONTEXT_ERROR);
-    customWarning(token,   compilationError::CONTEXT_ERROR);
 
-    if (token->data.type == nodeType::CONSTANT) {
-        customPrint(green, bold, bgDefault, "Constant: %d\n", token->data.data.number);
-    } else if (token->data.type == nodeType::STRING) {
+    for (size_t tokenIndex = 0; tokenIndex < context->tokens->count; tokenIndex++) {
+        dumpToken(context, tokenIndex);
+    }
+
+    return compilationError::NO_ERRORS;
+}
+
+compilationError dumpToken(compilationContext *context, size_t tokenIndex) {
+    customWarning(context,                              compilationError::CONTEXT_ERROR);
+    customWarning(tokenIndex < context->tokens->count, compilationError::TOKEN_BUFFER_ERROR);
+
+    tokenKind kind  = context->tokens->kinds.data [tokenIndex];
+    nodeData  value = context->tokens->values.data[tokenIndex];
+
+    if (kind == tokenKind::CONSTANT) {
+        customPrint(green, bold, bgDefault, "Constant: %d\n", value.number);
+    } else if (kind == tokenKind::NAME) {
         customPrint(blue, bold, bgDefault, "Name: (type: \"%-10s\") <%s>\n",
-                    nameTypeToString(context->nameTable->data[token->data.data.nameTableIndex].type),
-                    context->nameTable->data[token->data.data.nameTableIndex].name);
+                    nameTypeToString(context->nameTable->data[value.nameTableIndex].type),
+                    context->nameTable->data[value.nameTableIndex].name);
     } else {
         customPrint(purple, bold, bgDefault, "Service Node\n");
     }
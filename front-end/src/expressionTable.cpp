@@ -0,0 +1,196 @@
+#include <cstdint>
+
+#include "customWarning.h"
+#include "expressionTable.h"
+#include "keywordTable.h"
+#include "buffer.h"
+#include "binaryTree.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static bool           isPureOperation   (Buffer<nameTableElement> *nameTable, node<astNode> *operation);
+static bool           areSameExpressions(const astNode *first, node<astNode> *firstLeft, node<astNode> *firstRight, node<astNode> *second);
+static uint32_t       hashExpression    (const astNode *expression, node<astNode> *left, node<astNode> *right);
+static node<astNode> *findExpression    (expressionTable *table, uint32_t hash, const astNode *expression,
+                                         node<astNode> *left, node<astNode> *right);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError initializeExpressionTable(expressionTable *table) {
+    customWarning(table, bufferError::POINTER_IS_NULL);
+
+    return initializeHashTable(&table->expressions, EXPRESSION_INITIAL_CAPACITY);
+}
+
+bufferError destroyExpressionTable(expressionTable *table) {
+    customWarning(table, bufferError::POINTER_IS_NULL);
+
+    return destroyHashTable(&table->expressions);
+}
+
+bufferError clearExpressionTable(expressionTable *table) {
+    customWarning(table, bufferError::POINTER_IS_NULL);
+
+    return clearHashTable(&table->expressions);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+node<astNode> *internLeaf(expressionTable *table, binaryTree<astNode> *tree, astNode leaf) {
+    customWarning(table, NULL);
+    customWarning(tree,  NULL);
+
+    uint32_t       hash   = hashExpression(&leaf, NULL, NULL);
+    node<astNode> *shared = findExpression(table, hash, &leaf, NULL, NULL);
+
+    if (shared) {
+        shared->data.references++;
+        shared->parent = NULL;
+
+        return shared;
+    }
+
+    leaf.references = 1;
+
+    node<astNode> *newLeaf = emplaceNode(tree, node<astNode> {.data = leaf, .left = NULL, .right = NULL, .parent = NULL});
+
+    if (newLeaf && insertHashValue(&table->expressions, hash, (size_t) newLeaf) != bufferError::NO_BUFFER_ERROR) {
+        newLeaf->data.references = 0;
+    }
+
+    return newLeaf;
+}
+
+// operands are shared by then, so their addresses stand for their whole subtrees
+node<astNode> *internOperation(expressionTable *table, binaryTree<astNode> *tree, Buffer<nameTableElement> *nameTable,
+                               node<astNode> *operation) {
+    customWarning(table,     NULL);
+    customWarning(tree,      NULL);
+    customWarning(nameTable, NULL);
+
+    if (!operation || !isPureOperation(nameTable, operation)) {
+        return operation;
+    }
+
+    uint32_t       hash   = hashExpression(&operation->data, operation->left, operation->right);
+    node<astNode> *shared = findExpression(table, hash, &operation->data, operation->left, operation->right);
+
+    if (!shared) {
+        if (insertHashValue(&table->expressions, hash, (size_t) operation) == bufferError::NO_BUFFER_ERROR) {
+            operation->data.references = 1;
+        }
+
+        return operation;
+    }
+
+    // the copy hands the references it held on its operands back before it goes to the free list
+    operation->left->data.references--;
+    operation->right->data.references--;
+
+    operation->left  = NULL;
+    operation->right = NULL;
+
+    nodeDestruct(tree, &operation);
+
+    shared->data.references++;
+    shared->parent = NULL;
+
+    return shared;
+}
+
+bufferError releaseSharedSubtree(binaryTree<astNode> *tree, node<astNode> **subtree) {
+    customWarning(tree,    bufferError::POINTER_IS_NULL);
+    customWarning(subtree, bufferError::POINTER_IS_NULL);
+
+    Buffer<node<astNode> *> stack = {};
+
+    if (bufferInitialize(&stack) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
+    bufferError error = *subtree ? writeDataToBuffer(&stack, subtree, 1) : bufferError::NO_BUFFER_ERROR;
+
+    while (error == bufferError::NO_BUFFER_ERROR && stack.currentIndex > 0) {
+        node<astNode> *currentNode = stack.data[--stack.currentIndex];
+
+        if (currentNode->data.references > 1) {
+            currentNode->data.references--;
+            continue;
+        }
+
+        if (currentNode->left) {
+            error = writeDataToBuffer(&stack, &currentNode->left, 1);
+        }
+
+        if (currentNode->right && error == bufferError::NO_BUFFER_ERROR) {
+            error = writeDataToBuffer(&stack, &currentNode->right, 1);
+        }
+
+        // a node whose children could not be kept is left for treeNodesDestruct
+        if (error == bufferError::NO_BUFFER_ERROR) {
+            currentNode->left  = NULL;
+            currentNode->right = NULL;
+
+            nodeDestruct(tree, &currentNode);
+        }
+    }
+
+    bufferDestruct(&stack);
+
+    *subtree = NULL;
+
+    return error;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// an operation is pure only over operands already in the table, anything that reads input or calls a function is not
+static bool isPureOperation(Buffer<nameTableElement> *nameTable, node<astNode> *operation) {
+    if (operation->data.type != nodeType::STRING || operation->data.references > 0) {
+        return false;
+    }
+
+    nameTableElement *name         = &nameTable->data[operation->data.data.nameTableIndex];
+    size_t            keywordIndex = getKeywordNameIndex(name->keyword);
+
+    return keywordIndex != KEYWORD_NO_INDEX &&
+           (KEYWORDS[keywordIndex].priorities & (ADDITIVE_OPERATION | MULTIPLICATIVE_OPERATION)) &&
+           operation->left  && operation->left->data.references  > 0 &&
+           operation->right && operation->right->data.references > 0;
+}
+
+static bool areSameExpressions(const astNode *first, node<astNode> *firstLeft, node<astNode> *firstRight, node<astNode> *second) {
+    if (first->type != second->data.type || firstLeft != second->left || firstRight != second->right) {
+        return false;
+    }
+
+    return first->type == nodeType::CONSTANT ? first->data.number         == second->data.data.number
+                                             : first->data.nameTableIndex == second->data.data.nameTableIndex;
+}
+
+static uint32_t hashExpression(const astNode *expression, node<astNode> *left, node<astNode> *right) {
+    uint32_t hash = hashValue(FNV_OFFSET_BASIS, expression->type);
+
+    hash = expression->type == nodeType::CONSTANT ? hashValue(hash, expression->data.number)
+                                                  : hashValue(hash, expression->data.nameTableIndex);
+
+    return hashValue(hashValue(hash, left), right);
+}
+
+static node<astNode> *findExpression(expressionTable *table, uint32_t hash, const astNode *expression,
+                                     node<astNode> *left, node<astNode> *right) {
+    hashTable *expressions = &table->expressions;
+
+    for (size_t slotIndex = getFirstHashSlot(expressions, hash); expressions->slots[slotIndex].value;
+                slotIndex = getNextHashSlot(expressions, slotIndex)) {
+        hashSlot *slot = &expressions->slots[slotIndex];
+
+        if (slot->hash == hash && areSameExpressions(expression, left, right, (node<astNode> *) slot->value)) {
+            return (node<astNode> *) slot->value;
+        }
+    }
+
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
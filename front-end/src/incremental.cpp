@@ -0,0 +1,271 @@
+#include "incremental.h"
+#include "core.h"
+#include "lexer.h"
+#include "parser.h"
+#include "tokenStream.h"
+#include "sourceInput.h"
+#include "nameTable.h"
+#include "buffer.h"
+#include "AST.h"
+#include "binaryTreeDef.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static int              findEditedDeclaration(compilationContext *context, const sourceEdit *edit);
+static compilationError relexDeclaration     (compilationContext *context, size_t declarationIndex, const sourceEdit *edit,
+                                              size_t *firstToken, size_t *tokensCount, int *lineDelta);
+
+static void             getDeclarationShift  (compilationContext *context, size_t declarationIndex, ptrdiff_t *offsetShift, int *lineShift);
+static void             shiftDeclarations    (compilationContext *context, size_t firstIndex, ptrdiff_t offsetDelta, int lineDelta);
+static size_t           getDeclarationOffset (compilationContext *context, size_t declarationIndex);
+
+static compilationError relexCode            (compilationContext *context);
+static compilationError reparseCode          (compilationContext *context);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+compilationError applySourceEdit(compilationContext *context, const sourceEdit *edit, editPath *path) {
+    customWarning(context         != NULL, compilationError::CONTEXT_ERROR);
+    customWarning(edit            != NULL, compilationError::CONTEXT_ERROR);
+    customWarning(context->source != NULL, compilationError::CONTEXT_ERROR);
+
+    int declarationIndex = findEditedDeclaration(context, edit);
+
+    if (path) {
+        *path = editPath::FULL;
+    }
+
+    if (editSourceInput(context->source, edit->offset, edit->removedLength,
+                        edit->insertedText, edit->insertedLength) != sourceInputError::NO_ERRORS) {
+        return compilationError::CONTEXT_ERROR;
+    }
+
+    context->fileContent = context->source->data;
+    context->fileSize    = context->source->size;
+
+    if (declarationIndex < 0) {
+        return relexCode(context);
+    }
+
+    size_t firstToken  = 0;
+    size_t tokensCount = 0;
+    int    lineDelta   = 0;
+
+    // the stream keeps the old tokens of the declaration, so a failure anywhere here starts over from the source
+    if (relexDeclaration(context, (size_t) declarationIndex, edit, &firstToken, &tokensCount, &lineDelta) != compilationError::NO_ERRORS ||
+        reparseDeclaration(context, (size_t) declarationIndex, firstToken, tokensCount) != compilationError::NO_ERRORS) {
+        return relexCode(context);
+    }
+
+    shiftDeclarations(context, (size_t) declarationIndex + 1, (ptrdiff_t) edit->insertedLength - (ptrdiff_t) edit->removedLength, lineDelta);
+
+    context->currentLine += lineDelta;
+
+    if (path) {
+        *path = editPath::INCREMENTAL;
+    }
+
+    return context->error;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// the edit has to stay inside [first token of a function, first token after its separator), that token must survive untouched
+static int findEditedDeclaration(compilationContext *context, const sourceEdit *edit) {
+    customWarning(context, -1);
+
+    if (!context->AST->root || context->error != compilationError::NO_ERRORS || context->declarations->currentIndex == 0) {
+        return -1;
+    }
+
+    size_t left  = 0;
+    size_t right = context->declarations->currentIndex;
+
+    while (right - left > 1) {
+        size_t middle = (left + right) / 2;
+
+        if (getDeclarationOffset(context, middle) <= edit->offset) {
+            left = middle;
+        } else {
+            right = middle;
+        }
+    }
+
+    declarationRange *declaration = &context->declarations->data[left];
+
+    size_t regionBegin = getDeclarationOffset(context, left);
+    size_t regionEnd   = getDeclarationOffset(context, left + 1);
+
+    if (edit->offset < regionBegin || edit->offset + edit->removedLength >= regionEnd ||
+        !declaration->separator->left || declaration->separator->left->data.type != nodeType::FUNCTION_DEFINITION) {
+        return -1;
+    }
+
+    return (int) left;
+}
+
+// the tokens are lexed as they are now and appended to the stream, stored back by the shift of the declaration
+static compilationError relexDeclaration(compilationContext *context, size_t declarationIndex, const sourceEdit *edit,
+                                         size_t *firstToken, size_t *tokensCount, int *lineDelta) {
+    customWarning(context     != NULL, compilationError::CONTEXT_ERROR);
+    customWarning(firstToken  != NULL, compilationError::CONTEXT_ERROR);
+    customWarning(tokensCount != NULL, compilationError::CONTEXT_ERROR);
+    customWarning(lineDelta   != NULL, compilationError::CONTEXT_ERROR);
+
+    declarationRange *declaration = &context->declarations->data[declarationIndex];
+    tokenStream      *tokens      = context->tokens;
+
+    ptrdiff_t offsetShift = 0;
+    int       lineShift   = 0;
+
+    getDeclarationShift(context, declarationIndex, &offsetShift, &lineShift);
+
+    // the next declaration has not moved yet, the last one ends with the source
+    bool   isLast      = declarationIndex + 1 == context->declarations->currentIndex;
+    size_t regionBegin = tokens->offsets.data[declaration->firstToken] + offsetShift;
+    size_t regionEnd   = isLast ? context->fileSize
+                                : getDeclarationOffset(context, declarationIndex + 1) + edit->insertedLength - edit->removedLength;
+    int    firstLine   = tokens->lines.data[declaration->firstToken];
+    int    totalLines  = context->currentLine;
+    int    nextLine    = totalLines - lineShift;
+
+    if (!isLast) {
+        ptrdiff_t nextOffsetShift = 0;
+        int       nextLineShift   = 0;
+
+        getDeclarationShift(context, declarationIndex + 1, &nextOffsetShift, &nextLineShift);
+
+        nextLine = tokens->lines.data[context->declarations->data[declarationIndex + 1].firstToken] + nextLineShift - lineShift;
+    }
+
+    // the gap goes right after the declaration, so the source is contiguous up to regionEnd
+    if (moveSourceGap(context->source, regionEnd) != sourceInputError::NO_ERRORS) {
+        return compilationError::CONTEXT_ERROR;
+    }
+
+    context->fileContent = context->source->data;
+
+    tokenStream regionTokens = {};
+
+    if (initializeTokenStream(&regionTokens) != bufferError::NO_BUFFER_ERROR) {
+        return compilationError::TOKEN_BUFFER_ERROR;
+    }
+
+    compilationError error = lexicalAnalysisRange(context, regionBegin, regionEnd, firstLine, &regionTokens);
+
+    // no keyword starts with the separator, so a range ending on it lexes exactly as inside the whole file
+    if (error == compilationError::NO_ERRORS &&
+        (regionTokens.count == 0 || regionTokens.keywords.data[regionTokens.count - 1] != Keyword::OPERATOR_SEPARATOR)) {
+        error = compilationError::OPERATOR_SEPARATOR_EXPECTED;
+    }
+
+    *lineDelta           = context->currentLine - nextLine;
+    context->currentLine = totalLines;
+
+    if (error == compilationError::NO_ERRORS) {
+        for (size_t tokenIndex = 0; tokenIndex < regionTokens.count; tokenIndex++) {
+            regionTokens.offsets.data[tokenIndex] -= offsetShift;
+        }
+
+        *firstToken  = tokens->count;
+        *tokensCount = regionTokens.count;
+
+        if (spliceTokens(tokens, tokens->count, 0, &regionTokens, regionTokens.count) != bufferError::NO_BUFFER_ERROR) {
+            error = compilationError::TOKEN_BUFFER_ERROR;
+        }
+    }
+
+    destroyTokenStream(&regionTokens);
+
+    return error;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// prefix sum over the Fenwick tree in declarationRange::offsetShift and lineShift, declarationIndex included
+static void getDeclarationShift(compilationContext *context, size_t declarationIndex, ptrdiff_t *offsetShift, int *lineShift) {
+    declarationRange *declarations = context->declarations->data;
+
+    *offsetShift = 0;
+    *lineShift   = 0;
+
+    for (size_t treeIndex = declarationIndex + 1; treeIndex > 0; treeIndex -= treeIndex & (~treeIndex + 1)) {
+        *offsetShift += declarations[treeIndex - 1].offsetShift;
+        *lineShift   += declarations[treeIndex - 1].lineShift;
+    }
+}
+
+// moves every declaration from firstIndex on
+static void shiftDeclarations(compilationContext *context, size_t firstIndex, ptrdiff_t offsetDelta, int lineDelta) {
+    declarationRange *declarations = context->declarations->data;
+    size_t            count        = context->declarations->currentIndex;
+
+    for (size_t treeIndex = firstIndex + 1; treeIndex <= count; treeIndex += treeIndex & (~treeIndex + 1)) {
+        declarations[treeIndex - 1].offsetShift += offsetDelta;
+        declarations[treeIndex - 1].lineShift   += lineDelta;
+    }
+}
+
+// where the first token of a declaration is now, the one past the last declaration is the end of the source
+static size_t getDeclarationOffset(compilationContext *context, size_t declarationIndex) {
+    if (declarationIndex >= context->declarations->currentIndex) {
+        return context->fileSize;
+    }
+
+    ptrdiff_t offsetShift = 0;
+    int       lineShift   = 0;
+
+    getDeclarationShift(context, declarationIndex, &offsetShift, &lineShift);
+
+    return context->tokens->offsets.data[context->declarations->data[declarationIndex].firstToken] + offsetShift;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// name table and trie are kept, so every name already seen keeps its index
+static compilationError relexCode(compilationContext *context) {
+    customWarning(context, compilationError::CONTEXT_ERROR);
+
+    destroyTokenStream(context->tokens);
+
+    if (initializeTokenStream(context->tokens) != bufferError::NO_BUFFER_ERROR) {
+        return compilationError::TOKEN_BUFFER_ERROR;
+    }
+
+    context->error       = compilationError::NO_ERRORS;
+    context->currentLine = 1;
+
+    if (lexicalAnalysis(context) != compilationError::NO_ERRORS) {
+        return context->error;
+    }
+
+    return reparseCode(context);
+}
+
+static compilationError reparseCode(compilationContext *context) {
+    customWarning(context, compilationError::CONTEXT_ERROR);
+
+    // nodes left unlinked by failed parses go away too
+    treeNodesDestruct(context->AST);
+
+    for (size_t localTableIndex = 0; localTableIndex < context->localTables->currentIndex; localTableIndex++) {
+        bufferDestruct(&context->localTables->data[localTableIndex].elements);
+    }
+
+    context->localTables->currentIndex = 0;
+    addLocalNameTable(-1, context->localTables);
+
+    destroyScopeChain(context->scopes);
+
+    if (initializeScopeChain(context->scopes, 0) != bufferError::NO_BUFFER_ERROR) {
+        return compilationError::CONTEXT_ERROR;
+    }
+
+    context->errorBuffer->currentIndex   = 0;
+    context->functionCalls->currentIndex = 0;
+    context->declarations->currentIndex  = 0;
+
+    return parseCode(context);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -1,12 +1,17 @@
-#include <cctype>
 #include <climits>
-#include <clocale>
-#include <cstdio>
+#include <cstring>
 
 #include "lexer.h"
 #include "buffer.h"
 #include "core.h"
 #include "nameTable.h"
+#include "nameTrie.h"
+#include "keywordTable.h"
+#include "symbolClassifier.h"
+#include "utf8.h"
+#include "tokenStream.h"
+#include "numberParser.h"
+#include "sourceInput.h"
 #include "AST.h"
 #include "binaryTreeDef.h"
 
@@ -14,15 +19,16 @@
 
 #define currentSymbol context->fileContent[*currentIndex]
 
-#define ADD_TOKEN(NODE) do {                                                                    \
-    node<astNode> *newToken = NODE;                                                             \
-    if (writeDataToBuffer(context->tokens, &newToken, 1) != bufferError::NO_BUFFER_ERROR) {     \
-        return compilationError::TOKEN_BUFFER_ERROR;                                            \
-    }                                                                                           \
+#define ADD_TOKEN(KIND, KEYWORD, VALUE, OFFSET) do {                                                        \
+    if (addToken(context->tokens, KIND, KEYWORD, VALUE, context->currentLine, OFFSET) != bufferError::NO_BUFFER_ERROR) { \
+        return compilationError::TOKEN_BUFFER_ERROR;                                                        \
+    }                                                                                                       \
 } while (0)
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
+static compilationError tokenizeRange    (compilationContext *context, size_t *currentIndex);
+static void             updateLexLimit   (compilationContext *context, size_t  currentIndex);
 static compilationError tokenizeNumber   (compilationContext *context, size_t *currentIndex);
 static compilationError tokenizeWord     (compilationContext *context, size_t *currentIndex);
 static size_t           getNextWordLength(compilationContext *context, size_t  currentIndex);
@@ -30,15 +36,58 @@ static size_t           getNextWordLength(compilationContext *context, size_t  c
 static compilationError tokenizeNewIdentifier     (compilationContext *context, size_t *currentIndex, size_t length);
 static compilationError tokenizeExistingIdentifier(compilationContext *context, size_t *currentIndex, size_t length, size_t nameIndex);
 
-static stringIntersection checkWordIntersection(const char *word,            const char *pattern, size_t wordLength);
-static stringIntersection findMaxIntersection  (compilationContext *context, const char *word,    size_t wordLength, size_t *foundNameIndex);
-static symbolGroup        getSymbolGroup       (compilationContext *context, size_t      symbolIndex);
+static symbolGroup        getSymbolGroup     (compilationContext *context, size_t symbolIndex, size_t *symbolLength);
 
 static symbolGroup        getPermittedSymbols(symbolGroup group);
 static size_t             getMaxWordLength   (symbolGroup group);
 
-static bool   isCyrillic      (const char *multiByteSymbol);
-static size_t getMaxWordLength(char byte);
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+struct symbolGroupTable {
+    symbolGroup groups[256] = {};
+};
+
+// ASCII bytes map straight to their group, every byte above 0x7f starts a multibyte symbol and is decoded
+static constexpr symbolGroupTable buildSymbolGroupTable() {
+    symbolGroupTable table = {};
+
+    for (int byte = 0; byte < 256; byte++) {
+        table.groups[byte] = symbolGroup::INVALID;
+    }
+
+    for (int byte = 'a'; byte <= 'z'; byte++) {
+        table.groups[byte]              = symbolGroup::ENGLISH;
+        table.groups[byte - 'a' + 'A']  = symbolGroup::ENGLISH;
+    }
+
+    for (int byte = '0'; byte <= '9'; byte++) {
+        table.groups[byte] = symbolGroup::DIGIT;
+    }
+
+    for (int byte = '\t'; byte <= '\r'; byte++) {
+        table.groups[byte] = symbolGroup::SPACE;
+    }
+
+    table.groups[(int)' '] = symbolGroup::SPACE;
+    table.groups[(int)'_'] = symbolGroup::UNDERSCORE;
+
+    for (const char *bracket = "{}[]()"; *bracket; bracket++) {
+        table.groups[(int)*bracket] = symbolGroup::BRACKET;
+    }
+
+    for (const char *operation = "+-*/=!<>"; *operation; operation++) {
+        table.groups[(int)*operation] = symbolGroup::OPERATION;
+    }
+
+    table.groups[(int)';'] = symbolGroup::SEPARATOR;
+    table.groups[(int)','] = symbolGroup::SEPARATOR;
+
+    return table;
+}
+
+static constexpr symbolGroupTable SYMBOL_GROUPS = buildSymbolGroupTable();
+
+#define byteGroup(BYTE) SYMBOL_GROUPS.groups[(unsigned char)(BYTE)]
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
@@ -47,111 +96,194 @@ compilationError lexicalAnalysis(compilationContext *context) {
 
     size_t currentIndex = 0;
 
-    setlocale(LC_ALL, "en_US.utf8");
-    setlocale(LC_ALL, "ru_RU.utf8");
+    updateLexLimit(context, currentIndex);
 
-    while (currentIndex < context->fileSize) {
-        if (context->fileContent[currentIndex] == '\n') {
-            context->currentLine++;
+    // a streamed source is lexed up to its last complete line while the next chunk is still unread
+    while (tokenizeRange(context, &currentIndex) == compilationError::NO_ERRORS &&
+           context->source && !context->source->isComplete) {
+        if (readSourceChunk(context->source) != sourceInputError::NO_ERRORS) {
+            context->error = compilationError::CONTEXT_ERROR;
+            break;
         }
 
-        if (isspace(context->fileContent[currentIndex])) {
-            currentIndex++;
+        updateLexLimit(context, currentIndex);
+    }
+
+    ADD_TOKEN(tokenKind::TERMINATOR, Keyword::UNDEFINED, nodeData {}, currentIndex);
+
+    return context->error;
+}
+
+compilationError lexicalAnalysisRange(compilationContext *context, size_t begin, size_t end, int firstLine, tokenStream *tokens) {
+    customWarning(context != NULL,                          compilationError::CONTEXT_ERROR);
+    customWarning(tokens  != NULL,                          compilationError::TOKEN_BUFFER_ERROR);
+    customWarning(begin <= end && end <= context->fileSize, compilationError::CONTEXT_ERROR);
+
+    tokenStream     *contextTokens = context->tokens;
+    size_t           fileSize      = context->fileSize;
+    compilationError contextError  = context->error;
+
+    // the range is lexed as if the source ended at end, tokens and the line counter go to the caller
+    context->tokens      = tokens;
+    context->fileSize    = end;
+    context->currentLine = firstLine;
+    context->error       = compilationError::NO_ERRORS;
+
+    size_t           currentIndex = begin;
+    compilationError rangeError   = tokenizeRange(context, &currentIndex);
+
+    context->tokens   = contextTokens;
+    context->fileSize = fileSize;
+    context->error    = contextError;
+
+    return rangeError;
+}
+
+static compilationError tokenizeRange(compilationContext *context, size_t *currentIndexPointer) {
+    customWarning(context             != NULL, compilationError::CONTEXT_ERROR);
+    customWarning(currentIndexPointer != NULL, compilationError::CONTEXT_ERROR);
+
+    size_t currentIndex = *currentIndexPointer;
+
+    while (currentIndex < context->fileSize) {
+        if (byteGroup(context->fileContent[currentIndex]) == symbolGroup::SPACE) {
+            currentIndex += getSpaceRunLength(context->fileContent, currentIndex, context->fileSize, &context->currentLine);
             continue;
         }
 
-        if (isdigit(context->fileContent[currentIndex])) {
-            tokenizeNumber(context, &currentIndex);
+        if (byteGroup(context->fileContent[currentIndex]) == symbolGroup::DIGIT) {
+            if (tokenizeNumber(context, &currentIndex) != compilationError::NO_ERRORS) {
+                context->error = compilationError::CONSTANT_OVERFLOW;
+                break;
+            }
         }
 
-        else {
-            tokenizeWord(context, &currentIndex);
+        // a malformed or unknown symbol used to spin here forever, now lexing stops at it
+        else if (tokenizeWord(context, &currentIndex) != compilationError::NO_ERRORS) {
+            context->error = compilationError::IDENTIFIER_EXPECTED;
+            break;
         }
     }
 
-    ADD_TOKEN(_TERMINATOR_()); // ?
+    *currentIndexPointer = currentIndex;
 
-    return compilationError::NO_ERRORS;
+    return context->error;
+}
+
+// no token spans a line break, so everything before the last '\n' read so far lexes exactly as in the whole file
+static void updateLexLimit(compilationContext *context, size_t currentIndex) {
+    if (!context->source) {
+        return;
+    }
+
+    // an edited source is lexed as a whole once its gap is out of the way
+    moveSourceGap(context->source, context->source->size);
+
+    context->fileContent = context->source->data;
+    context->fileSize    = context->source->size;
+
+    if (context->source->isComplete) {
+        return;
+    }
+
+    const char *lastLineEnd = context->source->size > currentIndex ?
+                              (const char *)memrchr(context->source->data + currentIndex, '\n', context->source->size - currentIndex) : NULL;
+
+    context->fileSize = lastLineEnd ? (size_t)(lastLineEnd - context->source->data) + 1 : currentIndex;
 }
 
 static compilationError tokenizeNumber(compilationContext *context, size_t *currentIndex) {
     customWarning(context      != NULL, compilationError::CONTEXT_ERROR);
     customWarning(currentIndex != NULL, compilationError::CONTEXT_ERROR);
 
-    int number       = NAN;
-    int numberLength = 0;
+    int    number       = 0;
+    size_t numberLength = 0;
 
-    if (sscanf(&currentSymbol, "%d%n", &number, &numberLength) > 0) {
-        node<astNode> *constToken = _CONST_(number);
-        constToken->data.line = context->currentLine;
+    if (parseInt(&currentSymbol, context->fileSize - *currentIndex, &number, &numberLength) != numberParserError::NO_ERRORS) {
+        return compilationError::CONSTANT_OVERFLOW;
+    }
 
-        ADD_TOKEN(constToken);
+    ADD_TOKEN(tokenKind::CONSTANT, Keyword::UNDEFINED, nodeData {.number = number}, *currentIndex);
 
-        (*currentIndex) += (size_t)numberLength;
-        
-        return compilationError::NO_ERRORS;
-    }
+    (*currentIndex) += numberLength;
 
-    return compilationError::TOKEN_BUFFER_ERROR;
+    return compilationError::NO_ERRORS;
 }
 
 static compilationError tokenizeWord(compilationContext *context, size_t *currentIndex) {
     customWarning(context      != NULL, compilationError::CONTEXT_ERROR);
     customWarning(currentIndex != NULL, compilationError::CONTEXT_ERROR);
 
-    size_t initialWordLength = 0;
-    size_t wordLength        = 0;
+    size_t initialWordLength = getNextWordLength(context, *currentIndex);
 
-    while (true) {
-        size_t nextWordLength = getNextWordLength(context, *currentIndex + wordLength);
+    if (initialWordLength == 0) {
+        return compilationError::IDENTIFIER_EXPECTED;
+    }
 
-        if (initialWordLength == 0) {
-            initialWordLength = nextWordLength;
-        }
+    size_t trieNode       = TRIE_ROOT;
+    size_t wordLength     = 0;
+    size_t nextWordLength = initialWordLength;
 
-        if (nextWordLength == 0) {
-            if (initialWordLength == 0) {
-                return compilationError::IDENTIFIER_EXPECTED;
-            }
+    size_t  matchLength    = 0;
+    int     matchNameIndex = TRIE_NO_NAME;
+    Keyword matchKeyword   = Keyword::UNDEFINED;
 
-            return tokenizeNewIdentifier(context, currentIndex, initialWordLength);
+    // walk the trie piece by piece, remembering the longest name that ends on a piece boundary.
+    // keywords are not in the trie, the perfect hash is asked for every prefix short enough to be one
+    while (nextWordLength != 0 && (trieNode != TRIE_NO_NODE || wordLength + nextWordLength <= KEYWORD_MAX_LENGTH)) {
+        if (trieNode != TRIE_NO_NODE) {
+            trieNode = trieStep(context->trie, trieNode, &currentSymbol + wordLength, nextWordLength);
         }
 
         wordLength += nextWordLength;
 
-        size_t foundNameIndex = 0;
-
-        switch (findMaxIntersection(context, &currentSymbol, wordLength, &foundNameIndex)) {
-            case stringIntersection::NO_MATCH: {
-                return tokenizeNewIdentifier(context, currentIndex, initialWordLength);
-            }
-            
-            case stringIntersection::FULL_MATCH: {
-                return tokenizeExistingIdentifier(context, currentIndex, wordLength, foundNameIndex);
-            }
+        Keyword keyword = findKeyword(&currentSymbol, wordLength);
 
-            case stringIntersection::IS_BEGIN: {
-                break;
-            }
+        if (keyword != Keyword::UNDEFINED) {
+            matchLength    = wordLength;
+            matchNameIndex = (int) getKeywordNameIndex(keyword);
+            matchKeyword   = keyword;
         }
+        else if (trieNode != TRIE_NO_NODE && context->trie->nodes->data[trieNode].nameIndex != TRIE_NO_NAME) {
+            matchLength    = wordLength;
+            matchNameIndex = context->trie->nodes->data[trieNode].nameIndex;
+            matchKeyword   = Keyword::UNDEFINED;
+        }
+
+        nextWordLength = getNextWordLength(context, *currentIndex + wordLength);
+    }
+
+    if (matchNameIndex == TRIE_NO_NAME) {
+        return tokenizeNewIdentifier(context, currentIndex, initialWordLength);
     }
+
+    if (matchKeyword == Keyword::UNDEFINED) {
+        return tokenizeExistingIdentifier(context, currentIndex, matchLength, (size_t) matchNameIndex);
+    }
+
+    ADD_TOKEN(tokenKind::NAME, matchKeyword, nodeData {.nameTableIndex = (size_t) matchNameIndex}, *currentIndex);
+
+    (*currentIndex) += matchLength;
+
+    return compilationError::NO_ERRORS;
 }
 
 static compilationError tokenizeNewIdentifier(compilationContext *context, size_t *currentIndex, size_t length) {
     customWarning(context      != NULL, compilationError::CONTEXT_ERROR);
     customWarning(currentIndex != NULL, compilationError::CONTEXT_ERROR);
 
-    char *newIdentifier = (char *)calloc(length + 1, sizeof(char));
-    memcpy(newIdentifier, &currentSymbol, length);
+    size_t nameIndex = 0;
 
-    if (addIdentifier(context->nameTable, newIdentifier) != bufferError::NO_BUFFER_ERROR) {
+    if (internName(context->nameTable, context->interner, &currentSymbol, length,
+                   nameType::IDENTIFIER, Keyword::UNDEFINED, &nameIndex) != bufferError::NO_BUFFER_ERROR) {
         return compilationError::CONTEXT_ERROR;
     }
 
-    node<astNode> *identifierToken = _NAME_(context->nameTable->currentIndex - 1);
-    identifierToken->data.line = context->currentLine;
+    if (addNameToTrie(context->trie, &currentSymbol, length, nameIndex) != bufferError::NO_BUFFER_ERROR) {
+        return compilationError::CONTEXT_ERROR;
+    }
 
-    ADD_TOKEN(identifierToken);
+    ADD_TOKEN(tokenKind::NAME, Keyword::UNDEFINED, nodeData {.nameTableIndex = nameIndex}, *currentIndex);
 
     (*currentIndex) += length;
 
@@ -162,10 +294,7 @@ static compilationError tokenizeExistingIdentifier(compilationContext *context,
     customWarning(context      != NULL, compilationError::CONTEXT_ERROR);
     customWarning(currentIndex != NULL, compilationError::CONTEXT_ERROR);
 
-    node<astNode> *identifierToken = _NAME_(nameIndex);
-    identifierToken->data.line = context->currentLine;
-
-    ADD_TOKEN(identifierToken);
+    ADD_TOKEN(tokenKind::NAME, Keyword::UNDEFINED, nodeData {.nameTableIndex = nameIndex}, *currentIndex);
 
     (*currentIndex) += length;
 
@@ -175,26 +304,28 @@ static compilationError tokenizeExistingIdentifier(compilationContext *context,
 static size_t getNextWordLength(compilationContext *context, size_t currentIndex) {
     customWarning(context, -1); // TODO
 
-    if (currentIndex > context->fileSize || context->fileContent[currentIndex] == '\n') {
+    if (currentIndex >= context->fileSize || context->fileContent[currentIndex] == '\n') {
         return 0;
     }
 
-    symbolGroup currentGroup   = getSymbolGroup     (context, currentIndex);
+    size_t      symbolLength   = 0;
+    symbolGroup currentGroup   = getSymbolGroup     (context, currentIndex, &symbolLength);
     symbolGroup permittedGroup = getPermittedSymbols(currentGroup);
 
+    // identifier runs are the long ones, they are skipped a whole block at a time
+    if (permittedGroup != currentGroup) {
+        return getIdentifierRunLength(context->fileContent, currentIndex, context->fileSize);
+    }
+
     size_t maxLength = getMaxWordLength(currentGroup);
     size_t length    = 0;
 
     while (context->fileContent[currentIndex + length] != '\n' &&
            ((int)currentGroup & (int)permittedGroup) && length < maxLength) {
-                if (currentGroup == symbolGroup::CYRILLIC) {
-                    length++;
-                }
-
-                length++;
+                length += symbolLength;
 
                 if (currentIndex + length < context->fileSize) {
-                    currentGroup = getSymbolGroup(context, currentIndex + length);
+                    currentGroup = getSymbolGroup(context, currentIndex + length, &symbolLength);
                 }
 
                 else {
@@ -205,51 +336,6 @@ static size_t getNextWordLength(compilationContext *context, size_t currentIndex
     return length;
 }
 
-static stringIntersection findMaxIntersection(compilationContext *context, const char *word, size_t wordLength, size_t *foundNameIndex) {
-    // customWarning(context,        compilationError::CONTEXT_ERROR); // TODO
-    // customWarning(word,           compilationError::CONTEXT_ERROR); // TODO
-    // customWarning(foundNameIndex, compilationError::CONTEXT_ERROR); // TODO
-
-    stringIntersection maxIntersection = stringIntersection::NO_MATCH;
-
-    for (size_t nameIndex = 0; nameIndex < context->nameTable->currentIndex; nameIndex++) {
-        stringIntersection currentIntersection = checkWordIntersection(word, context->nameTable->data[nameIndex].name, wordLength);
-
-        if (currentIntersection == stringIntersection::FULL_MATCH) {
-            *foundNameIndex = nameIndex;
-
-            return stringIntersection::FULL_MATCH;
-        }
-
-        if (maxIntersection == stringIntersection::NO_MATCH && currentIntersection == stringIntersection::IS_BEGIN) {
-            maxIntersection = stringIntersection::IS_BEGIN;
-        }
-    }
-
-    return maxIntersection;
-}
-
-static stringIntersection checkWordIntersection(const char *word, const char *pattern, size_t wordLength) {
-    customWarning(word,    stringIntersection::NO_MATCH); // TODO
-    customWarning(pattern, stringIntersection::NO_MATCH); // TODO
-
-    for (size_t symbol = 0; symbol < wordLength; symbol++) {
-        if (pattern[symbol] == '\0') {
-            return stringIntersection::NO_MATCH;
-        }
-
-        if (pattern[symbol] != word[symbol]) {
-            return stringIntersection::NO_MATCH;
-        }
-    }
-
-    if (pattern[wordLength] == '\0') {
-        return stringIntersection::FULL_MATCH;
-    }
-
-    return stringIntersection::IS_BEGIN;
-}
-
 static size_t getMaxWordLength(symbolGroup group) {
     switch (group) {
         case symbolGroup::ENGLISH:
@@ -298,68 +384,26 @@ static symbolGroup getPermittedSymbols(symbolGroup group) {
     }
 }
 
-static symbolGroup getSymbolGroup(compilationContext *context, size_t symbolIndex) {
+static symbolGroup getSymbolGroup(compilationContext *context, size_t symbolIndex, size_t *symbolLength) {
     // customWarning(context, symbolGroup::INVALID); // TODO
 
-    char symbol = context->fileContent[symbolIndex];
-
-    if (isalpha(symbol)) {
-        return symbolGroup::ENGLISH;
-    }
-    
-    else if (isdigit(symbol)) {
-        return symbolGroup::DIGIT;
-    }
+    *symbolLength = 1;
 
-    else if (symbol == '{' || symbol == '}' ||
-             symbol == '[' || symbol == ']' ||
-             symbol == '(' || symbol == ')') {
-                return symbolGroup::BRACKET;
-             }
-            
-    else if (symbol == '+' || symbol == '-' ||
-             symbol == '*' || symbol == '/' ||
-             symbol == '=' || symbol == '!' ||
-             symbol == '<' || symbol == '>') {
-                return symbolGroup::OPERATION;
-             }
-    
-    else if (isspace(symbol)) {
-        return symbolGroup::SPACE;
-    }
+    unsigned char symbol = (unsigned char)context->fileContent[symbolIndex];
 
-    else if (symbol == '_') {
-        return symbolGroup::UNDERSCORE;
+    if (symbol < 0x80) {
+        return byteGroup(symbol);
     }
 
-    else if (symbol == ';' || symbol == ',') {
-        return symbolGroup::SEPARATOR;
-    }
+    uint32_t codePoint = 0;
+    size_t   available = symbolIndex < context->fileSize ? context->fileSize - symbolIndex : 0;
+    size_t   length    = decodeUtf8Symbol(&context->fileContent[symbolIndex], available, &codePoint);
 
-    else if (isCyrillic(&context->fileContent[symbolIndex])) {
-        return symbolGroup::CYRILLIC;
-    }
-
-    else {
+    if (length == 0 || !isCyrillicCodePoint(codePoint)) {
         return symbolGroup::INVALID;
     }
-}
 
-static bool isCyrillicSecondByte(char byte) {
-    return (byte >= 0x10 && byte <= 0x4f) || byte == 0x51 || byte == 0x01; // unicode table
-}
-
-static bool isCyrillic(const char *multiByteSymbol) {
-    customWarning(multiByteSymbol != NULL, false);
-
-    wchar_t symbol = 0;
-    mbtowc(&symbol, multiByteSymbol, 2);
-
-    char *symbolBytes = (char *)(&symbol);
+    *symbolLength = length;
 
-    if (symbolBytes[1] == 0x04 && isCyrillicSecondByte(symbolBytes[0])) {
-        return true;
-    }
-
-    return false;
-}
\ No newline at end of file
+    return symbolGroup::CYRILLIC;
+}
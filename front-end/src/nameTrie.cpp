@@ -0,0 +1,115 @@
+#include <cstdlib>
+
+#include "customWarning.h"
+#include "nameTrie.h"
+#include "buffer.h"
+#include "binaryTreeDef.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static size_t findChild(nameTrie *trie, size_t nodeIndex, char symbol);
+static size_t addChild (nameTrie *trie, size_t nodeIndex, char symbol);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError initializeNameTrie(nameTrie *trie) {
+    customWarning(trie, bufferError::POINTER_IS_NULL);
+
+    trie->nodes = (Buffer<nameTrieNode> *)calloc(1, sizeof(Buffer<nameTrieNode>));
+    customWarning(trie->nodes, bufferError::CALLOC_ERROR);
+
+    if (bufferInitialize(trie->nodes) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
+    nameTrieNode root = {};
+
+    return writeDataToBuffer(trie->nodes, &root, 1);
+}
+
+bufferError destroyNameTrie(nameTrie *trie) {
+    customWarning(trie, bufferError::POINTER_IS_NULL);
+
+    if (trie->nodes) {
+        bufferDestruct(trie->nodes);
+        FREE_(trie->nodes);
+    }
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError addNameToTrie(nameTrie *trie, const char *name, size_t length, size_t nameIndex) {
+    customWarning(trie,        bufferError::POINTER_IS_NULL);
+    customWarning(trie->nodes, bufferError::NO_BUFFER);
+    customWarning(name,        bufferError::POINTER_IS_NULL);
+
+    size_t currentNode = TRIE_ROOT;
+
+    for (size_t symbolIndex = 0; symbolIndex < length; symbolIndex++) {
+        size_t nextNode = findChild(trie, currentNode, name[symbolIndex]);
+
+        if (nextNode == TRIE_NO_NODE) {
+            nextNode = addChild(trie, currentNode, name[symbolIndex]);
+
+            if (nextNode == TRIE_NO_NODE) {
+                return bufferError::BUFFER_ENDED;
+            }
+        }
+
+        currentNode = nextNode;
+    }
+
+    // the first name wins, the same way the old linear scan returned the lowest index
+    if (trie->nodes->data[currentNode].nameIndex == TRIE_NO_NAME) {
+        trie->nodes->data[currentNode].nameIndex = (int) nameIndex;
+    }
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+size_t trieStep(nameTrie *trie, size_t nodeIndex, const char *symbols, size_t length) {
+    customWarning(trie,    TRIE_NO_NODE);
+    customWarning(symbols, TRIE_NO_NODE);
+
+    for (size_t symbolIndex = 0; symbolIndex < length; symbolIndex++) {
+        nodeIndex = findChild(trie, nodeIndex, symbols[symbolIndex]);
+
+        if (nodeIndex == TRIE_NO_NODE) {
+            break;
+        }
+    }
+
+    return nodeIndex;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static size_t findChild(nameTrie *trie, size_t nodeIndex, char symbol) {
+    size_t childIndex = trie->nodes->data[nodeIndex].firstChild;
+
+    while (childIndex != TRIE_NO_NODE && trie->nodes->data[childIndex].symbol != symbol) {
+        childIndex = trie->nodes->data[childIndex].nextSibling;
+    }
+
+    return childIndex;
+}
+
+static size_t addChild(nameTrie *trie, size_t nodeIndex, char symbol) {
+    nameTrieNode newNode = {.symbol      = symbol,
+                            .firstChild  = TRIE_NO_NODE,
+                            .nextSibling = trie->nodes->data[nodeIndex].firstChild,
+                            .nameIndex   = TRIE_NO_NAME};
+
+    if (writeDataToBuffer(trie->nodes, &newNode, 1) != bufferError::NO_BUFFER_ERROR) {
+        return TRIE_NO_NODE;
+    }
+
+    size_t newIndex = trie->nodes->currentIndex - 1;
+    trie->nodes->data[nodeIndex].firstChild = newIndex;
+
+    return newIndex;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -0,0 +1,217 @@
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "lexer.h"
+#include "buffer.h"
+#include "core.h"
+#include "nameTable.h"
+#include "nameTrie.h"
+#include "tokenStream.h"
+#include "sourceInput.h"
+#include "binaryTreeDef.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// every chunk is lexed by its own context: own name table, interner and trie, the source is only read
+struct lexerChunk {
+    size_t             begin         = 0;
+    size_t             end           = 0;
+
+    sourceInput        view          = {};
+    compilationContext context       = {};
+    compilationError   error         = compilationError::NO_ERRORS;
+    bool               isInitialized = false;
+    bool               isLexed       = false;
+};
+
+struct lexerChunks {
+    lexerChunk          *chunks       = NULL;
+    size_t               chunksCount  = 0;
+    std::atomic<size_t>  nextChunk    = {0};
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static size_t           splitSource (compilationContext *context, lexerChunk *chunks, size_t maxChunksCount);
+static void             lexChunks   (lexerChunks *chunks);
+static compilationError mergeChunk  (compilationContext *context, lexerChunk *chunk, size_t keywordsCount);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+compilationError lexicalAnalysisParallel(compilationContext *context, size_t threadsCount) {
+    customWarning(context != NULL, compilationError::CONTEXT_ERROR);
+
+    if (threadsCount == 0) {
+        threadsCount = std::thread::hardware_concurrency();
+    }
+
+    if (threadsCount < 2 || !context->source || !context->source->isComplete || context->fileSize < PARALLEL_LEXING_MIN_SIZE) {
+        return lexicalAnalysis(context);
+    }
+
+    size_t maxChunksCount = threadsCount * PARALLEL_CHUNKS_PER_THREAD;
+
+    lexerChunk *chunks = (lexerChunk *)calloc(maxChunksCount, sizeof(lexerChunk));
+    customWarning(chunks, compilationError::ALLOCATION_ERROR);
+
+    lexerChunks pool = {};
+
+    pool.chunks      = chunks;
+    pool.chunksCount = splitSource(context, chunks, maxChunksCount);
+
+    // keywords are interned first, so their indices are the same in every chunk and in the global table
+    size_t keywordsCount = context->nameTable->currentIndex;
+
+    for (size_t chunkIndex = 0; chunkIndex < pool.chunksCount; chunkIndex++) {
+        lexerChunk *chunk = &chunks[chunkIndex];
+
+        chunk->view.kind       = sourceInputKind::MAPPED;
+        chunk->view.fileName   = context->source->fileName;
+        chunk->view.data       = context->fileContent + chunk->begin;
+        chunk->view.size       = chunk->end - chunk->begin;
+        chunk->view.isComplete = true;
+
+        chunk->error         = initializeCompilationContext(&chunk->context, &chunk->view);
+        chunk->isInitialized = chunk->error == compilationError::NO_ERRORS;
+    }
+
+    std::thread *threads = new std::thread[threadsCount - 1];
+
+    for (size_t threadIndex = 0; threadIndex < threadsCount - 1; threadIndex++) {
+        threads[threadIndex] = std::thread(lexChunks, &pool);
+    }
+
+    lexChunks(&pool);
+
+    for (size_t threadIndex = 0; threadIndex < threadsCount - 1; threadIndex++) {
+        threads[threadIndex].join();
+    }
+
+    delete[] threads;
+
+    // merging in source order reproduces the serial name table and line numbers exactly
+    size_t currentIndex = 0;
+
+    for (size_t chunkIndex = 0; chunkIndex < pool.chunksCount; chunkIndex++) {
+        if (context->error == compilationError::NO_ERRORS) {
+            context->error = mergeChunk(context, &chunks[chunkIndex], keywordsCount);
+            currentIndex   = chunks[chunkIndex].end;
+        }
+
+        // a context that failed to initialize may be half built, destroying it would touch buffers it never set up
+        if (chunks[chunkIndex].isInitialized) {
+            destroyCompilationContext(&chunks[chunkIndex].context);
+        }
+    }
+
+    FREE_(chunks);
+
+    if (addToken(context->tokens, tokenKind::TERMINATOR, Keyword::UNDEFINED, nodeData {}, context->currentLine, currentIndex) != bufferError::NO_BUFFER_ERROR) {
+        return compilationError::TOKEN_BUFFER_ERROR;
+    }
+
+    return context->error;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// no token spans a line break, so chunks end right after a '\n' and each of them lexes exactly as inside the whole file
+static size_t splitSource(compilationContext *context, lexerChunk *chunks, size_t maxChunksCount) {
+    size_t chunkSize   = context->fileSize / maxChunksCount + 1;
+    size_t chunksCount = 0;
+    size_t begin       = 0;
+
+    while (begin < context->fileSize) {
+        size_t end = context->fileSize;
+
+        if (chunksCount + 1 < maxChunksCount && begin + chunkSize < context->fileSize) {
+            const char *lineEnd = (const char *)memchr(context->fileContent + begin + chunkSize, '\n',
+                                                       context->fileSize - begin - chunkSize);
+
+            if (lineEnd) {
+                end = (size_t)(lineEnd - context->fileContent) + 1;
+            }
+        }
+
+        chunks[chunksCount].begin = begin;
+        chunks[chunksCount].end   = end;
+
+        chunksCount++;
+        begin = end;
+    }
+
+    return chunksCount;
+}
+
+static void lexChunks(lexerChunks *pool) {
+    for (size_t chunkIndex = pool->nextChunk++; chunkIndex < pool->chunksCount; chunkIndex = pool->nextChunk++) {
+        lexerChunk *chunk = &pool->chunks[chunkIndex];
+
+        if (chunk->error == compilationError::NO_ERRORS) {
+            chunk->error   = lexicalAnalysis(&chunk->context);
+            chunk->isLexed = true;
+        }
+    }
+}
+
+static compilationError mergeChunk(compilationContext *context, lexerChunk *chunk, size_t keywordsCount) {
+    if (!chunk->isLexed) {
+        return chunk->error;
+    }
+
+    Buffer<nameTableElement> *chunkNames = chunk->context.nameTable;
+
+    size_t *globalIndices = (size_t *)calloc(chunkNames->currentIndex + 1, sizeof(size_t));
+    customWarning(globalIndices, compilationError::ALLOCATION_ERROR);
+
+    for (size_t nameIndex = 0; nameIndex < keywordsCount; nameIndex++) {
+        globalIndices[nameIndex] = nameIndex;
+    }
+
+    // a chunk table lists identifiers in order of first occurrence, which is the order the serial lexer interns them in
+    for (size_t nameIndex = keywordsCount; nameIndex < chunkNames->currentIndex; nameIndex++) {
+        const char *name        = chunkNames->data[nameIndex].name;
+        size_t      length      = getNameLength(&chunkNames->data[nameIndex]);
+        size_t      namesBefore = context->nameTable->currentIndex;
+
+        if (internName(context->nameTable, context->interner, name, length,
+                       nameType::IDENTIFIER, Keyword::UNDEFINED, &globalIndices[nameIndex]) != bufferError::NO_BUFFER_ERROR) {
+            FREE_(globalIndices);
+            return compilationError::CONTEXT_ERROR;
+        }
+
+        if (context->nameTable->currentIndex != namesBefore &&
+            addNameToTrie(context->trie, name, length, globalIndices[nameIndex]) != bufferError::NO_BUFFER_ERROR) {
+            FREE_(globalIndices);
+            return compilationError::CONTEXT_ERROR;
+        }
+    }
+
+    tokenStream *tokens = chunk->context.tokens;
+
+    // the last token of a chunk is its terminator
+    for (size_t tokenIndex = 0; tokenIndex + 1 < tokens->count; tokenIndex++) {
+        nodeData value = tokens->values.data[tokenIndex];
+
+        if (tokens->kinds.data[tokenIndex] == tokenKind::NAME) {
+            value.nameTableIndex = globalIndices[value.nameTableIndex];
+        }
+
+        if (addToken(context->tokens, tokens->kinds.data[tokenIndex], tokens->keywords.data[tokenIndex], value,
+                     context->currentLine + tokens->lines.data[tokenIndex] - 1,
+                     chunk->begin + tokens->offsets.data[tokenIndex]) != bufferError::NO_BUFFER_ERROR) {
+            FREE_(globalIndices);
+            return compilationError::TOKEN_BUFFER_ERROR;
+        }
+    }
+
+    FREE_(globalIndices);
+
+    context->currentLine += chunk->context.currentLine - 1;
+
+    return chunk->error;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
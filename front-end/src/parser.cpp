@@ -1,30 +1,78 @@
 #include "parser.h"
 #include "core.h"
 #include "nameTable.h"
+#include "keywordTable.h"
 #include "AST.h"
 #include "buffer.h"
 #include "binaryTreeDef.h"
 #include <cstdio>
+#include <cstring>
+
+static node<astNode> *getBinaryOperation  (compilationContext *context, size_t minPower, int localNameTableID);
+static node<astNode> *getUnaryOperation   (compilationContext *context, int localNameTableID);
+static node<astNode> *getPrimaryExpression(compilationContext *context, int localNameTableID);
+static node<astNode> *getExpressionLeaf   (compilationContext *context, astNode leaf);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+enum class operationAssociativity {
+    LEFT = 0, // a - b - c is (a - b) - c
+    NONE = 1, // a < b < c is not an expression
+};
+
+static const size_t LOOSEST_BINDING_POWER = 1;
+static const size_t NO_BINDING_POWER      = 0;
+static const size_t ANY_BINDING_POWER     = (size_t) -1;
+
+struct binaryLevel {
+    unsigned               priority      = NOT_AN_OPERATION;
+    size_t                 power         = NO_BINDING_POWER;
+    operationAssociativity associativity = operationAssociativity::LEFT;
+};
+
+// binary operations of keywords.def from the loosest to the tightest one
+static constexpr binaryLevel BINARY_LEVELS[] = {
+    {LOGICAL_OPERATION,        1, operationAssociativity::LEFT},
+    {COMPARISON_OPERATION,     2, operationAssociativity::NONE},
+    {ADDITIVE_OPERATION,       3, operationAssociativity::LEFT},
+    {MULTIPLICATIVE_OPERATION, 4, operationAssociativity::LEFT},
+};
+
+struct operationBinding {
+    bool                   isUnary       = false;            // may stand right before a primary expression
+    size_t                 power         = NO_BINDING_POWER; // as a binary operation, the larger the tighter
+    operationAssociativity associativity = operationAssociativity::LEFT;
+};
+
+struct operationBindings {
+    operationBinding bindings[KEYWORD_NUMBERS_COUNT] = {};
+};
+
+constexpr operationBindings buildOperationBindings() {
+    operationBindings table = {};
+
+    for (size_t keywordIndex = 0; keywordIndex < KEYWORDS_COUNT; keywordIndex++) {
+        operationBinding *binding = &table.bindings[(size_t) KEYWORDS[keywordIndex].keyword];
+
+        binding->isUnary = KEYWORDS[keywordIndex].priorities & UNARY_OPERATION;
+
+        for (size_t levelIndex = 0; levelIndex < sizeof(BINARY_LEVELS) / sizeof(BINARY_LEVELS[0]); levelIndex++) {
+            if (KEYWORDS[keywordIndex].priorities & BINARY_LEVELS[levelIndex].priority) {
+                binding->power         = BINARY_LEVELS[levelIndex].power;
+                binding->associativity = BINARY_LEVELS[levelIndex].associativity;
+            }
+        }
+    }
+
+    return table;
+}
+
+static constexpr operationBindings OPERATION_BINDINGS = buildOperationBindings();
+
+static_assert(OPERATION_BINDINGS.bindings[(size_t) Keyword::SUB].isUnary &&
+              OPERATION_BINDINGS.bindings[(size_t) Keyword::SUB].power != NO_BINDING_POWER,
+              "minus has to stay both unary and binary, getUnaryOperation rewrites it as 0 - value");
 
-static node<astNode> *getBinaryOperation      (compilationContext *context, size_t priority, int localNameTableID, bool onlyArythm);
-static node<astNode> *getUnaryOperation       (compilationContext *context, size_t priority, int localNameTableID, bool onlyArythm);
-static node<astNode> *getPrimaryExpression    (compilationContext *context, size_t priority, int localNameTableID, bool onlyArythm);
-static node<astNode> *getComparison           (compilationContext *context, size_t priority, int localNameTableID, bool onlyArythm);
-static node<astNode> *getOperationWithPriority(compilationContext *context, size_t priority, int localNameTableID);
-
-typedef node<astNode> *(* getterFunc) (compilationContext *, size_t, int, bool);
-
-static const size_t MAX_PRIORITY = 5;
-
-static const getterFunc nextFunction[]    = {getPrimaryExpression, getUnaryOperation, getBinaryOperation, getBinaryOperation, getComparison, getBinaryOperation};
-static const size_t     operationsCount[] = {0, 6, 2, 2, 6, 2};
-static const Keyword    operations[][6]   = {{},
-                                             {Keyword::SIN,   Keyword::COS,              Keyword::NOT,           Keyword::FLOOR,   Keyword::SQRT, Keyword::SUB},
-                                             {Keyword::MUL,   Keyword::DIV},
-                                             {Keyword::ADD,   Keyword::SUB},
-                                             {Keyword::EQUAL, Keyword::GREATER_OR_EQUAL, Keyword::LESS_OR_EQUAL, Keyword::GREATER, Keyword::LESS, Keyword::NOT_EQUAL},
-                                             {Keyword::AND,   Keyword::OR}};
-                                             
 // ------------------------------------------------------------------------------------------------------------------------------------------------- //
 
 #define IS_NULL(EXPRESSION, RET_POINTER) {   \
@@ -35,183 +83,166 @@ static const Keyword    operations[][6]   = {{},
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
-size_t getKeywordIndex(compilationContext *context, Keyword keyword) {
-    for (size_t i = 0; i < context->nameTable->currentIndex; i++) {
-        if (context->nameTable->data[i].keyword == keyword) {
-            return i;
-        }
-    }
-    return 0;
-}
-
-// -------------------------------------------------------------------------------------------------------------------------------------------------- //
-
 node<astNode> *getExpression(compilationContext *context, int localNameTableID) {
     customWarning(context, NULL);
 
-    return nextFunction[MAX_PRIORITY](context, MAX_PRIORITY, localNameTableID, false);
+    return getBinaryOperation(context, LOOSEST_BINDING_POWER, localNameTableID);
 }
 
-static node<astNode> *getBinaryOperation(compilationContext *context, size_t priority, int localNameTableID, bool onlyArythm) {
+// precedence climbing: the right operand takes every operation binding tighter than the current one, so operations of
+// equal power group to the left; nothing is written to errorBuffer unless an operand is really missing
+static node<astNode> *getBinaryOperation(compilationContext *context, size_t minPower, int localNameTableID) {
     customWarning(context, NULL);
 
-    node<astNode> *firstValue = nextFunction[priority - 1](context, priority - 1, localNameTableID, onlyArythm);
+    node<astNode> *firstValue = getUnaryOperation(context, localNameTableID);
     IS_NULL(firstValue, NULL);
 
-    while (true) {
-        node<astNode> *operation = getOperationWithPriority(context, priority, localNameTableID);
-        IS_NULL(operation, firstValue);
+    // a + b < c stops before a following comparison, a < b before any operation but a logical one
+    size_t maxPower = ANY_BINDING_POWER;
+
+    while (currentTokenKind == tokenKind::NAME) {
+        operationBinding binding = OPERATION_BINDINGS.bindings[(size_t) currentTokenKeyword];
 
-        if (onlyArythm) {
-            SYNTAX_ASSERT(false, compilationError::OPERATION_EXPECTED);
+        if (binding.power < minPower || binding.power > maxPower) {
+            break;
         }
 
-        node<astNode> *secondValue = nextFunction[priority - 1](context, priority - 1, localNameTableID, onlyArythm);
+        node<astNode> *operation = getTokenNode(context, context->tokenIndex++);
+        IS_NULL(operation, NULL);
+
+        node<astNode> *secondValue = getBinaryOperation(context, binding.power + 1, localNameTableID);
         IS_NULL(secondValue, NULL);
 
-        operation->left     = firstValue;
-        firstValue->parent  = operation;
+        operation->left  = firstValue;
+        operation->right = secondValue;
 
-        operation->right    = secondValue;
-        secondValue->parent = operation;
+        linkExpression(firstValue,  operation);
+        linkExpression(secondValue, operation);
+
+        if (context->expressions) {
+            operation = internOperation(context->expressions, context->AST, context->nameTable, operation);
+        }
 
         firstValue = operation;
+        maxPower   = binding.associativity == operationAssociativity::NONE ? binding.power - 1 : binding.power;
     }
+
+    return firstValue;
 }
 
-static node<astNode> *getUnaryOperation(compilationContext *context, size_t priority, int localNameTableID, bool onlyArythm) {
+static node<astNode> *getUnaryOperation(compilationContext *context, int localNameTableID) {
     customWarning(context, NULL);
 
-    node<astNode> *operation = getOperationWithPriority(context, priority, localNameTableID);
-    node<astNode> *value     = nextFunction[priority - 1](context, priority - 1, localNameTableID, onlyArythm);
+    if (currentTokenKind != tokenKind::NAME || !OPERATION_BINDINGS.bindings[(size_t) currentTokenKeyword].isUnary) {
+        return getPrimaryExpression(context, localNameTableID);
+    }
+
+    Keyword        operationKeyword = currentTokenKeyword;
+    node<astNode> *operation        = getTokenNode(context, context->tokenIndex++);
+    IS_NULL(operation, NULL);
 
+    node<astNode> *value = getPrimaryExpression(context, localNameTableID);
     IS_NULL(value, NULL);
 
-    if (operation) {
-        if (onlyArythm) {
-            SYNTAX_ASSERT(false, compilationError::OPERATION_EXPECTED);
-        }
+    operation->right = value;
+    linkExpression(value, operation);
 
-        operation->right = value;
-        value->parent    = operation;
+    if (operationKeyword != Keyword::SUB) {
+        return operation;
+    }
 
-        if (context->nameTable->data[operation->data.data.nameTableIndex].keyword == Keyword::SUB) {
-            operation->left         = _CONST_(0);
-            operation->left->parent = operation;
-        }
+    operation->left = getExpressionLeaf(context, {.type = nodeType::CONSTANT, .data = {.number = 0}, .line = getNodeLine(context)});
+    IS_NULL(operation->left, NULL);
 
-        value = operation;
-    }
+    linkExpression(operation->left, operation);
 
-    return value;
+    return context->expressions ? internOperation(context->expressions, context->AST, context->nameTable, operation) : operation;
 }
 
-static node<astNode> *getComparison(compilationContext *context, size_t priority, int localNameTableID, bool onlyArythm) {
+// the current token alone picks the alternative, CONSTANT_EXPECTED is left when none fits
+static node<astNode> *getPrimaryExpression(compilationContext *context, int localNameTableID) {
     customWarning(context, NULL);
 
-    node<astNode> *firstValue = nextFunction[priority - 1](context, priority - 1, localNameTableID, onlyArythm);
-    IS_NULL(firstValue, NULL);
+    size_t tokenIndex = context->tokenIndex;
+    int    tokenLine  = context->tokens->lines.data[tokenIndex] - context->lineBase;
 
-    node<astNode> *operation = getOperationWithPriority(context, priority, localNameTableID);
-    IS_NULL(operation, firstValue);
+    if (currentTokenKind == tokenKind::CONSTANT) {
+        context->tokenIndex++;
 
-    if (onlyArythm) {
-        SYNTAX_ASSERT(false, compilationError::OPERATION_EXPECTED);
+        return getExpressionLeaf(context, {.type = nodeType::CONSTANT, .data = {.number = context->tokens->values.data[tokenIndex].number},
+                                           .line = tokenLine});
     }
 
-    node<astNode> *secondValue = nextFunction[priority - 1](context, priority - 1, localNameTableID, onlyArythm);
-    IS_NULL(secondValue, NULL);
-
-    operation->left     = firstValue;
-    firstValue->parent  = operation;
-
-    operation->right    = secondValue;
-    secondValue->parent = operation;
-
-    return operation;
-}
+    if (currentTokenKind != tokenKind::NAME) {
+        return getConstant(context);
+    }
 
-static node<astNode> *getPrimaryExpression(compilationContext *context, size_t priority, int localNameTableID, bool onlyArythm) {
-    customWarning(context, NULL);
+    if (isCurrentKeyword(context, Keyword::LEFT_BRACKET)) {
+        context->tokenIndex++;
 
-    if (getTokenAndDestroy(context, Keyword::LEFT_BRACKET, compilationError::BRACKET_EXPECTED)) {
-        node<astNode> *expression = nextFunction[MAX_PRIORITY](context, MAX_PRIORITY, localNameTableID, onlyArythm);
+        node<astNode> *expression = getExpression(context, localNameTableID);
 
-        IS_NULL(getTokenAndDestroy(context, Keyword::RIGHT_BRACKET, compilationError::BRACKET_EXPECTED), NULL);
+        IS_NULL(skipKeyword(context, Keyword::RIGHT_BRACKET, compilationError::BRACKET_EXPECTED), NULL);
 
         return expression;
     }
 
-    else {
-        context->errorBuffer->currentIndex--;
+    if (isCurrentKeyword(context, Keyword::FUNCTION_CALL)) {
+        return getFunctionCall(context, localNameTableID);
     }
 
-    node<astNode> *functionCall = getFunctionCall(context, localNameTableID);
-    CHECK_FOR_ERROR(functionCall, compilationError::FUNCTION_CALL_EXPECTED);
-
-    if (functionCall) {
-        return functionCall;
-    }
+    if (context->nameTable->data[currentNameTableIndex].type == nameType::IDENTIFIER) {
+        size_t identifierIndex = currentNameTableIndex;
+        context->tokenIndex++;
 
-    node<astNode> *terminalSymbol = getStringToken(context, nameType::IDENTIFIER, compilationError::IDENTIFIER_EXPECTED);
+        DECLARATION_ASSERT(identifierIndex, localNameType::VARIABLE_IDENTIFIER, compilationError::VARIABLE_NOT_DECLARED);
 
-    if (terminalSymbol) {
-        DECLARATION_ASSERT(terminalSymbol, localNameType::VARIABLE_IDENTIFIER, compilationError::VARIABLE_NOT_DECLARED);
-
-        return terminalSymbol;
+        return getExpressionLeaf(context, {.type = nodeType::STRING, .data = {.nameTableIndex = identifierIndex}, .line = tokenLine});
     }
 
-    context->errorBuffer->currentIndex--;
-    terminalSymbol = getKeyword(context, Keyword::IN, compilationError::IN_EXPECTED);
-
-    if (terminalSymbol) {
-        return terminalSymbol;
+    if (isCurrentKeyword(context, Keyword::IN)) {
+        return getTokenNode(context, context->tokenIndex++);
     }
 
-    context->errorBuffer->currentIndex--;
-
-    terminalSymbol = getConstant(context);
-
-    return terminalSymbol;
+    return getConstant(context);
 }
 
-static node<astNode> *getOperationWithPriority(compilationContext *context, size_t priority, int localnameTableID) {
+// constants and variable reads are interned while expressions are shared, a repeated one is never allocated again
+static node<astNode> *getExpressionLeaf(compilationContext *context, astNode leaf) {
     customWarning(context, NULL);
 
-    node<astNode> *operation = NULL;
-
-    for (size_t operationIndex = 0; operationIndex < operationsCount[priority]; operationIndex++) {
-        operation = getKeyword(context, operations[priority][operationIndex], compilationError::OPERATION_EXPECTED);
-
-        if (!operation) {
-            context->errorBuffer->currentIndex--;
-        }
-
-        else {
-            break;
-        }
+    if (context->expressions) {
+        return internLeaf(context->expressions, context->AST, leaf);
     }
 
-    return operation;
+    return emplaceNode(context->AST, node<astNode> {.data = leaf, .left = NULL, .right = NULL, .parent = NULL});
 }
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
 static node<astNode> *getGrammar              (compilationContext *context);
 static node<astNode> *getTranslationUnit      (compilationContext *context);
+static node<astNode> *getTopLevelDeclaration  (compilationContext *context);
 static node<astNode> *getExternalDeclaration  (compilationContext *context);
 static node<astNode> *getFunctionDefinition   (compilationContext *context, int     localNameTableID);
+static node<astNode> *getFunctionScope        (compilationContext *context, int     localNameTableID);
 static node<astNode> *getDeclaration          (compilationContext *context, int     localNameTableID);
 static node<astNode> *getOperator             (compilationContext *context, int     localNameTableID);
 static node<astNode> *getInitializerDeclarator(compilationContext *context, int     localNameTableID);
 static node<astNode> *getAssignmentExpression (compilationContext *context, int     localNameTableID);
-static node<astNode> *getConditionOperator    (compilationContext *context, Keyword operatorKeyword, compilationError error, int localNameTableID);
+static node<astNode> *getAssignedExpression   (compilationContext *context, size_t  identifierToken, int localNameTableID);
+static node<astNode> *getConditionOperator    (compilationContext *context, Keyword operatorKeyword, int localNameTableID);
 static node<astNode> *getOperatorList         (compilationContext *context, int     localNameTableID);
 static node<astNode> *getArgumentList         (compilationContext *context, int     localNameTableID);
 static node<astNode> *getParameterList        (compilationContext *context, int     localNameTableID);
 static node<astNode> *getReturnOperator       (compilationContext *context, int     localNameTableID);
 static node<astNode> *getOutOperator          (compilationContext *context, int     localNameTableID);
 
+static int              declareFunction     (compilationContext *context, size_t identifierIndex);
+static bool             isFunctionReparsed  (compilationContext *context, node<astNode> *definition, size_t functionIndex,
+                                             size_t firstToken, size_t tokensCount, size_t firstCall);
+static void             releaseDefinition   (compilationContext *context, node<astNode> **definition);
+
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
 compilationError parseCode(compilationContext *context) {
@@ -224,170 +255,367 @@ compilationError parseCode(compilationContext *context) {
     return context->error;
 }
 
+compilationError reparseDeclaration(compilationContext *context, size_t declarationIndex, size_t firstToken, size_t tokensCount) {
+    customWarning(context != NULL,                                        compilationError::CONTEXT_ERROR);
+    customWarning(declarationIndex < context->declarations->currentIndex, compilationError::CONTEXT_ERROR);
+
+    declarationRange *declaration   = &context->declarations->data[declarationIndex];
+    node<astNode>    *oldDefinition = declaration->separator->left;
+
+    if (!oldDefinition || oldDefinition->data.type != nodeType::FUNCTION_DEFINITION) {
+        return compilationError::FUNCTION_EXPECTED;
+    }
+
+    // a finished parse leaves only the global scope in the chain
+    if (context->scopes->currentIndex != 1) {
+        return compilationError::CONTEXT_ERROR;
+    }
+
+    size_t functionIndex = oldDefinition->data.data.nameTableIndex;
+
+    int globalEntry = findInScope(context->scopes, 0, context->localTables, functionIndex, localNameType::FUNCTION_IDENTIFIER);
+    int localTable  = declaration->localTable;
+
+    if (globalEntry < 0 || localTable < 0) {
+        return compilationError::FUNCTION_NOT_DECLARED;
+    }
+
+    // the old slots are hidden until getFunctionDefinition declares the function again
+    if (renameInScope(context->scopes, 0, context->localTables, (size_t) globalEntry, REPARSED_FUNCTION_NAME) != bufferError::NO_BUFFER_ERROR) {
+        return compilationError::ALLOCATION_ERROR;
+    }
+
+    // the old table is kept aside until the new definition is known to be good, so a failure can put it back
+    localNameTable oldTable = context->localTables->data[localTable];
+
+    context->localTables->data[localTable]             = {};
+    context->localTables->data[localTable].nameTableID = REPARSED_FUNCTION_TABLE;
+    context->reparsedTable                             = localTable;
+
+    if (bufferInitialize(&context->localTables->data[localTable].elements) != bufferError::NO_BUFFER_ERROR) {
+        context->localTables->data[localTable] = oldTable;
+        context->reparsedTable                 = -1;
+        renameInScope(context->scopes, 0, context->localTables, (size_t) globalEntry, functionIndex);
+
+        return compilationError::ALLOCATION_ERROR;
+    }
+
+    size_t firstCall   = context->functionCalls->currentIndex;
+    size_t errorsCount = context->errorBuffer->currentIndex;
+
+    context->tokenIndex = firstToken;
+    context->lineBase   = context->tokens->lines.data[firstToken];
+
+    if (context->expressions) {
+        clearExpressionTable(context->expressions);
+    }
+
+    node<astNode> *definition = getFunctionDefinition(context, 0);
+
+    context->reparsedTable = -1;
+
+    if (!isFunctionReparsed(context, definition, functionIndex, firstToken, tokensCount, firstCall)) {
+        releaseDefinition(context, &definition);
+
+        bufferDestruct(&context->localTables->data[localTable].elements);
+
+        context->localTables->data[localTable] = oldTable;
+        renameInScope(context->scopes, 0, context->localTables, (size_t) globalEntry, functionIndex);
+
+        context->functionCalls->currentIndex = firstCall;
+        context->errorBuffer->currentIndex   = errorsCount;
+
+        return compilationError::FUNCTION_EXPECTED;
+    }
+
+    bufferDestruct(&oldTable.elements);
+
+    releaseDefinition(context, &declaration->separator->left);
+
+    declaration->separator->left      = definition;
+    declaration->separator->data.line = context->tokens->lines.data[context->tokenIndex - 1] - context->lineBase;
+    definition->parent                = declaration->separator;
+
+    // the calls of the new definition were appended, the old ones are left where they are like the old tokens
+    declaration->firstToken  = firstToken;
+    declaration->tokensCount = tokensCount;
+    declaration->firstCall   = firstCall;
+    declaration->callsCount  = context->functionCalls->currentIndex - firstCall;
+
+    return compilationError::NO_ERRORS;
+}
+
+// the new definition has to cover exactly the relexed tokens and keep its name, otherwise the whole file is parsed again
+static bool isFunctionReparsed(compilationContext *context, node<astNode> *definition, size_t functionIndex,
+                               size_t firstToken, size_t tokensCount, size_t firstCall) {
+    customWarning(context, false);
+
+    if (!definition || definition->data.data.nameTableIndex != functionIndex ||
+        !skipKeyword(context, Keyword::OPERATOR_SEPARATOR, compilationError::OPERATOR_SEPARATOR_EXPECTED) ||
+        context->tokenIndex != firstToken + tokensCount) {
+        return false;
+    }
+
+    int localNameTableID = 0;
+
+    for (size_t callIndex = firstCall; callIndex < context->functionCalls->currentIndex; callIndex++) {
+        DECLARATION_ASSERT_RETURN(context->functionCalls->data[callIndex]->data.data.nameTableIndex,
+                                  localNameType::FUNCTION_IDENTIFIER, compilationError::FUNCTION_NOT_DECLARED, false);
+    }
+
+    return true;
+}
+
+// a shared expression may be used more than once in the definition, only the last reference frees it
+static void releaseDefinition(compilationContext *context, node<astNode> **definition) {
+    if (!*definition) {
+        return;
+    }
+
+    if (context->expressions) {
+        releaseSharedSubtree(context->AST, definition);
+    } else {
+        nodeDestruct(context->AST, definition);
+    }
+}
+
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
 static node<astNode> *getGrammar(compilationContext *context) {
     customWarning(context, NULL);
 
-    IS_NULL(getTokenAndDestroy(context, Keyword::INITIAL_OPERATOR, compilationError::INITIAL_OPERATOR_EXPECTED), NULL);
+    IS_NULL(skipKeyword(context, Keyword::INITIAL_OPERATOR, compilationError::INITIAL_OPERATOR_EXPECTED), NULL);
 
-    node<astNode> *entryPointIdentifier = getStringToken(context, nameType::IDENTIFIER, compilationError::IDENTIFIER_EXPECTED);
-    IS_NULL(entryPointIdentifier, NULL);
+    size_t entryPointIndex = 0;
+    IS_NULL(getNameIndex(context, nameType::IDENTIFIER, compilationError::IDENTIFIER_EXPECTED, &entryPointIndex), NULL);
 
-    IS_NULL(getTokenAndDestroy(context, Keyword::OPERATOR_SEPARATOR, compilationError::OPERATOR_SEPARATOR_EXPECTED), NULL);
+    IS_NULL(skipKeyword(context, Keyword::OPERATOR_SEPARATOR, compilationError::OPERATOR_SEPARATOR_EXPECTED), NULL);
 
-    context->entryPoint = entryPointIdentifier->data.data.nameTableIndex;
+    context->entryPoint = entryPointIndex;
 
     node<astNode> *rootNode = getTranslationUnit(context);
     IS_NULL(rootNode, NULL);
 
-    destroySingleNode(entryPointIdentifier);
-
     int localNameTableID = 0;
 
     for (size_t callIndex = 0; callIndex < context->functionCalls->currentIndex; callIndex++) {
-        DECLARATION_ASSERT(context->functionCalls->data[callIndex], localNameType::FUNCTION_IDENTIFIER, compilationError::FUNCTION_NOT_DECLARED);
+        DECLARATION_ASSERT(context->functionCalls->data[callIndex]->data.data.nameTableIndex,
+                           localNameType::FUNCTION_IDENTIFIER, compilationError::FUNCTION_NOT_DECLARED);
     }
 
     return rootNode;
 }
 
+// a failed declaration ends the chain, the ones before it stay in the tree
 static node<astNode> *getTranslationUnit(compilationContext *context) {
     customWarning(context, NULL);
 
+    node<astNode> *root          = NULL;
+    node<astNode> *lastSeparator = NULL;
+
+    do {
+        node<astNode> *separator = getTopLevelDeclaration(context);
+
+        if (!separator) {
+            break;
+        }
+
+        if (lastSeparator) {
+            lastSeparator->right = separator;
+            separator->parent    = lastSeparator;
+        } else {
+            root = separator;
+        }
+
+        lastSeparator = separator;
+    } while (currentTokenKind != tokenKind::TERMINATOR);
+
+    return root;
+}
+
+static node<astNode> *getTopLevelDeclaration(compilationContext *context) {
+    customWarning(context, NULL);
+
+    declarationRange declaration = {.firstToken = context->tokenIndex, .firstCall = context->functionCalls->currentIndex};
+    size_t           tablesCount = context->localTables->currentIndex;
+
+    context->lineBase = context->tokens->lines.data[declaration.firstToken];
+
+    if (context->expressions) {
+        clearExpressionTable(context->expressions);
+    }
+
     node<astNode> *externalDeclaration = getExternalDeclaration(context);
     IS_NULL(externalDeclaration, NULL);
 
-    SYNTAX_ASSERT(currentToken->data.type == nodeType::STRING &&
-                  context->nameTable->data[currentNameTableIndex].keyword == Keyword::OPERATOR_SEPARATOR,
-                  compilationError::OPERATOR_SEPARATOR_EXPECTED);
-
-    node<astNode> *separator = currentToken;
-    ++context->tokenIndex;
+    node<astNode> *separator = getKeyword(context, Keyword::OPERATOR_SEPARATOR, compilationError::OPERATOR_SEPARATOR_EXPECTED);
+    IS_NULL(separator, NULL);
 
     _OPERATOR_SEPARATOR_(separator, externalDeclaration, NULL);
 
-    node<astNode> *root = separator;
-
-    if (currentToken->data.type != nodeType::TERMINATOR) {
-        root->right = getTranslationUnit(context);
+    declaration.tokensCount = context->tokenIndex - declaration.firstToken;
+    declaration.callsCount  = context->functionCalls->currentIndex - declaration.firstCall;
+    declaration.separator   = separator;
 
-        if (root->right) {
-            root->right->parent = root;
-        }
+    // declareFunction adds the table of a function before any of its blocks
+    if (externalDeclaration->data.type == nodeType::FUNCTION_DEFINITION) {
+        declaration.localTable = (int) tablesCount;
     }
 
-    return root;
+    writeDataToBuffer(context->declarations, &declaration, 1);
+
+    return separator;
 }
 
 static node<astNode> *getExternalDeclaration(compilationContext *context) {
     customWarning(context, NULL);
 
-    node<astNode> *root = getFunctionDefinition(context, 0);
-
-    if (root) {
-        return root;
+    if (isCurrentKeyword(context, Keyword::FUNCTION_DEFINITION)) {
+        return getFunctionDefinition(context, 0);
     }
 
-    CHECK_FOR_ERROR(root, compilationError::FUNCTION_EXPECTED);
-
-    root = getDeclaration(context, 0);
-
-    return root;
+    return getDeclaration(context, 0);
 }
 
 static node<astNode> *getFunctionDefinition(compilationContext *context, int localNameTableID) {
     customWarning(context, NULL);
 
-    IS_NULL(getTokenAndDestroy(context, Keyword::FUNCTION_DEFINITION, compilationError::FUNCTION_EXPECTED) != false, NULL);
+    IS_NULL(skipKeyword(context, Keyword::FUNCTION_DEFINITION, compilationError::FUNCTION_EXPECTED) != false, NULL);
     
-    node<astNode> *type = getStringToken(context, nameType::TYPE_NAME, compilationError::TYPE_NAME_EXPECTED);
-    IS_NULL(type, NULL);
+    size_t typeToken = context->tokenIndex;
+    size_t typeIndex = 0;
+    IS_NULL(getNameIndex(context, nameType::TYPE_NAME, compilationError::TYPE_NAME_EXPECTED, &typeIndex), NULL);
 
-    node<astNode> *identifier = getStringToken(context, nameType::IDENTIFIER, compilationError::IDENTIFIER_EXPECTED);
-    IS_NULL(identifier, NULL);
-
-    size_t identifierIndex = identifier->data.data.nameTableIndex;
+    size_t identifierIndex = 0;
+    IS_NULL(getNameIndex(context, nameType::IDENTIFIER, compilationError::IDENTIFIER_EXPECTED, &identifierIndex), NULL);
 
-    REDECLARATION_ASSERT(identifier,
+    REDECLARATION_ASSERT(identifierIndex,
                          (localNameType) ((int) localNameType::VARIABLE_IDENTIFIER | (int) localNameType::FUNCTION_IDENTIFIER),
                          compilationError::FUNCTION_REDEFINITION);
 
-    --context->tokenIndex;
-    DESTROY_CURRENT_NODE();
-    ++context->tokenIndex;
+    int newNameTableIndex = declareFunction(context, identifierIndex);
+    IS_NULL(newNameTableIndex >= 0, NULL);
 
-    int newNameTableIndex = addLocalNameTable((int) identifierIndex, context->localTables);
-    
-    addLocalIdentifier(0, context->localTables,
-                       localNameTableElement {.type = localNameType::FUNCTION_IDENTIFIER, .globalNameID = identifierIndex}, 1);
-    
-    IS_NULL(getTokenAndDestroy(context, Keyword::LEFT_BRACKET, compilationError::BRACKET_EXPECTED), NULL);
+    // parameters and locals of the function live in its own scope, it is left even if the function does not parse
+    IS_NULL(pushScope(context->scopes, newNameTableIndex) == bufferError::NO_BUFFER_ERROR, NULL);
+
+    node<astNode> *parametersAndContent = getFunctionScope(context, newNameTableIndex);
+
+    popScope(context->scopes);
+
+    IS_NULL(parametersAndContent, NULL);
+
+    return _FUNCTION_DEFINITION_(getTokenNode(context, typeToken), parametersAndContent, identifierIndex);
+}
+
+static node<astNode> *getFunctionScope(compilationContext *context, int localNameTableID) {
+    customWarning(context, NULL);
+
+    IS_NULL(skipKeyword(context, Keyword::LEFT_BRACKET, compilationError::BRACKET_EXPECTED), NULL);
     
-    node<astNode> *parameters = getParameterList(context, newNameTableIndex);
-    CHECK_FOR_ERROR(parameters, compilationError::TYPE_NAME_EXPECTED);
+    node<astNode> *parameters = NULL;
+
+    if (!isCurrentKeyword(context, Keyword::RIGHT_BRACKET)) {
+        parameters = getParameterList(context, localNameTableID);
+        IS_NULL(parameters, NULL);
+    }
 
-    IS_NULL(getTokenAndDestroy(context, Keyword::RIGHT_BRACKET, compilationError::BRACKET_EXPECTED),    NULL);
-    IS_NULL(getTokenAndDestroy(context, Keyword::BLOCK_OPEN,    compilationError::CODE_BLOCK_EXPECTED), NULL);
+    IS_NULL(skipKeyword(context, Keyword::RIGHT_BRACKET, compilationError::BRACKET_EXPECTED),    NULL);
+    IS_NULL(skipKeyword(context, Keyword::BLOCK_OPEN,    compilationError::CODE_BLOCK_EXPECTED), NULL);
 
-    node<astNode> *functionContent = getOperatorList(context, newNameTableIndex);
-    CHECK_FOR_ERROR(functionContent, compilationError::OPERATOR_NOT_FOUND);
+    node<astNode> *functionContent = NULL;
 
-    IS_NULL(getTokenAndDestroy(context, Keyword::BLOCK_CLOSE, compilationError::CODE_BLOCK_EXPECTED), NULL);
+    if (!isCurrentKeyword(context, Keyword::BLOCK_CLOSE)) {
+        functionContent = getOperatorList(context, localNameTableID);
+        IS_NULL(functionContent, NULL);
+    }
 
-    return _FUNCTION_DEFINITION_(type, _PARAMETERS_(parameters, functionContent), identifierIndex);
+    IS_NULL(skipKeyword(context, Keyword::BLOCK_CLOSE, compilationError::CODE_BLOCK_EXPECTED), NULL);
+
+    return _PARAMETERS_(parameters, functionContent);
+}
+
+// a function parsed again by reparseDeclaration takes back its slot in the global table and its local table
+static int declareFunction(compilationContext *context, size_t identifierIndex) {
+    customWarning(context, -1);
+
+    int globalEntry = findInScope(context->scopes, 0, context->localTables, REPARSED_FUNCTION_NAME, localNameType::FUNCTION_IDENTIFIER);
+    int localTable  = context->reparsedTable;
+
+    if (globalEntry >= 0 && localTable >= 0) {
+        if (renameInScope(context->scopes, 0, context->localTables, (size_t) globalEntry, identifierIndex) != bufferError::NO_BUFFER_ERROR) {
+            return -1;
+        }
+
+        context->localTables->data[localTable].nameTableID = (int) identifierIndex;
+
+        return localTable;
+    }
+
+    int newNameTableIndex = addLocalNameTable((int) identifierIndex, context->localTables);
+
+    if (declareInScope(context->scopes, context->localTables,
+                       localNameTableElement {.type = localNameType::FUNCTION_IDENTIFIER, .globalNameID = identifierIndex}) !=
+        bufferError::NO_BUFFER_ERROR) {
+        return -1;
+    }
+
+    return newNameTableIndex;
 }
 
 static node<astNode> *getDeclaration(compilationContext *context, int localNameTableID) {
     customWarning(context, NULL);
 
-    node<astNode> *type = getStringToken(context, nameType::TYPE_NAME, compilationError::TYPE_NAME_EXPECTED);
-    IS_NULL(type, NULL);
+    size_t typeToken = context->tokenIndex;
+    size_t typeIndex = 0;
+    IS_NULL(getNameIndex(context, nameType::TYPE_NAME, compilationError::TYPE_NAME_EXPECTED, &typeIndex), NULL);
 
-    node<astNode> *identifier = getStringToken(context, nameType::IDENTIFIER, compilationError::IDENTIFIER_EXPECTED);
-    IS_NULL(identifier, NULL);
+    size_t identifierIndex = 0;
+    IS_NULL(getNameIndex(context, nameType::IDENTIFIER, compilationError::IDENTIFIER_EXPECTED, &identifierIndex), NULL);
 
     context->tokenIndex--;
 
-    size_t identifierIndex = identifier->data.data.nameTableIndex;
-
-    REDECLARATION_ASSERT(identifier,
+    REDECLARATION_ASSERT(identifierIndex,
                         (localNameType) ((int) localNameType::VARIABLE_IDENTIFIER | (int) localNameType::FUNCTION_IDENTIFIER),
                         compilationError::VARIABLE_REDECLARATION);
 
-    addLocalIdentifier(localNameTableID, context->localTables,
-                       localNameTableElement {.type = localNameType::VARIABLE_IDENTIFIER, .globalNameID = identifierIndex}, 1);
+    IS_NULL(declareInScope(context->scopes, context->localTables,
+                           localNameTableElement {.type = localNameType::VARIABLE_IDENTIFIER, .globalNameID = identifierIndex}) ==
+            bufferError::NO_BUFFER_ERROR, NULL);
 
     node<astNode> *initializerDeclarator = getInitializerDeclarator(context, localNameTableID);
     IS_NULL(initializerDeclarator, NULL);
 
-    return _VARIABLE_DECLARATION_(type, initializerDeclarator, identifierIndex);
+    return _VARIABLE_DECLARATION_(getTokenNode(context, typeToken), initializerDeclarator, identifierIndex);
 }
 
+// the declared identifier is the current token, the one after it tells an initialized declaration from a bare one
 static node<astNode> *getInitializerDeclarator(compilationContext *context, int localNameTableID) {
     customWarning(context, NULL);
 
-    node<astNode> *initializer = getAssignmentExpression(context, localNameTableID);
+    size_t identifierToken = context->tokenIndex++;
 
-    if (initializer) {
-        return initializer;
+    if (isCurrentKeyword(context, Keyword::ASSIGNMENT)) {
+        return getAssignedExpression(context, identifierToken, localNameTableID);
     }
 
-    CHECK_FOR_ERROR(initializer, compilationError::ASSIGNMENT_EXPECTED);
-    context->tokenIndex--;
-
-    initializer = getStringToken(context, nameType::IDENTIFIER, compilationError::IDENTIFIER_EXPECTED);
-
-    return initializer;
+    return getTokenNode(context, identifierToken);
 }
 
-static node<astNode> *getAssignmentExpression (compilationContext *context, int localNameTableID) {
+static node<astNode> *getAssignmentExpression(compilationContext *context, int localNameTableID) {
     customWarning(context, NULL);
 
-    node<astNode> *identifier = getStringToken(context, nameType::IDENTIFIER, compilationError::IDENTIFIER_EXPECTED);
-    IS_NULL(identifier, NULL);
+    size_t identifierToken = context->tokenIndex;
+    size_t identifierIndex = 0;
+    IS_NULL(getNameIndex(context, nameType::IDENTIFIER, compilationError::IDENTIFIER_EXPECTED, &identifierIndex), NULL);
+
+    DECLARATION_ASSERT(identifierIndex, localNameType::VARIABLE_IDENTIFIER, compilationError::VARIABLE_NOT_DECLARED);
+
+    return getAssignedExpression(context, identifierToken, localNameTableID);
+}
 
-    DECLARATION_ASSERT(identifier, localNameType::VARIABLE_IDENTIFIER, compilationError::VARIABLE_NOT_DECLARED);
+static node<astNode> *getAssignedExpression(compilationContext *context, size_t identifierToken, int localNameTableID) {
+    customWarning(context, NULL);
 
     node<astNode> *assignmentOperation = getKeyword(context, Keyword::ASSIGNMENT, compilationError::ASSIGNMENT_EXPECTED);
     IS_NULL(assignmentOperation, NULL);
@@ -396,7 +624,9 @@ static node<astNode> *getAssignmentExpression (compilationContext *context, int
     IS_NULL(expression, NULL);
 
     assignmentOperation->left  = expression;
-    expression->parent         = assignmentOperation;
+    linkExpression(expression, assignmentOperation);
+
+    node<astNode> *identifier  = getTokenNode(context, identifierToken);
 
     assignmentOperation->right = identifier;
     identifier->parent         = assignmentOperation;
@@ -406,137 +636,125 @@ static node<astNode> *getAssignmentExpression (compilationContext *context, int
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
+// the current token alone picks the operator, OPERATOR_NOT_FOUND is recorded only when no operator starts with it
 static node<astNode> *getOperator(compilationContext *context, int localNameTableID) {
     customWarning(context, NULL);
 
-    node<astNode> *expectedOperator = NULL;
+    SYNTAX_ASSERT(currentTokenKind == tokenKind::NAME, compilationError::OPERATOR_NOT_FOUND);
 
-    expectedOperator = getConditionOperator(context, Keyword::IF, compilationError::IF_EXPECTED, localNameTableID);
-    CHECK_FOR_ERROR(expectedOperator, compilationError::IF_EXPECTED);
+    node<astNode> *expectedOperator = NULL;
 
-    if (expectedOperator) {
-        size_t separatorIndex = getKeywordIndex(context, Keyword::OPERATOR_SEPARATOR);
-        node<astNode> *separator = emplaceNode(node<astNode>
+    switch (currentTokenKeyword) {
+        case Keyword::IF:
+        case Keyword::WHILE:
             {
-                .data = {
-                    .type = nodeType::STRING,
-                    .data = {.nameTableIndex = separatorIndex},
-                    .line = context->currentLine
-                },
-                .left = expectedOperator,
-                .right = NULL,
-                .parent = NULL
-            });
-        if (expectedOperator) expectedOperator->parent = separator;
-        return separator;
-    }
+                expectedOperator = getConditionOperator(context, currentTokenKeyword, localNameTableID);
+                IS_NULL(expectedOperator, NULL);
+
+                // the guarded operator has already taken the separator
+                size_t separatorIndex = getKeywordNameIndex(Keyword::OPERATOR_SEPARATOR);
+                node<astNode> *separator = emplaceNode(context->AST, node<astNode>
+                    {
+                        .data = {
+                            .type = nodeType::STRING,
+                            .data = {.nameTableIndex = separatorIndex},
+                            .line = getNodeLine(context)
+                        },
+                        .left = expectedOperator,
+                        .right = NULL,
+                        .parent = NULL
+                    });
+                expectedOperator->parent = separator;
+                return separator;
+            }
+
+        case Keyword::ABORT:
+        case Keyword::BREAK:
+        case Keyword::CONTINUE:
+            expectedOperator = getTokenNode(context, context->tokenIndex++);
+            break;
 
-    expectedOperator = getConditionOperator(context, Keyword::WHILE, compilationError::WHILE_EXPECTED, localNameTableID);
-    CHECK_FOR_ERROR(expectedOperator, compilationError::WHILE_EXPECTED);
+        case Keyword::OUT:
+            expectedOperator = getOutOperator(context, localNameTableID);
+            break;
 
-    if (expectedOperator) {
-        size_t separatorIndex = getKeywordIndex(context, Keyword::OPERATOR_SEPARATOR);
-        node<astNode> *separator = emplaceNode(node<astNode>
-            {
-                .data = {
-                    .type = nodeType::STRING,
-                    .data = {.nameTableIndex = separatorIndex},
-                    .line = context->currentLine
-                },
-                .left = expectedOperator,
-                .right = NULL,
-                .parent = NULL
-            });
-        if (expectedOperator) expectedOperator->parent = separator;
-        return separator;
-    }
+        case Keyword::RETURN:
+            expectedOperator = getReturnOperator(context, localNameTableID);
+            break;
 
-    #define GET_EXPECTED_OPERATOR(FUNCTION, ERROR)              \
-        expectedOperator = FUNCTION(context, localNameTableID); \
-        TRY_GET_OPERATOR(ERROR);
+        case Keyword::FUNCTION_CALL:
+            expectedOperator = getFunctionCall(context, localNameTableID);
+            break;
 
-    do {
-        expectedOperator = getKeyword(context, Keyword::ABORT, compilationError::ABORT_EXPECTED);
-        TRY_GET_OPERATOR(ABORT_EXPECTED);
-
-        expectedOperator = getKeyword(context, Keyword::BREAK, compilationError::BREAK_EXPECTED);
-        TRY_GET_OPERATOR(BREAK_EXPECTED);
-
-        expectedOperator = getKeyword(context, Keyword::CONTINUE, compilationError::CONTINUE_EXPECTED);
-        TRY_GET_OPERATOR(CONTINUE_EXPECTED);
-
-        GET_EXPECTED_OPERATOR(getOutOperator,          OUT_EXPECTED);
-        GET_EXPECTED_OPERATOR(getReturnOperator,       RETURN_EXPECTED);
-        GET_EXPECTED_OPERATOR(getFunctionCall,         FUNCTION_CALL_EXPECTED);
-        GET_EXPECTED_OPERATOR(getAssignmentExpression, IDENTIFIER_EXPECTED);
-        GET_EXPECTED_OPERATOR(getDeclaration,          TYPE_NAME_EXPECTED);
-        
-        IS_NULL(getTokenAndDestroy(context, Keyword::BLOCK_OPEN, compilationError::OPERATOR_NOT_FOUND), NULL);
-        expectedOperator = getOperatorList(context, localNameTableID);
-        IS_NULL(expectedOperator, NULL);
-        IS_NULL(getTokenAndDestroy(context, Keyword::BLOCK_CLOSE, compilationError::OPERATOR_NOT_FOUND), NULL);
-    } while (0);
+        case Keyword::BLOCK_OPEN:
+            context->tokenIndex++;
 
-    node<astNode> *separator = getKeyword(context, Keyword::OPERATOR_SEPARATOR, compilationError::OPERATOR_SEPARATOR_EXPECTED);
-    customWarning(separator, NULL);
+            expectedOperator = getOperatorList(context, localNameTableID);
+            IS_NULL(expectedOperator, NULL);
+            IS_NULL(skipKeyword(context, Keyword::BLOCK_CLOSE, compilationError::OPERATOR_NOT_FOUND), NULL);
+            break;
 
-    if (!separator) {
-        size_t separatorIndex = getKeywordIndex(context, Keyword::OPERATOR_SEPARATOR);
-        separator = emplaceNode(node<astNode>
+        default:
             {
-                .data = {
-                    .type = nodeType::STRING,
-                    .data = {.nameTableIndex = separatorIndex},
-                    .line = context->currentLine
-                },
-                .left = expectedOperator,
-                .right = NULL,
-                .parent = NULL
-            });
-        if (expectedOperator) expectedOperator->parent = separator;
-        return separator;
+                nameType type = context->nameTable->data[currentNameTableIndex].type;
+
+                SYNTAX_ASSERT(type == nameType::IDENTIFIER || type == nameType::TYPE_NAME, compilationError::OPERATOR_NOT_FOUND);
+
+                expectedOperator = type == nameType::IDENTIFIER ? getAssignmentExpression(context, localNameTableID) :
+                                                                  getDeclaration         (context, localNameTableID);
+                break;
+            }
     }
 
+    IS_NULL(expectedOperator, NULL);
+
+    node<astNode> *separator = getKeyword(context, Keyword::OPERATOR_SEPARATOR, compilationError::OPERATOR_SEPARATOR_EXPECTED);
+    customWarning(separator, NULL);
+
     _OPERATOR_SEPARATOR_(separator, expectedOperator, NULL);
 
     return separator;
 }
 
+// operator lists only stand inside blocks, so the list goes on up to the closing keyword;
+// it is built in a loop, a function of any length takes the same native stack
 static node<astNode> *getOperatorList(compilationContext *context, int localNameTableID){
     customWarning(context, NULL);
 
     node<astNode> *firstOperator = getOperator(context, localNameTableID);
     IS_NULL(firstOperator, NULL);
 
-    node<astNode> *secondOperator = getOperatorList(context, localNameTableID);
-
-    firstOperator->right = secondOperator;
+    node<astNode> *lastOperator = firstOperator;
 
-    CHECK_FOR_ERROR(secondOperator, compilationError::OPERATOR_NOT_FOUND);
+    while (!isCurrentKeyword(context, Keyword::BLOCK_CLOSE)) {
+        node<astNode> *nextOperator = getOperator(context, localNameTableID);
+        IS_NULL(nextOperator, NULL);
 
-    if (secondOperator) {
-        secondOperator->parent = firstOperator;
+        lastOperator->right  = nextOperator;
+        nextOperator->parent = lastOperator;
+        lastOperator         = nextOperator;
     }
 
     return firstOperator;
 }
 
-static node<astNode> *getConditionOperator(compilationContext *context, Keyword operatorKeyword, compilationError error, int localNameTableID) {
+static node<astNode> *getConditionOperator(compilationContext *context, Keyword operatorKeyword, int localNameTableID) {
     customWarning(context, NULL);
 
-    node<astNode> *conditionOperator = getKeyword(context, operatorKeyword, error);
+    node<astNode> *conditionOperator = getKeyword(context, operatorKeyword, operatorKeyword == Keyword::IF ? compilationError::IF_EXPECTED :
+                                                                                                            compilationError::WHILE_EXPECTED);
     IS_NULL(conditionOperator, NULL);
 
     node<astNode> *conditionExpression = getExpression(context, localNameTableID);
     IS_NULL(conditionExpression, NULL);
 
-    IS_NULL(getTokenAndDestroy(context, Keyword::CONDITION_SEPARATOR, compilationError::CONDITION_SEPARATOR_EXPECTED), NULL);
+    IS_NULL(skipKeyword(context, Keyword::CONDITION_SEPARATOR, compilationError::CONDITION_SEPARATOR_EXPECTED), NULL);
 
     node<astNode> *operatorContent = getOperator(context, localNameTableID);
     IS_NULL(operatorContent, NULL);
 
     conditionOperator->left     = conditionExpression;
-    conditionExpression->parent = conditionOperator;
+    linkExpression(conditionExpression, conditionOperator);
 
     conditionOperator->right    = operatorContent;
     operatorContent->parent     = conditionOperator;
@@ -554,7 +772,7 @@ static node<astNode> *getReturnOperator(compilationContext *context, int localNa
     IS_NULL(expression, NULL);
 
     returnStatement->right = expression;
-    expression->parent     = returnStatement;
+    linkExpression(expression, returnStatement);
 
     return returnStatement;
 }
@@ -569,7 +787,7 @@ static node<astNode> *getOutOperator(compilationContext *context, int localNameT
     IS_NULL(expression, NULL);
 
     outOperator->right = expression;
-    expression->parent = outOperator;
+    linkExpression(expression, outOperator);
 
     return outOperator;
 }
@@ -579,18 +797,22 @@ static node<astNode> *getOutOperator(compilationContext *context, int localNameT
 node<astNode> *getFunctionCall(compilationContext *context, int localNameTableID) {
     customWarning(context, NULL);
 
-    IS_NULL(getTokenAndDestroy(context, Keyword::FUNCTION_CALL, compilationError::FUNCTION_CALL_EXPECTED), NULL);
+    IS_NULL(skipKeyword(context, Keyword::FUNCTION_CALL, compilationError::FUNCTION_CALL_EXPECTED), NULL);
 
     node<astNode> *identifier = getStringToken(context, nameType::IDENTIFIER, compilationError::IDENTIFIER_EXPECTED);
     IS_NULL(identifier, NULL);
     writeDataToBuffer(context->functionCalls, &identifier, 1);
 
-    IS_NULL(getTokenAndDestroy(context, Keyword::LEFT_BRACKET, compilationError::BRACKET_EXPECTED), NULL);
+    IS_NULL(skipKeyword(context, Keyword::LEFT_BRACKET, compilationError::BRACKET_EXPECTED), NULL);
 
-    node<astNode> *arguments = getArgumentList(context, localNameTableID);
-    CHECK_FOR_ERROR(arguments, compilationError::CONSTANT_EXPECTED);
+    node<astNode> *arguments = NULL;
+
+    if (!isCurrentKeyword(context, Keyword::RIGHT_BRACKET)) {
+        arguments = getArgumentList(context, localNameTableID);
+        IS_NULL(arguments, NULL);
+    }
 
-    IS_NULL(getTokenAndDestroy(context, Keyword::RIGHT_BRACKET, compilationError::BRACKET_EXPECTED), NULL);
+    IS_NULL(skipKeyword(context, Keyword::RIGHT_BRACKET, compilationError::BRACKET_EXPECTED), NULL);
 
     return _FUNCTION_CALL_(arguments, identifier);
 }
@@ -601,26 +823,26 @@ static node<astNode> *getArgumentList(compilationContext *context, int localName
     node<astNode> *argument = getExpression(context, localNameTableID);
     IS_NULL(argument, NULL);
 
-    node<astNode> *separator = getKeyword(context, Keyword::ARGUMENT_SEPARATOR, compilationError::ARGUMENT_SEPARATOR_EXPECTED);
-
-    if (!separator) {
-        context->errorBuffer->currentIndex--;
-        size_t separatorIndex = getKeywordIndex(context, Keyword::ARGUMENT_SEPARATOR);
-        separator = emplaceNode(node<astNode>
+    if (!isCurrentKeyword(context, Keyword::ARGUMENT_SEPARATOR)) {
+        size_t separatorIndex = getKeywordNameIndex(Keyword::ARGUMENT_SEPARATOR);
+        node<astNode> *separator = emplaceNode(context->AST, node<astNode>
             {
                 .data = {
                     .type = nodeType::STRING,
                     .data = {.nameTableIndex = separatorIndex},
-                    .line = context->currentLine
+                    .line = getNodeLine(context)
                 },
                 .left = argument,
                 .right = NULL,
                 .parent = NULL
             });
-        if (argument) argument->parent = separator;
+        linkExpression(argument, separator);
         return separator;
     }
 
+    node<astNode> *separator = getTokenNode(context, context->tokenIndex++);
+    IS_NULL(separator, NULL);
+
     node<astNode> *nextArgument = getArgumentList(context, localNameTableID);
     IS_NULL(nextArgument, NULL);
 
@@ -635,17 +857,14 @@ static node<astNode> *getParameterList(compilationContext *context, int localNam
     node<astNode> *parameter = getDeclaration(context, localNameTableID);
     IS_NULL(parameter, NULL);
 
-    node<astNode> *separator = getKeyword(context, Keyword::ARGUMENT_SEPARATOR, compilationError::ARGUMENT_SEPARATOR_EXPECTED);
-
-    if (!separator) {
-        context->errorBuffer->currentIndex--;
-        size_t separatorIndex = getKeywordIndex(context, Keyword::ARGUMENT_SEPARATOR);
-        separator = emplaceNode(node<astNode>
+    if (!isCurrentKeyword(context, Keyword::ARGUMENT_SEPARATOR)) {
+        size_t separatorIndex = getKeywordNameIndex(Keyword::ARGUMENT_SEPARATOR);
+        node<astNode> *separator = emplaceNode(context->AST, node<astNode>
             {
                 .data = {
                     .type = nodeType::STRING,
                     .data = {.nameTableIndex = separatorIndex},
-                    .line = context->currentLine
+                    .line = getNodeLine(context)
                 },
                 .left = parameter,
                 .right = NULL,
@@ -655,6 +874,9 @@ static node<astNode> *getParameterList(compilationContext *context, int localNam
         return separator;
     }
 
+    node<astNode> *separator = getTokenNode(context, context->tokenIndex++);
+    IS_NULL(separator, NULL);
+
     node<astNode> *nextParameter = getParameterList(context, localNameTableID);
     IS_NULL(nextParameter, NULL);
 
@@ -668,74 +890,87 @@ static node<astNode> *getParameterList(compilationContext *context, int localNam
 node<astNode> *getStringToken(compilationContext *context, nameType type, compilationError error) {
     customWarning(context, NULL);
 
-    SYNTAX_ASSERT(currentToken->data.type == nodeType::STRING && context->nameTable->data[currentNameTableIndex].type == type, error);
+    SYNTAX_ASSERT(currentTokenKind == tokenKind::NAME && context->nameTable->data[currentNameTableIndex].type == type, error);
 
-    node<astNode> *returnValue = currentToken;
-    context->tokenIndex++;
-
-    return returnValue;
+    return getTokenNode(context, context->tokenIndex++);
 }
 
 node<astNode> *getKeyword(compilationContext *context, Keyword keyword, compilationError error) {
     customWarning(context, NULL);
 
-    SYNTAX_ASSERT(currentToken->data.type == nodeType::STRING && context->nameTable->data[currentNameTableIndex].keyword == keyword, error);
-
-    node<astNode> *returnValue = currentToken;
-    context->tokenIndex++;
+    SYNTAX_ASSERT(currentTokenKind == tokenKind::NAME && currentTokenKeyword == keyword, error);
 
-    return returnValue;
+    return getTokenNode(context, context->tokenIndex++);
 }
 
 node<astNode> *getConstant(compilationContext *context) {
     customWarning(context, NULL);
 
-    SYNTAX_ASSERT(currentToken->data.type == nodeType::CONSTANT, compilationError::CONSTANT_EXPECTED);
+    SYNTAX_ASSERT(currentTokenKind == tokenKind::CONSTANT, compilationError::CONSTANT_EXPECTED);
 
-    node<astNode> *returnValue = currentToken;
-    context->tokenIndex++;
-
-    return returnValue;
+    return getTokenNode(context, context->tokenIndex++);
 }
 
-bool getTokenAndDestroy(compilationContext *context, Keyword keyword, compilationError error) {
-    customWarning(context, false);
+// tokens live in the flat stream, a node is made only once the parser keeps the token in the tree
+node<astNode> *getTokenNode(compilationContext *context, size_t tokenIndex) {
+    customWarning(context, NULL);
 
-    if (!getKeyword(context, keyword, error)) {
-        return false;
+    node<astNode> *tokenNode = NULL;
+
+    if (context->tokens->kinds.data[tokenIndex] == tokenKind::CONSTANT) {
+        tokenNode = _CONST_(context->tokens->values.data[tokenIndex].number);
     }
 
-    context->tokenIndex--;
-    DESTROY_CURRENT_NODE();
+    else {
+        tokenNode = _NAME_(context->tokens->values.data[tokenIndex].nameTableIndex);
+    }
+
+    IS_NULL(tokenNode, NULL);
+
+    tokenNode->data.line = context->tokens->lines.data[tokenIndex] - context->lineBase;
+
+    return tokenNode;
+}
+
+bool getNameIndex(compilationContext *context, nameType type, compilationError error, size_t *nameIndex) {
+    customWarning(context,   false);
+    customWarning(nameIndex, false);
+
+    SYNTAX_ASSERT_RETURN(currentTokenKind == tokenKind::NAME && context->nameTable->data[currentNameTableIndex].type == type, error, false);
+
+    *nameIndex = currentNameTableIndex;
     context->tokenIndex++;
 
     return true;
 }
 
-bool isIdentifierDeclared(compilationContext *context, int localNameTableID, size_t identifierIndex, localNameType identifierType) {
+bool isCurrentKeyword(compilationContext *context, Keyword keyword) {
     customWarning(context, false);
 
-    if (isLocalIdentifierDeclared(context, localNameTableID, identifierIndex, identifierType)) {
-        return true;
-    }
+    return currentTokenKind == tokenKind::NAME && currentTokenKeyword == keyword;
+}
+
+bool skipKeyword(compilationContext *context, Keyword keyword, compilationError error) {
+    customWarning(context, false);
 
-    int nameIndex = getIndexInLocalTable(0, context->localTables, identifierIndex, identifierType);
+    SYNTAX_ASSERT_RETURN(currentTokenKind == tokenKind::NAME && currentTokenKeyword == keyword, error, false);
 
-    if (nameIndex >= 0) {
-        return true;
-    }
+    context->tokenIndex++;
+
+    return true;
+}
+
+// localNameTableID is the table of the innermost scope, the chain behind it ends with the global one
+bool isIdentifierDeclared(compilationContext *context, int localNameTableID, size_t identifierIndex, localNameType identifierType) {
+    customWarning(context, false);
+    customWarning(context->scopes->data[context->scopes->currentIndex - 1].localTableIndex == localNameTableID, false);
 
-    return false;
+    return isDeclaredInChain(context->scopes, context->localTables, identifierIndex, identifierType);
 }
 
 bool isLocalIdentifierDeclared(compilationContext *context, int localNameTableID, size_t identifierIndex, localNameType identifierType) {
     customWarning(context != NULL, false);
+    customWarning(context->scopes->data[context->scopes->currentIndex - 1].localTableIndex == localNameTableID, false);
 
-    int localNameIndex = getIndexInLocalTable(localNameTableID, context->localTables, identifierIndex, identifierType);
-
-    if (localNameIndex >= 0) {
-        return true;
-    }
-
-    return false;
+    return findInScope(context->scopes, context->scopes->currentIndex - 1, context->localTables, identifierIndex, identifierType) >= 0;
 }
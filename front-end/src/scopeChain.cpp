@@ -0,0 +1,145 @@
+#include <cstdint>
+
+#include "customWarning.h"
+#include "scopeChain.h"
+#include "nameTable.h"
+#include "buffer.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static uint32_t  hashGlobalNameID(size_t globalNameID);
+static hashSlot *findScopeSlot   (nameScope *scope, Buffer<localNameTable> *localTables, size_t globalNameID, localNameType nameType);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError initializeScopeChain(Buffer<nameScope> *scopes, int globalTableIndex) {
+    customWarning(scopes, bufferError::POINTER_IS_NULL);
+
+    if (bufferInitialize(scopes) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
+    return pushScope(scopes, globalTableIndex);
+}
+
+bufferError destroyScopeChain(Buffer<nameScope> *scopes) {
+    customWarning(scopes, bufferError::POINTER_IS_NULL);
+
+    while (scopes->currentIndex > 0) {
+        popScope(scopes);
+    }
+
+    return bufferDestruct(scopes);
+}
+
+bufferError pushScope(Buffer<nameScope> *scopes, int localTableIndex) {
+    customWarning(scopes, bufferError::POINTER_IS_NULL);
+
+    nameScope newScope = {.localTableIndex = localTableIndex, .elements = {}};
+
+    if (initializeHashTable(&newScope.elements, HASH_TABLE_INITIAL_CAPACITY) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
+    if (writeDataToBuffer(scopes, &newScope, 1) != bufferError::NO_BUFFER_ERROR) {
+        destroyHashTable(&newScope.elements);
+
+        return bufferError::CALLOC_ERROR;
+    }
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+bufferError popScope(Buffer<nameScope> *scopes) {
+    customWarning(scopes,                   bufferError::POINTER_IS_NULL);
+    customWarning(scopes->currentIndex > 0, bufferError::NO_BUFFER);
+
+    scopes->currentIndex--;
+
+    return destroyHashTable(&scopes->data[scopes->currentIndex].elements);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError declareInScope(Buffer<nameScope> *scopes, Buffer<localNameTable> *localTables, localNameTableElement newElement) {
+    customWarning(scopes,                   bufferError::POINTER_IS_NULL);
+    customWarning(localTables,              bufferError::POINTER_IS_NULL);
+    customWarning(scopes->currentIndex > 0, bufferError::NO_BUFFER);
+
+    nameScope *scope = &scopes->data[scopes->currentIndex - 1];
+
+    if (addLocalIdentifier(scope->localTableIndex, localTables, newElement, 1) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::BUFFER_ENDED;
+    }
+
+    return insertHashValue(&scope->elements, hashGlobalNameID(newElement.globalNameID),
+                           localTables->data[scope->localTableIndex].elements.currentIndex);
+}
+
+int findInScope(Buffer<nameScope> *scopes, size_t scopeIndex, Buffer<localNameTable> *localTables,
+                size_t globalNameID, localNameType nameType) {
+    customWarning(scopes,                            -1);
+    customWarning(localTables,                       -1);
+    customWarning(scopeIndex < scopes->currentIndex, -1);
+
+    hashSlot *slot = findScopeSlot(&scopes->data[scopeIndex], localTables, globalNameID, nameType);
+
+    return slot ? (int) slot->value - 1 : -1;
+}
+
+bool isDeclaredInChain(Buffer<nameScope> *scopes, Buffer<localNameTable> *localTables, size_t globalNameID, localNameType nameType) {
+    customWarning(scopes,      false);
+    customWarning(localTables, false);
+
+    for (size_t scopeIndex = scopes->currentIndex; scopeIndex > 0; scopeIndex--) {
+        if (findScopeSlot(&scopes->data[scopeIndex - 1], localTables, globalNameID, nameType)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// the old slot stays as a removed one, so names probed past it are still found
+bufferError renameInScope(Buffer<nameScope> *scopes, size_t scopeIndex, Buffer<localNameTable> *localTables,
+                          size_t element, size_t globalNameID) {
+    customWarning(scopes,                            bufferError::POINTER_IS_NULL);
+    customWarning(localTables,                       bufferError::POINTER_IS_NULL);
+    customWarning(scopeIndex < scopes->currentIndex, bufferError::NO_BUFFER);
+
+    nameScope             *scope        = &scopes->data[scopeIndex];
+    localNameTableElement *tableElement = &localTables->data[scope->localTableIndex].elements.data[element];
+    hashSlot              *slot         = findScopeSlot(scope, localTables, tableElement->globalNameID, tableElement->type);
+
+    customWarning(slot && slot->value == element + 1, bufferError::NO_BUFFER);
+
+    slot->value                = HASH_REMOVED_VALUE;
+    tableElement->globalNameID = globalNameID;
+
+    return insertHashValue(&scope->elements, hashGlobalNameID(globalNameID), element + 1);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static uint32_t hashGlobalNameID(size_t globalNameID) {
+    return hashValue(FNV_OFFSET_BASIS, globalNameID);
+}
+
+static hashSlot *findScopeSlot(nameScope *scope, Buffer<localNameTable> *localTables, size_t globalNameID, localNameType nameType) {
+    Buffer<localNameTableElement> *elements = &localTables->data[scope->localTableIndex].elements;
+    hashTable                     *slots    = &scope->elements;
+    uint32_t                       hash     = hashGlobalNameID(globalNameID);
+
+    for (size_t slotIndex = getFirstHashSlot(slots, hash); slots->slots[slotIndex].value; slotIndex = getNextHashSlot(slots, slotIndex)) {
+        hashSlot *slot = &slots->slots[slotIndex];
+
+        if (slot->value != HASH_REMOVED_VALUE && slot->hash == hash && elements->data[slot->value - 1].globalNameID == globalNameID &&
+            ((int) elements->data[slot->value - 1].type & (int) nameType)) {
+            return slot;
+        }
+    }
+
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -0,0 +1,215 @@
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "customWarning.h"
+#include "sourceInput.h"
+#include "binaryTreeDef.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+sourceInputError openSourceInput(sourceInput *input, const char *fileName) {
+    customWarning(input, sourceInputError::BAD_POINTER);
+
+    *input = {};
+
+    input->fileName = fileName ? fileName : "-";
+
+    if (!fileName || !strcmp(fileName, "-")) {
+        input->kind       = sourceInputKind::STREAMED;
+        input->descriptor = STDIN_FILENO;
+
+        return sourceInputError::NO_ERRORS;
+    }
+
+    input->descriptor = open(fileName, O_RDONLY);
+    customWarning(input->descriptor >= 0, sourceInputError::FILE_OPEN_ERROR);
+
+    struct stat fileStat = {};
+
+    if (fstat(input->descriptor, &fileStat) != 0) {
+        close(input->descriptor);
+        input->descriptor = -1;
+
+        return sourceInputError::FILE_OPEN_ERROR;
+    }
+
+    // fifos and character devices have no size to map, they are streamed like stdin
+    if (!S_ISREG(fileStat.st_mode)) {
+        input->kind = sourceInputKind::STREAMED;
+
+        return sourceInputError::NO_ERRORS;
+    }
+
+    input->kind       = sourceInputKind::MAPPED;
+    input->size       = (size_t)fileStat.st_size;
+    input->isComplete = true;
+
+    if (input->size > 0) {
+        void *mapping = mmap(NULL, input->size, PROT_READ, MAP_PRIVATE, input->descriptor, 0);
+
+        if (mapping == MAP_FAILED) {
+            close(input->descriptor);
+            input->descriptor = -1;
+
+            return sourceInputError::FILE_READ_ERROR;
+        }
+
+        madvise(mapping, input->size, MADV_SEQUENTIAL);
+
+        input->data = (char *)mapping;
+    }
+
+    // the mapping stays valid without the descriptor
+    close(input->descriptor);
+    input->descriptor = -1;
+
+    return sourceInputError::NO_ERRORS;
+}
+
+sourceInputError readSourceChunk(sourceInput *input) {
+    customWarning(input, sourceInputError::BAD_POINTER);
+
+    if (input->isComplete || input->kind != sourceInputKind::STREAMED) {
+        return sourceInputError::NO_ERRORS;
+    }
+
+    if (input->capacity - input->size < SOURCE_CHUNK_SIZE) {
+        size_t newCapacity = input->capacity ? input->capacity * 2 : SOURCE_CHUNK_SIZE;
+
+        while (newCapacity - input->size < SOURCE_CHUNK_SIZE) {
+            newCapacity *= 2;
+        }
+
+        char *newData = (char *)realloc(input->data, newCapacity);
+        customWarning(newData, sourceInputError::ALLOCATION_ERROR);
+
+        input->data     = newData;
+        input->capacity = newCapacity;
+    }
+
+    ssize_t readBytes = 0;
+
+    do {
+        readBytes = read(input->descriptor, input->data + input->size, SOURCE_CHUNK_SIZE);
+    } while (readBytes < 0 && errno == EINTR);
+
+    customWarning(readBytes >= 0, sourceInputError::FILE_READ_ERROR);
+
+    if (readBytes == 0) {
+        input->isComplete = true;
+    }
+
+    input->size += (size_t)readBytes;
+
+    return sourceInputError::NO_ERRORS;
+}
+
+sourceInputError editSourceInput(sourceInput *input, size_t offset, size_t removedLength, const char *text, size_t textLength) {
+    customWarning(input,                                  sourceInputError::BAD_POINTER);
+    customWarning(text || textLength == 0,                sourceInputError::BAD_POINTER);
+    customWarning(input->isComplete,                      sourceInputError::FILE_READ_ERROR);
+    customWarning(offset + removedLength <= input->size,  sourceInputError::BAD_POINTER);
+
+    size_t newSize = input->size - removedLength + textLength;
+
+    if (input->kind != sourceInputKind::EDITED || newSize > input->size + input->gapLength) {
+        size_t newCapacity = input->capacity ? input->capacity : SOURCE_CHUNK_SIZE;
+
+        while (newCapacity < newSize) {
+            newCapacity *= 2;
+        }
+
+        char *newData = (char *)calloc(newCapacity, sizeof(char));
+        customWarning(newData, sourceInputError::ALLOCATION_ERROR);
+
+        moveSourceGap(input, input->size);
+
+        if (input->data) {
+            memcpy(newData, input->data, input->size);
+        }
+
+        if (input->kind == sourceInputKind::MAPPED) {
+            if (input->data) {
+                munmap(input->data, input->size);
+            }
+        }
+
+        else {
+            FREE_(input->data);
+        }
+
+        input->kind      = sourceInputKind::EDITED;
+        input->data      = newData;
+        input->capacity  = newCapacity;
+        input->gapBegin  = input->size;
+        input->gapLength = newCapacity - input->size;
+    }
+
+    // the removed bytes join the gap and the text is written at its beginning
+    moveSourceGap(input, offset + removedLength);
+
+    input->gapBegin  -= removedLength;
+    input->gapLength += removedLength;
+
+    if (textLength > 0) {
+        memcpy(input->data + input->gapBegin, text, textLength);
+    }
+
+    input->gapBegin  += textLength;
+    input->gapLength -= textLength;
+    input->size       = newSize;
+
+    return sourceInputError::NO_ERRORS;
+}
+
+sourceInputError moveSourceGap(sourceInput *input, size_t offset) {
+    customWarning(input,                sourceInputError::BAD_POINTER);
+    customWarning(offset <= input->size, sourceInputError::BAD_POINTER);
+
+    if (input->gapLength == 0) {
+        input->gapBegin = offset;
+
+        return sourceInputError::NO_ERRORS;
+    }
+
+    if (offset < input->gapBegin) {
+        memmove(input->data + offset + input->gapLength, input->data + offset, input->gapBegin - offset);
+    }
+
+    else {
+        memmove(input->data + input->gapBegin, input->data + input->gapBegin + input->gapLength, offset - input->gapBegin);
+    }
+
+    input->gapBegin = offset;
+
+    return sourceInputError::NO_ERRORS;
+}
+
+sourceInputError closeSourceInput(sourceInput *input) {
+    customWarning(input, sourceInputError::BAD_POINTER);
+
+    if (input->kind == sourceInputKind::MAPPED) {
+        if (input->data) {
+            munmap(input->data, input->size);
+        }
+    }
+
+    else {
+        FREE_(input->data);
+    }
+
+    if (input->descriptor > STDIN_FILENO) {
+        close(input->descriptor);
+    }
+
+    *input = {};
+
+    return sourceInputError::NO_ERRORS;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
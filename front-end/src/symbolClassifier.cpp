@@ -0,0 +1,267 @@
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define SYMBOL_CLASSIFIER_X86
+#endif
+
+#include "symbolClassifier.h"
+#include "utf8.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+typedef size_t (*spaceRunFunction)     (const char *text, size_t begin, size_t end, int *lineCount);
+typedef size_t (*identifierRunFunction)(const char *text, size_t begin, size_t end);
+
+struct symbolClassifier {
+    spaceRunFunction      spaceRun      = NULL;
+    identifierRunFunction identifierRun = NULL;
+};
+
+static const symbolClassifier *getSymbolClassifier();
+
+static bool   isSpaceByte          (unsigned char symbol);
+static bool   isIdentifierByte     (unsigned char symbol);
+
+static size_t scalarSpaceRun       (const char *text, size_t begin, size_t end, int *lineCount);
+static size_t scalarIdentifierRun  (const char *text, size_t begin, size_t end);
+
+#ifdef SYMBOL_CLASSIFIER_X86
+static size_t sse2SpaceRun         (const char *text, size_t begin, size_t end, int *lineCount);
+static size_t sse2IdentifierRun    (const char *text, size_t begin, size_t end);
+static size_t avx2SpaceRun         (const char *text, size_t begin, size_t end, int *lineCount);
+static size_t avx2IdentifierRun    (const char *text, size_t begin, size_t end);
+#endif
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+size_t getSpaceRunLength(const char *text, size_t begin, size_t end, int *lineCount) {
+    if (!text || !lineCount || begin >= end) {
+        return 0;
+    }
+
+    return getSymbolClassifier()->spaceRun(text, begin, end, lineCount) - begin;
+}
+
+size_t getIdentifierRunLength(const char *text, size_t begin, size_t end) {
+    if (!text || begin >= end) {
+        return 0;
+    }
+
+    return getSymbolClassifier()->identifierRun(text, begin, end) - begin;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static const symbolClassifier *getSymbolClassifier() {
+    static const symbolClassifier scalarClassifier = {.spaceRun = scalarSpaceRun, .identifierRun = scalarIdentifierRun};
+
+    #ifdef SYMBOL_CLASSIFIER_X86
+        static const symbolClassifier sse2Classifier = {.spaceRun = sse2SpaceRun, .identifierRun = sse2IdentifierRun};
+        static const symbolClassifier avx2Classifier = {.spaceRun = avx2SpaceRun, .identifierRun = avx2IdentifierRun};
+
+        // function-local static, so cpuid runs once and the choice is thread-safe
+        static const symbolClassifier *classifier = __builtin_cpu_supports("avx2") ? &avx2Classifier :
+                                                    __builtin_cpu_supports("sse2") ? &sse2Classifier : &scalarClassifier;
+
+        return classifier;
+    #else
+        return &scalarClassifier;
+    #endif
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static bool isSpaceByte(unsigned char symbol) {
+    return symbol == ' ' || (symbol >= '\t' && symbol <= '\r');
+}
+
+static bool isIdentifierByte(unsigned char symbol) {
+    return (symbol >= 'a' && symbol <= 'z') || (symbol >= 'A' && symbol <= 'Z') ||
+           (symbol >= '0' && symbol <= '9') ||  symbol == '_';
+}
+
+static size_t scalarSpaceRun(const char *text, size_t begin, size_t end, int *lineCount) {
+    while (begin < end && isSpaceByte((unsigned char)text[begin])) {
+        if (text[begin] == '\n') {
+            (*lineCount)++;
+        }
+
+        begin++;
+    }
+
+    return begin;
+}
+
+static size_t scalarIdentifierRun(const char *text, size_t begin, size_t end) {
+    while (begin < end) {
+        uint32_t codePoint    = 0;
+        size_t   symbolLength = 0;
+
+        if (isIdentifierByte((unsigned char)text[begin])) {
+            begin++;
+        }
+
+        else if ((symbolLength = decodeUtf8Symbol(text + begin, end - begin, &codePoint)) && isCyrillicCodePoint(codePoint)) {
+            begin += symbolLength;
+        }
+
+        else {
+            break;
+        }
+    }
+
+    return begin;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+#ifdef SYMBOL_CLASSIFIER_X86
+
+// compares are signed: ASCII bytes are positive, every byte of a two-byte Cyrillic letter is negative
+
+static inline __m128i sse2InRange(__m128i block, char low, char high) {
+    return _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8((char)(low - 1))), _mm_cmpgt_epi8(_mm_set1_epi8((char)(high + 1)), block));
+}
+
+static inline __m128i sse2SpaceBytes(__m128i block) {
+    return _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), sse2InRange(block, '\t', '\r'));
+}
+
+static inline __m128i sse2IdentifierBytes(__m128i block) {
+    __m128i letters = sse2InRange(_mm_or_si128(block, _mm_set1_epi8(0x20)), 'a', 'z');
+    __m128i digits  = sse2InRange(block, '0', '9');
+
+    return _mm_or_si128(_mm_or_si128(letters, digits), _mm_cmpeq_epi8(block, _mm_set1_epi8('_')));
+}
+
+// byte i is set when bytes i and i + 1 form one Cyrillic letter, matches isCyrillicCodePoint
+static inline __m128i sse2CyrillicPairs(__m128i current, __m128i next) {
+    __m128i afterD0 = _mm_or_si128(sse2InRange(next, (char)0x90, (char)0xbf), _mm_cmpeq_epi8(next, _mm_set1_epi8((char)0x81)));
+    __m128i afterD1 = _mm_or_si128(_mm_cmpgt_epi8(_mm_set1_epi8((char)0x90), next), _mm_cmpeq_epi8(next, _mm_set1_epi8((char)0x91)));
+
+    return _mm_or_si128(_mm_and_si128(_mm_cmpeq_epi8(current, _mm_set1_epi8((char)0xd0)), afterD0),
+                        _mm_and_si128(_mm_cmpeq_epi8(current, _mm_set1_epi8((char)0xd1)), afterD1));
+}
+
+static size_t sse2SpaceRun(const char *text, size_t begin, size_t end, int *lineCount) {
+    while (begin + sizeof(__m128i) <= end) {
+        __m128i  block    = _mm_loadu_si128((const __m128i *)(text + begin));
+        uint32_t spaces   = (uint32_t)_mm_movemask_epi8(sse2SpaceBytes(block));
+        uint32_t newLines = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')));
+
+        uint32_t stop = ~spaces & 0xffff;
+
+        if (stop) {
+            uint32_t runLength = (uint32_t)__builtin_ctz(stop);
+
+            *lineCount += __builtin_popcount(newLines & ((1u << runLength) - 1));
+
+            return begin + runLength;
+        }
+
+        *lineCount += __builtin_popcount(newLines);
+        begin      += sizeof(__m128i);
+    }
+
+    return scalarSpaceRun(text, begin, end, lineCount);
+}
+
+static size_t sse2IdentifierRun(const char *text, size_t begin, size_t end) {
+    // one byte of lookahead, so a letter split between two blocks is still seen as a pair
+    while (begin + sizeof(__m128i) + 1 <= end) {
+        __m128i current = _mm_loadu_si128((const __m128i *)(text + begin));
+        __m128i next    = _mm_loadu_si128((const __m128i *)(text + begin + 1));
+
+        uint32_t letters = (uint32_t)_mm_movemask_epi8(sse2IdentifierBytes(current));
+        uint32_t pairs   = (uint32_t)_mm_movemask_epi8(sse2CyrillicPairs(current, next));
+
+        uint32_t stop = ~(letters | pairs | (pairs << 1)) & 0xffff;
+
+        if (stop) {
+            return begin + (size_t)__builtin_ctz(stop);
+        }
+
+        begin += sizeof(__m128i) + ((pairs >> 15) & 1);
+    }
+
+    return scalarIdentifierRun(text, begin, end);
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+__attribute__((target("avx2")))
+static inline __m256i avx2InRange(__m256i block, char low, char high) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8((char)(low - 1))), _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(high + 1)), block));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx2SpaceBytes(__m256i block) {
+    return _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')), avx2InRange(block, '\t', '\r'));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx2IdentifierBytes(__m256i block) {
+    __m256i letters = avx2InRange(_mm256_or_si256(block, _mm256_set1_epi8(0x20)), 'a', 'z');
+    __m256i digits  = avx2InRange(block, '0', '9');
+
+    return _mm256_or_si256(_mm256_or_si256(letters, digits), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('_')));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx2CyrillicPairs(__m256i current, __m256i next) {
+    __m256i afterD0 = _mm256_or_si256(avx2InRange(next, (char)0x90, (char)0xbf), _mm256_cmpeq_epi8(next, _mm256_set1_epi8((char)0x81)));
+    __m256i afterD1 = _mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8((char)0x90), next), _mm256_cmpeq_epi8(next, _mm256_set1_epi8((char)0x91)));
+
+    return _mm256_or_si256(_mm256_and_si256(_mm256_cmpeq_epi8(current, _mm256_set1_epi8((char)0xd0)), afterD0),
+                           _mm256_and_si256(_mm256_cmpeq_epi8(current, _mm256_set1_epi8((char)0xd1)), afterD1));
+}
+
+__attribute__((target("avx2")))
+static size_t avx2SpaceRun(const char *text, size_t begin, size_t end, int *lineCount) {
+    while (begin + sizeof(__m256i) <= end) {
+        __m256i  block    = _mm256_loadu_si256((const __m256i *)(text + begin));
+        uint32_t spaces   = (uint32_t)_mm256_movemask_epi8(avx2SpaceBytes(block));
+        uint32_t newLines = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n')));
+
+        uint32_t stop = ~spaces;
+
+        if (stop) {
+            uint32_t runLength = (uint32_t)__builtin_ctz(stop);
+
+            *lineCount += __builtin_popcount(newLines & (uint32_t)((1ull << runLength) - 1));
+
+            return begin + runLength;
+        }
+
+        *lineCount += __builtin_popcount(newLines);
+        begin      += sizeof(__m256i);
+    }
+
+    return sse2SpaceRun(text, begin, end, lineCount);
+}
+
+__attribute__((target("avx2")))
+static size_t avx2IdentifierRun(const char *text, size_t begin, size_t end) {
+    while (begin + sizeof(__m256i) + 1 <= end) {
+        __m256i current = _mm256_loadu_si256((const __m256i *)(text + begin));
+        __m256i next    = _mm256_loadu_si256((const __m256i *)(text + begin + 1));
+
+        uint64_t letters = (uint32_t)_mm256_movemask_epi8(avx2IdentifierBytes(current));
+        uint64_t pairs   = (uint32_t)_mm256_movemask_epi8(avx2CyrillicPairs(current, next));
+
+        uint64_t stop = ~(letters | pairs | (pairs << 1)) & 0xffffffffull;
+
+        if (stop) {
+            return begin + (size_t)__builtin_ctzll(stop);
+        }
+
+        begin += sizeof(__m256i) + ((pairs >> 31) & 1);
+    }
+
+    return sse2IdentifierRun(text, begin, end);
+}
+
+#endif // SYMBOL_CLASSIFIER_X86
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
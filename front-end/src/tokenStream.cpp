@@ -0,0 +1,107 @@
+#include <cstring>
+
+#include "customWarning.h"
+#include "tokenStream.h"
+#include "buffer.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+template <typename T>
+static bufferError spliceBuffer(Buffer<T> *buffer, size_t position, size_t removedCount, const T *inserted, size_t insertedCount);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError initializeTokenStream(tokenStream *stream) {
+    customWarning(stream, bufferError::POINTER_IS_NULL);
+
+    if (bufferInitialize(&stream->kinds)    != bufferError::NO_BUFFER_ERROR ||
+        bufferInitialize(&stream->keywords) != bufferError::NO_BUFFER_ERROR ||
+        bufferInitialize(&stream->values)   != bufferError::NO_BUFFER_ERROR ||
+        bufferInitialize(&stream->lines)    != bufferError::NO_BUFFER_ERROR ||
+        bufferInitialize(&stream->offsets)  != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
+    stream->count = 0;
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+bufferError destroyTokenStream(tokenStream *stream) {
+    customWarning(stream, bufferError::POINTER_IS_NULL);
+
+    bufferDestruct(&stream->kinds);
+    bufferDestruct(&stream->keywords);
+    bufferDestruct(&stream->values);
+    bufferDestruct(&stream->lines);
+    bufferDestruct(&stream->offsets);
+
+    stream->count = 0;
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError addToken(tokenStream *stream, tokenKind kind, Keyword keyword, nodeData value, int line, size_t offset) {
+    customWarning(stream, bufferError::POINTER_IS_NULL);
+
+    if (writeDataToBuffer(&stream->kinds,    &kind,    1) != bufferError::NO_BUFFER_ERROR ||
+        writeDataToBuffer(&stream->keywords, &keyword, 1) != bufferError::NO_BUFFER_ERROR ||
+        writeDataToBuffer(&stream->values,   &value,   1) != bufferError::NO_BUFFER_ERROR ||
+        writeDataToBuffer(&stream->lines,    &line,    1) != bufferError::NO_BUFFER_ERROR ||
+        writeDataToBuffer(&stream->offsets,  &offset,  1) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::BUFFER_ENDED;
+    }
+
+    stream->count++;
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+bufferError spliceTokens(tokenStream *stream, size_t position, size_t removedCount, const tokenStream *inserted, size_t insertedCount) {
+    customWarning(stream,                                   bufferError::POINTER_IS_NULL);
+    customWarning(inserted,                                 bufferError::POINTER_IS_NULL);
+    customWarning(position + removedCount <= stream->count, bufferError::BUFFER_ENDED);
+    customWarning(insertedCount <= inserted->count,         bufferError::BUFFER_ENDED);
+
+    if (spliceBuffer(&stream->kinds,    position, removedCount, inserted->kinds.data,    insertedCount) != bufferError::NO_BUFFER_ERROR ||
+        spliceBuffer(&stream->keywords, position, removedCount, inserted->keywords.data, insertedCount) != bufferError::NO_BUFFER_ERROR ||
+        spliceBuffer(&stream->values,   position, removedCount, inserted->values.data,   insertedCount) != bufferError::NO_BUFFER_ERROR ||
+        spliceBuffer(&stream->lines,    position, removedCount, inserted->lines.data,    insertedCount) != bufferError::NO_BUFFER_ERROR ||
+        spliceBuffer(&stream->offsets,  position, removedCount, inserted->offsets.data,  insertedCount) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::BUFFER_ENDED;
+    }
+
+    stream->count = stream->count - removedCount + insertedCount;
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+template <typename T>
+static bufferError spliceBuffer(Buffer<T> *buffer, size_t position, size_t removedCount, const T *inserted, size_t insertedCount) {
+    size_t tailBegin = position + removedCount;
+    size_t tailCount = buffer->currentIndex - tailBegin;
+
+    // grow through the buffer itself, the appended values are overwritten right away
+    if (insertedCount > removedCount &&
+        writeDataToBuffer(buffer, (T *)inserted, insertedCount - removedCount) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::BUFFER_ENDED;
+    }
+
+    memmove(buffer->data + position + insertedCount, buffer->data + tailBegin, tailCount * sizeof(T));
+
+    if (insertedCount > 0) {
+        memcpy(buffer->data + position, inserted, insertedCount * sizeof(T));
+    }
+
+    buffer->currentIndex = position + insertedCount + tailCount;
+
+    return bufferError::NO_BUFFER_ERROR;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
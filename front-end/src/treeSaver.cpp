@@ -1,8 +1,15 @@
 #include "treeSaver.h"
+#include <errno.h>
+#include <fcntl.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 #include "binaryTreeDef.h"
 #include "buffer.h"
 #include "nameTable.h"
+#include "astVisitor.h"
+#include "astHandoff.h"
+#include "binaryAST.h"
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
@@ -22,27 +29,31 @@ char *getFileName() {
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
+static saveDataError openSaveStream   (saveStream *stream, const char *fileName);
+static saveDataError closeSaveStream  (saveStream *stream);
+static void          flushSaveStream  (saveStream *stream);
+static bool          writeWhole       (int descriptor, const char *data, size_t size);
+
+static void          writeStreamData  (saveStream *stream, const char *data, size_t size);
+static void          writeStreamString(saveStream *stream, const char *string);
+static void          writeStreamNumber(saveStream *stream, uint64_t magnitude, bool isNegative);
+static void          writeStreamSigned(saveStream *stream, long long number);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
 saveDataError initializeSaveDataContext(saveDataContext *saveContext, char *NTFileName, char *ASTFileName) {
     customWarning(saveContext,   saveDataError::SAVE_CONTEXT_BAD_POINTER);
     customWarning(NTFileName,    saveDataError::BAD_FILENAME);
     customWarning(ASTFileName,   saveDataError::BAD_FILENAME);
 
-    saveContext->NTBuffer = (Buffer<char> *)calloc(1, sizeof(Buffer<char>));
-    customWarning(saveContext->NTBuffer, saveDataError::ALLOCATION_ERROR);
-
-    if (bufferInitialize(saveContext->NTBuffer) != bufferError::NO_BUFFER_ERROR) {
-        return saveDataError::INITIALIZATION_ERROR;
-    }
+    saveContext->NTStream.data = (char *)calloc(SAVE_STREAM_SIZE, sizeof(char));
+    customWarning(saveContext->NTStream.data, saveDataError::ALLOCATION_ERROR);
 
     saveContext->NTFileName = NTFileName;
     strcat(saveContext->NTFileName, ".nameTable");
 
-    saveContext->ASTBuffer = (Buffer<char> *)calloc(1, sizeof(Buffer<char>));
-    customWarning(saveContext->ASTBuffer, saveDataError::ALLOCATION_ERROR);
-
-    if (bufferInitialize(saveContext->ASTBuffer) != bufferError::NO_BUFFER_ERROR) {
-        return saveDataError::INITIALIZATION_ERROR;
-    }
+    saveContext->ASTStream.data = (char *)calloc(SAVE_STREAM_SIZE, sizeof(char));
+    customWarning(saveContext->ASTStream.data, saveDataError::ALLOCATION_ERROR);
 
     saveContext->ASTFileName = ASTFileName;
     strcat(saveContext->ASTFileName, ".AST");
@@ -51,76 +62,174 @@ saveDataError initializeSaveDataContext(saveDataContext *saveContext, char *NTFi
 }
 
 saveDataError destroySaveDataContext(saveDataContext *saveContext) {
-    customWarning(saveContext,              saveDataError::SAVE_CONTEXT_BAD_POINTER);
-    customWarning(saveContext->NTBuffer,    saveDataError::BUFFER_BAD_POINTER);
-    customWarning(saveContext->ASTBuffer,   saveDataError::BUFFER_BAD_POINTER);
-    customWarning(saveContext->NTFileName,  saveDataError::BAD_FILENAME);
-    customWarning(saveContext->ASTFileName, saveDataError::BAD_FILENAME);
+    customWarning(saveContext,                 saveDataError::SAVE_CONTEXT_BAD_POINTER);
+    customWarning(saveContext->NTStream.data,  saveDataError::BUFFER_BAD_POINTER);
+    customWarning(saveContext->ASTStream.data, saveDataError::BUFFER_BAD_POINTER);
+    customWarning(saveContext->NTFileName,     saveDataError::BAD_FILENAME);
+    customWarning(saveContext->ASTFileName,    saveDataError::BAD_FILENAME);
 
     FREE_(saveContext->NTFileName);
     FREE_(saveContext->ASTFileName);
 
-    bufferDestruct(saveContext->NTBuffer);
-    bufferDestruct(saveContext->ASTBuffer);
+    FREE_(saveContext->NTStream.data);
+    FREE_(saveContext->ASTStream.data);
+
+    return saveDataError::NO_ERRORS;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static saveDataError openSaveStream(saveStream *stream, const char *fileName) {
+    stream->descriptor = open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    stream->size       = 0;
+    stream->isFailed   = false;
+
+    customWarning(stream->descriptor >= 0, saveDataError::FILE_OPEN_ERROR);
 
     return saveDataError::NO_ERRORS;
 }
 
-static size_t getKeywordsCount(compilationContext *context) {
-    customWarning(context, 0);
+static saveDataError closeSaveStream(saveStream *stream) {
+    flushSaveStream(stream);
+
+    if (close(stream->descriptor) != 0) {
+        stream->isFailed = true;
+    }
+
+    stream->descriptor = -1;
+
+    return stream->isFailed ? saveDataError::FILE_WRITE_ERROR : saveDataError::NO_ERRORS;
+}
+
+// write only copies the block into the page cache, the disk is written behind the traversal, not in front of it
+static void flushSaveStream(saveStream *stream) {
+    if (stream->size == 0) {
+        return;
+    }
+
+    if (!stream->isFailed && !writeWhole(stream->descriptor, stream->data, stream->size)) {
+        stream->isFailed = true;
+    }
+
+    // a failed echo does not spoil the file
+    if (stream->echoDescriptor >= 0) {
+        writeWhole(stream->echoDescriptor, stream->data, stream->size);
+    }
+
+    stream->size = 0;
+}
+
+static bool writeWhole(int descriptor, const char *data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(descriptor, data, size);
+
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (written <= 0) {
+            return false;
+        }
+
+        data += written;
+        size -= (size_t) written;
+    }
+
+    return true;
+}
+
+static void writeStreamData(saveStream *stream, const char *data, size_t size) {
+    while (size > 0) {
+        if (stream->size == SAVE_STREAM_SIZE) {
+            flushSaveStream(stream);
+        }
+
+        size_t chunkSize = SAVE_STREAM_SIZE - stream->size < size ? SAVE_STREAM_SIZE - stream->size : size;
+
+        memcpy(stream->data + stream->size, data, chunkSize);
+
+        stream->size += chunkSize;
+        data         += chunkSize;
+        size         -= chunkSize;
+    }
+}
+
+static void writeStreamString(saveStream *stream, const char *string) {
+    writeStreamData(stream, string, strlen(string));
+}
+
+// the digits go from the end of a local block two at a time, the way %llu would print them
+static void writeStreamNumber(saveStream *stream, uint64_t magnitude, bool isNegative) {
+    static const char DIGIT_PAIRS[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                                      "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                                      "8081828384858687888990919293949596979899";
 
-    size_t keywordsCount = 0;
+    char  number[24] = {};
+    char *digits     = number + sizeof(number);
 
-    while (keywordsCount < context->nameTable->currentIndex && context->nameTable->data[keywordsCount].type != nameType::IDENTIFIER) {
-        keywordsCount++;
+    while (magnitude >= 100) {
+        digits -= 2;
+        memcpy(digits, DIGIT_PAIRS + (magnitude % 100) * 2, 2);
+        magnitude /= 100;
     }
 
-    return keywordsCount;
+    if (magnitude >= 10) {
+        digits -= 2;
+        memcpy(digits, DIGIT_PAIRS + magnitude * 2, 2);
+    } else {
+        *--digits = (char) ('0' + magnitude);
+    }
+
+    if (isNegative) {
+        *--digits = '-';
+    }
+
+    writeStreamData(stream, digits, (size_t) (number + sizeof(number) - digits));
+}
+
+static void writeStreamSigned(saveStream *stream, long long number) {
+    writeStreamNumber(stream, number < 0 ? 0 - (uint64_t) number : (uint64_t) number, number < 0);
 }
 
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
 saveDataError saveNameTable(compilationContext *context, saveDataContext *saveContext) {
     customWarning(context,    saveDataError::CONTEXT_BAD_POINTER);
     customWarning(saveContext, saveDataError::SAVE_CONTEXT_BAD_POINTER);
 
-    size_t keywordsCount = getKeywordsCount(context);
+    saveDataError error = openSaveStream(&saveContext->NTStream, saveContext->NTFileName);
 
-    saveGlobalNameTable(context, saveContext, keywordsCount);
+    if (error != saveDataError::NO_ERRORS) {
+        return error;
+    }
 
-    char numToStr[16 + 1] = {};
-    snprintf(numToStr, sizeof(numToStr), "\n%lu\n", context->localTables->currentIndex); 
+    size_t keywordsCount = getKeywordsCount(context->nameTable);
 
-    writeStringToBuffer(saveContext->NTBuffer, numToStr);
+    saveGlobalNameTable(context, saveContext, keywordsCount);
+
+    writeStreamString(&saveContext->NTStream, "\n");
+    writeStreamNumber(&saveContext->NTStream, context->localTables->currentIndex, false);
+    writeStreamString(&saveContext->NTStream, "\n");
 
     for (size_t localTableIndex = 0; localTableIndex < context->localTables->currentIndex; localTableIndex++) {
         saveLocalNameTable(context, saveContext, localTableIndex, keywordsCount);
     }
 
-    FILE *file = fopen(saveContext->NTFileName, "w");
-    customWarning(file, saveDataError::FILE_OPEN_ERROR);
-
-    if (fwrite(saveContext->NTBuffer->data, sizeof(char), saveContext->NTBuffer->currentIndex, file) != saveContext->NTBuffer->currentIndex) {
-        fclose(file);
-        return saveDataError::FILE_WRITE_ERROR;
-    }
-
-    fclose(file);
-
-    return saveDataError::NO_ERRORS;
+    return closeSaveStream(&saveContext->NTStream);
 }
 
 saveDataError saveGlobalNameTable(compilationContext *context, saveDataContext *saveContext, size_t keywordsCount) {
     customWarning(context,   saveDataError::CONTEXT_BAD_POINTER);
     customWarning(saveContext, saveDataError::SAVE_CONTEXT_BAD_POINTER);
 
-    char numToStr[16 + 1] = {};
-
-    snprintf(numToStr, sizeof(numToStr), "%lu\n", context->nameTable->currentIndex - keywordsCount); 
+    saveStream *stream = &saveContext->NTStream;
 
-    writeStringToBuffer(saveContext->NTBuffer, numToStr);
+    writeStreamNumber(stream, context->nameTable->currentIndex - keywordsCount, false);
+    writeStreamString(stream, "\n");
 
     for (size_t index = keywordsCount; index < context->nameTable->currentIndex; index++) {
-        writeStringToBuffer(saveContext->NTBuffer, context->nameTable->data[index].name);
-        writeStringToBuffer(saveContext->NTBuffer, "\n");
+        writeStreamString(stream, context->nameTable->data[index].name);
+        writeStreamString(stream, "\n");
     }
 
     return saveDataError::NO_ERRORS;
@@ -130,22 +239,25 @@ saveDataError saveLocalNameTable(compilationContext *context, saveDataContext *s
     customWarning(context,    saveDataError::CONTEXT_BAD_POINTER);
     customWarning(saveContext, saveDataError::SAVE_CONTEXT_BAD_POINTER);
 
-    char numToStr[32 + 1] = {};
-    snprintf(numToStr, sizeof(numToStr), "\n%lu ", context->localTables->data[localTableIndex].size);
+    saveStream *stream = &saveContext->NTStream;
 
-    writeStringToBuffer(saveContext->NTBuffer, numToStr);
+    writeStreamString(stream, "\n");
+    writeStreamNumber(stream, context->localTables->data[localTableIndex].size, false);
+    writeStreamString(stream, " ");
 
     int nameTableID = context->localTables->data[localTableIndex].nameTableID;
     nameTableID = nameTableID - (nameTableID > 0 ? (int) keywordsCount : 0);
 
-    snprintf(numToStr, sizeof(numToStr), "%d\n", nameTableID);
-    writeStringToBuffer(saveContext->NTBuffer, numToStr);
+    writeStreamSigned(stream, nameTableID);
+    writeStreamString(stream, "\n");
 
     for (size_t elementIndex = 0; elementIndex < context->localTables->data[localTableIndex].size; elementIndex++) {
         localNameTableElement *element = &context->localTables->data[localTableIndex].elements.data[elementIndex];
 
-        snprintf(numToStr, sizeof(numToStr), "%lu %d\n", element->globalNameID - keywordsCount, static_cast<int>(element->type));
-        writeStringToBuffer(saveContext->NTBuffer, numToStr);
+        writeStreamNumber(stream, element->globalNameID - keywordsCount, false);
+        writeStreamString(stream, " ");
+        writeStreamSigned(stream, static_cast<int>(element->type));
+        writeStreamString(stream, "\n");
     }
 
     return saveDataError::NO_ERRORS;
@@ -153,42 +265,84 @@ saveDataError saveLocalNameTable(compilationContext *context, saveDataContext *s
 
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
 
+static saveDataError writeTextNode(saveDataContext *saveContext, astNodeEncoder *encoder, node<astNode> *currentNode) {
+    binaryASTNode record = encoder->visit(currentNode);
+
+    writeStreamSigned(&saveContext->ASTStream, (long long) record.type);
+    writeStreamString(&saveContext->ASTStream, " ");
+
+    if (hasNodePayload((nodeType) record.type)) {
+        writeStreamSigned(&saveContext->ASTStream, (long long) record.payload);
+        writeStreamString(&saveContext->ASTStream, " ");
+    }
+
+    return saveDataError::NO_ERRORS;
+}
+
 saveDataError saveASTTree(compilationContext *context, saveDataContext *saveContext) {
     customWarning(context,     saveDataError::CONTEXT_BAD_POINTER);
     customWarning(saveContext, saveDataError::SAVE_CONTEXT_BAD_POINTER);
 
-    size_t keywordsCount = getKeywordsCount(context);
+    saveDataError error = openSaveStream(&saveContext->ASTStream, saveContext->ASTFileName);
 
-    saveASTSubtree(context, saveContext, context->AST->root, keywordsCount);
+    if (error != saveDataError::NO_ERRORS) {
+        return error;
+    }
 
-    writeStringToBuffer(saveContext->ASTBuffer, "\n");
+    size_t keywordsCount = getKeywordsCount(context->nameTable);
 
-    FILE *file = fopen(saveContext->ASTFileName, "w");
-    customWarning(file, saveDataError::FILE_OPEN_ERROR);
+    error = saveASTSubtree(context, saveContext, context->AST->root, keywordsCount);
 
-    fwrite(saveContext->ASTBuffer->data, sizeof(char), saveContext->ASTBuffer->currentIndex, file);
-    fclose(file);
+    writeStreamString(&saveContext->ASTStream, "\n");
 
-    return saveDataError::NO_ERRORS;
+    saveDataError closeError = closeSaveStream(&saveContext->ASTStream);
+
+    return error != saveDataError::NO_ERRORS ? error : closeError;
 }
 
-saveDataError saveASTSubtree(compilationContext *context, saveDataContext *saveContext, node<astNode> *node, size_t keywordsCount) {
+saveDataError saveASTSubtree(compilationContext *context, saveDataContext *saveContext, node<astNode> *subtree, size_t keywordsCount) {
     customWarning(context,     saveDataError::CONTEXT_BAD_POINTER);
     customWarning(saveContext, saveDataError::SAVE_CONTEXT_BAD_POINTER);
 
-    if (!node) {
-        writeStringToBuffer(saveContext->ASTBuffer, "_ ");
+    if (!subtree) {
+        writeStreamString(&saveContext->ASTStream, "_ ");
         return saveDataError::NO_ERRORS;
     }
 
-    writeStringToBuffer(saveContext->ASTBuffer, "( ");
-
-    saveASTNode(context, saveContext, node, keywordsCount);
+    astNodeEncoder        encoder  = {{}, context->nameTable, keywordsCount};
+    treeIterator<astNode> iterator = {};
+    treeWalkInitialize(&iterator, subtree);
+
+    // a missing left child is written once the left side is over, a missing right one right before the node closes
+    while (node<astNode> *currentNode = treeIteratorNext(&iterator)) {
+        switch (iterator.visit) {
+            case printType::PREFIX:
+                writeStreamString(&saveContext->ASTStream, "( ");
+                writeTextNode(saveContext, &encoder, currentNode);
+                break;
+
+            case printType::INFIX:
+                if (!currentNode->left) {
+                    writeStreamString(&saveContext->ASTStream, "_ ");
+                }
+
+                break;
+
+            case printType::POSTFIX:
+            default:
+                if (!currentNode->right) {
+                    writeStreamString(&saveContext->ASTStream, "_ ");
+                }
+
+                writeStreamString(&saveContext->ASTStream, ") ");
+                break;
+        }
+    }
 
-    saveASTSubtree(context, saveContext, node->left, keywordsCount);
-    saveASTSubtree(context, saveContext, node->right, keywordsCount);
+    bool isSaved = iterator.error == binaryTreeError::NO_ERRORS;
+    treeIteratorDestruct(&iterator);
 
-    writeStringToBuffer(saveContext->ASTBuffer, ") ");
+    customWarning(isSaved, saveDataError::ALLOCATION_ERROR);
 
     return saveDataError::NO_ERRORS;
 }
@@ -198,37 +352,290 @@ saveDataError saveASTNode(compilationContext *context, saveDataContext *saveCont
     customWarning(saveContext, saveDataError::SAVE_CONTEXT_BAD_POINTER);
     customWarning(node,        saveDataError::NODE_BAD_POINTER);
 
-    char numStr[16 + 1] = {};
+    astNodeEncoder encoder = {{}, context->nameTable, keywordsCount};
 
-    if (node->data.type == nodeType::STRING) {
-        if (context->nameTable->data[node->data.data.nameTableIndex].keyword == Keyword::UNDEFINED) {
-            writeStringToBuffer(saveContext->ASTBuffer, "2 ");
+    return writeTextNode(saveContext, &encoder, node);
+}
 
-            snprintf(numStr, sizeof(numStr), "%lu ", node->data.data.nameTableIndex - keywordsCount);
-            writeStringToBuffer(saveContext->ASTBuffer, numStr);
-        } else {
-            snprintf(numStr, sizeof(numStr), "%d ", static_cast<int>(node->data.type) + 1);
-            writeStringToBuffer(saveContext->ASTBuffer, numStr);
-            
-            snprintf(numStr, sizeof(numStr), "%d ", static_cast<int>(context->nameTable->data[node->data.data.nameTableIndex].keyword));
-            writeStringToBuffer(saveContext->ASTBuffer, numStr);
-        }
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+struct binaryFrame {
+    node<astNode> *current = NULL;
+    astHandle      parent  = AST_NO_NODE;
+    bool           isRight = false;
+};
 
+// the same preorder as flattenTree, so the back-end links every node to a parent it has already seen
+static saveDataError buildBinaryNodes(compilationContext *context, size_t keywordsCount, Buffer<binaryASTNode> *nodes) {
+    if (!context->AST->root) {
         return saveDataError::NO_ERRORS;
-    } else {
-        snprintf(numStr, sizeof(numStr), "%d ", static_cast<int>(node->data.type));
-        writeStringToBuffer(saveContext->ASTBuffer, numStr);
     }
 
-    if (node->data.type == nodeType::CONSTANT) {
-        snprintf(numStr, sizeof(numStr), "%d ", node->data.data.number);
-        writeStringToBuffer(saveContext->ASTBuffer, numStr);
-    } else if (node->data.type == nodeType::FUNCTION_DEFINITION || node->data.type == nodeType::VARIABLE_DECLARATION) {
-        snprintf(numStr, sizeof(numStr), "%lu ", node->data.data.nameTableIndex - keywordsCount);
-        writeStringToBuffer(saveContext->ASTBuffer, numStr);
+    Buffer<binaryFrame> frames = {};
+
+    if (bufferInitialize(&frames) != bufferError::NO_BUFFER_ERROR) {
+        return saveDataError::ALLOCATION_ERROR;
+    }
+
+    astNodeEncoder encoder   = {{}, context->nameTable, keywordsCount};
+    binaryFrame    rootFrame = {.current = context->AST->root, .parent = AST_NO_NODE, .isRight = false};
+    bufferError    error     = writeDataToBuffer(&frames, &rootFrame, 1);
+
+    while (error == bufferError::NO_BUFFER_ERROR && frames.currentIndex > 0) {
+        binaryFrame frame = frames.data[--frames.currentIndex];
+
+        if (nodes->currentIndex >= AST_MAX_NODES) {
+            error = bufferError::BUFFER_ENDED;
+            break;
+        }
+
+        binaryASTNode record = encoder.visit(frame.current);
+        record.parent        = frame.parent;
+
+        error = writeDataToBuffer(nodes, &record, 1);
+
+        if (error != bufferError::NO_BUFFER_ERROR) {
+            break;
+        }
+
+        astHandle handle = (astHandle) (nodes->currentIndex - 1);
+
+        if (frame.parent != AST_NO_NODE) {
+            if (frame.isRight) {
+                nodes->data[frame.parent].right = handle;
+            } else {
+                nodes->data[frame.parent].left  = handle;
+            }
+        }
+
+        binaryFrame rightFrame = {.current = frame.current->right, .parent = handle, .isRight = true};
+        binaryFrame leftFrame  = {.current = frame.current->left,  .parent = handle, .isRight = false};
+
+        if (rightFrame.current) {
+            error = writeDataToBuffer(&frames, &rightFrame, 1);
+        }
+
+        if (leftFrame.current && error == bufferError::NO_BUFFER_ERROR) {
+            error = writeDataToBuffer(&frames, &leftFrame, 1);
+        }
+    }
+
+    bufferDestruct(&frames);
+
+    return error == bufferError::NO_BUFFER_ERROR ? saveDataError::NO_ERRORS : saveDataError::ALLOCATION_ERROR;
+}
+
+// every function on the top-level separator chain gets a section; in preorder its subtree runs from the separator's
+// left child up to its right one. offsets are counted from the nodes section until the layout is known
+static saveDataError buildFunctionDirectory(Buffer<binaryASTNode> *nodes, Buffer<binaryASTFunction> *functions) {
+    astHandle separator = nodes->currentIndex > 0 ? 0 : AST_NO_NODE;
+
+    for (; separator != AST_NO_NODE; separator = nodes->data[separator].right) {
+        binaryASTNode *separatorNode = &nodes->data[separator];
+
+        if (separatorNode->type    != (uint32_t) nodeType::KEYWORD ||
+            separatorNode->payload != (int64_t)  Keyword::OPERATOR_SEPARATOR) {
+            break;
+        }
+
+        astHandle definition = separatorNode->left;
+
+        if (definition == AST_NO_NODE || nodes->data[definition].type != (uint32_t) nodeType::FUNCTION_DEFINITION) {
+            continue;
+        }
+
+        astHandle         sectionEnd = separatorNode->right != AST_NO_NODE ? separatorNode->right : (astHandle) nodes->currentIndex;
+        binaryASTFunction function   = {
+            .nameIndex = (uint32_t) nodes->data[definition].payload,
+            .reserved  = 0,
+            .offset    = (uint64_t) definition * sizeof(binaryASTNode),
+            .size      = (uint64_t) (sectionEnd - definition) * sizeof(binaryASTNode)
+        };
+
+        if (writeDataToBuffer(functions, &function, 1) != bufferError::NO_BUFFER_ERROR) {
+            return saveDataError::ALLOCATION_ERROR;
+        }
     }
 
     return saveDataError::NO_ERRORS;
 }
 
+static saveDataError buildBinaryNameTable(compilationContext *context, size_t keywordsCount, Buffer<binaryASTName> *names,
+                                          Buffer<char> *strings, Buffer<binaryASTLocalTable> *localTables,
+                                          Buffer<binaryASTLocalElement> *localElements) {
+    bufferError error = bufferError::NO_BUFFER_ERROR;
+
+    for (size_t index = keywordsCount; index < context->nameTable->currentIndex && error == bufferError::NO_BUFFER_ERROR; index++) {
+        const char   *name    = context->nameTable->data[index].name;
+        binaryASTName newName = {.offset = (uint32_t) strings->currentIndex, .length = (uint32_t) strlen(name)};
+
+        error = writeDataToBuffer(strings, name, newName.length + 1);
+
+        if (error == bufferError::NO_BUFFER_ERROR) {
+            error = writeDataToBuffer(names, &newName, 1);
+        }
+    }
+
+    for (size_t tableIndex = 0; tableIndex < context->localTables->currentIndex && error == bufferError::NO_BUFFER_ERROR; tableIndex++) {
+        localNameTable *table       = &context->localTables->data[tableIndex];
+        int             nameTableID = table->nameTableID - (table->nameTableID > 0 ? (int) keywordsCount : 0);
+
+        binaryASTLocalTable newTable = {.nameTableID   = nameTableID,
+                                        .firstElement  = (uint32_t) localElements->currentIndex,
+                                        .elementsCount = (uint32_t) table->size};
+
+        error = writeDataToBuffer(localTables, &newTable, 1);
+
+        for (size_t elementIndex = 0; elementIndex < table->size && error == bufferError::NO_BUFFER_ERROR; elementIndex++) {
+            localNameTableElement *element    = &table->elements.data[elementIndex];
+            binaryASTLocalElement  newElement = {.globalNameID = (uint32_t) (element->globalNameID - keywordsCount),
+                                                 .type         = (uint32_t) element->type};
+
+            error = writeDataToBuffer(localElements, &newElement, 1);
+        }
+    }
+
+    if (strings->currentIndex > UINT32_MAX) {
+        return saveDataError::BUFFER_WRITE_ERROR;
+    }
+
+    return error == bufferError::NO_BUFFER_ERROR ? saveDataError::NO_ERRORS : saveDataError::ALLOCATION_ERROR;
+}
+
+static bufferError appendBinarySection(Buffer<char> *file, const void *data, size_t size, uint64_t *offset) {
+    static const char PADDING[BINARY_AST_ALIGNMENT] = {};
+
+    size_t paddingSize = (BINARY_AST_ALIGNMENT - file->currentIndex % BINARY_AST_ALIGNMENT) % BINARY_AST_ALIGNMENT;
+
+    if (paddingSize > 0 && writeDataToBuffer(file, PADDING, paddingSize) != bufferError::NO_BUFFER_ERROR) {
+        return bufferError::CALLOC_ERROR;
+    }
+
+    *offset = file->currentIndex;
+
+    return size > 0 ? writeDataToBuffer(file, data, size) : bufferError::NO_BUFFER_ERROR;
+}
+
+// the name table and the tree in the layout of binaryAST.h, the image is what saveBinaryAST writes to disk
+saveDataError buildBinaryAST(compilationContext *context, Buffer<char> *image) {
+    customWarning(context, saveDataError::CONTEXT_BAD_POINTER);
+    customWarning(image,   saveDataError::BUFFER_BAD_POINTER);
+
+    size_t keywordsCount = getKeywordsCount(context->nameTable);
+
+    Buffer<binaryASTFunction>     functions     = {};
+    Buffer<binaryASTNode>         nodes         = {};
+    Buffer<binaryASTName>         names         = {};
+    Buffer<char>                  strings       = {};
+    Buffer<binaryASTLocalTable>   localTables   = {};
+    Buffer<binaryASTLocalElement> localElements = {};
+
+    saveDataError error = saveDataError::NO_ERRORS;
+
+    if (bufferInitialize(&functions)     != bufferError::NO_BUFFER_ERROR ||
+        bufferInitialize(&nodes)         != bufferError::NO_BUFFER_ERROR ||
+        bufferInitialize(&names)         != bufferError::NO_BUFFER_ERROR ||
+        bufferInitialize(&strings)       != bufferError::NO_BUFFER_ERROR ||
+        bufferInitialize(&localTables)   != bufferError::NO_BUFFER_ERROR ||
+        bufferInitialize(&localElements) != bufferError::NO_BUFFER_ERROR) {
+        error = saveDataError::INITIALIZATION_ERROR;
+    }
+
+    if (error == saveDataError::NO_ERRORS) {
+        error = buildBinaryNodes(context, keywordsCount, &nodes);
+    }
+
+    if (error == saveDataError::NO_ERRORS) {
+        error = buildFunctionDirectory(&nodes, &functions);
+    }
+
+    if (error == saveDataError::NO_ERRORS) {
+        error = buildBinaryNameTable(context, keywordsCount, &names, &strings, &localTables, &localElements);
+    }
+
+    binaryASTHeader header = {};
+
+    memcpy(header.magic, BINARY_AST_MAGIC, sizeof(BINARY_AST_MAGIC));
+
+    header.version            = BINARY_AST_VERSION;
+    header.root               = nodes.currentIndex > 0 ? 0 : AST_NO_NODE;
+    header.nodesCount         = (uint32_t) nodes.currentIndex;
+    header.namesCount         = (uint32_t) names.currentIndex;
+    header.localTablesCount   = (uint32_t) localTables.currentIndex;
+    header.localElementsCount = (uint32_t) localElements.currentIndex;
+    header.stringsSize        = (uint32_t) strings.currentIndex;
+    header.functionsCount     = (uint32_t) functions.currentIndex;
+    header.entryPoint         = (uint32_t) (context->entryPoint - keywordsCount);
+
+    image->currentIndex = 0;
+
+    // the header goes in first as a placeholder, its offsets are known once every section is laid out
+    if (error == saveDataError::NO_ERRORS &&
+        (writeDataToBuffer(image, &header, sizeof(header)) != bufferError::NO_BUFFER_ERROR ||
+         appendBinarySection(image, functions.data,     functions.currentIndex     * sizeof(binaryASTFunction),
+                             &header.functionsOffset)     != bufferError::NO_BUFFER_ERROR ||
+         appendBinarySection(image, nodes.data,         nodes.currentIndex         * sizeof(binaryASTNode),
+                             &header.nodesOffset)         != bufferError::NO_BUFFER_ERROR ||
+         appendBinarySection(image, names.data,         names.currentIndex         * sizeof(binaryASTName),
+                             &header.namesOffset)         != bufferError::NO_BUFFER_ERROR ||
+         appendBinarySection(image, localTables.data,   localTables.currentIndex   * sizeof(binaryASTLocalTable),
+                             &header.localTablesOffset)   != bufferError::NO_BUFFER_ERROR ||
+         appendBinarySection(image, localElements.data, localElements.currentIndex * sizeof(binaryASTLocalElement),
+                             &header.localElementsOffset) != bufferError::NO_BUFFER_ERROR ||
+         appendBinarySection(image, strings.data,       strings.currentIndex,
+                             &header.stringsOffset)       != bufferError::NO_BUFFER_ERROR)) {
+        error = saveDataError::ALLOCATION_ERROR;
+    }
+
+    if (error == saveDataError::NO_ERRORS) {
+        for (size_t functionIndex = 0; functionIndex < functions.currentIndex; functionIndex++) {
+            functions.data[functionIndex].offset += header.nodesOffset;
+        }
+
+        memcpy(image->data + header.functionsOffset, functions.data, functions.currentIndex * sizeof(binaryASTFunction));
+        memcpy(image->data,                           &header,        sizeof(header));
+    }
+
+    bufferDestruct(&functions);
+    bufferDestruct(&nodes);
+    bufferDestruct(&names);
+    bufferDestruct(&strings);
+    bufferDestruct(&localTables);
+    bufferDestruct(&localElements);
+
+    return error;
+}
+
+// the back-end maps this file instead of parsing it
+saveDataError saveBinaryAST(compilationContext *context, const char *fileName) {
+    customWarning(context,  saveDataError::CONTEXT_BAD_POINTER);
+    customWarning(fileName, saveDataError::BAD_FILENAME);
+
+    Buffer<char> image = {};
+
+    if (bufferInitialize(&image) != bufferError::NO_BUFFER_ERROR) {
+        return saveDataError::INITIALIZATION_ERROR;
+    }
+
+    saveDataError error = buildBinaryAST(context, &image);
+
+    if (error == saveDataError::NO_ERRORS) {
+        FILE *output = fopen(fileName, "wb");
+
+        if (!output) {
+            error = saveDataError::FILE_OPEN_ERROR;
+        } else {
+            if (fwrite(image.data, sizeof(char), image.currentIndex, output) != image.currentIndex) {
+                error = saveDataError::FILE_WRITE_ERROR;
+            }
+
+            fclose(output);
+        }
+    }
+
+    bufferDestruct(&image);
+
+    return error;
+}
+
 // -------------------------------------------------------------------------------------------------------------------------------------------------- //
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "utf8.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// per lead byte: sequence length, payload mask and the allowed range of the second byte,
+// the narrowed ranges reject overlong forms, surrogates and code points above U+10FFFF
+struct utf8LeadInfo {
+    unsigned char length     = 0;
+    unsigned char mask       = 0;
+    unsigned char secondLow  = 0x80;
+    unsigned char secondHigh = 0xbf;
+};
+
+struct utf8LeadTable {
+    utf8LeadInfo leads[256] = {};
+};
+
+static constexpr utf8LeadTable buildLeadTable() {
+    utf8LeadTable table = {};
+
+    for (int byte = 0x00; byte <= 0x7f; byte++) {
+        table.leads[byte] = {.length = 1, .mask = 0x7f};
+    }
+
+    for (int byte = 0xc2; byte <= 0xdf; byte++) {
+        table.leads[byte] = {.length = 2, .mask = 0x1f};
+    }
+
+    for (int byte = 0xe0; byte <= 0xef; byte++) {
+        table.leads[byte] = {.length = 3, .mask = 0x0f};
+    }
+
+    for (int byte = 0xf0; byte <= 0xf4; byte++) {
+        table.leads[byte] = {.length = 4, .mask = 0x07};
+    }
+
+    table.leads[0xe0].secondLow  = 0xa0;
+    table.leads[0xed].secondHigh = 0x9f;
+    table.leads[0xf0].secondLow  = 0x90;
+    table.leads[0xf4].secondHigh = 0x8f;
+
+    return table;
+}
+
+static constexpr utf8LeadTable UTF8_LEADS = buildLeadTable();
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+size_t decodeUtf8Symbol(const char *text, size_t available, uint32_t *codePoint) {
+    if (!text || !codePoint || available == 0) {
+        return 0;
+    }
+
+    const unsigned char *bytes = (const unsigned char *)text;
+    const utf8LeadInfo  *lead  = &UTF8_LEADS.leads[bytes[0]];
+
+    if (lead->length == 0 || lead->length > available) {
+        return 0;
+    }
+
+    if (lead->length > 1 && (bytes[1] < lead->secondLow || bytes[1] > lead->secondHigh)) {
+        return 0;
+    }
+
+    uint32_t decoded = bytes[0] & lead->mask;
+
+    for (size_t byteIndex = 1; byteIndex < lead->length; byteIndex++) {
+        if ((bytes[byteIndex] & 0xc0) != 0x80) {
+            return 0;
+        }
+
+        decoded = (decoded << 6) | (bytes[byteIndex] & 0x3f);
+    }
+
+    *codePoint = decoded;
+
+    return lead->length;
+}
+
+// Ё, А..я, ё
+bool isCyrillicCodePoint(uint32_t codePoint) {
+    return codePoint == 0x0401 || (codePoint >= 0x0410 && codePoint <= 0x044f) || codePoint == 0x0451;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -0,0 +1,156 @@
+# cmake -DCOMPILER=<compiler> -DCASE=<name> -DTESTS_DIR=<this directory> -DWORK_DIR=<scratch directory> -P e2e.cmake
+# one end-to-end case: the driver compiles sources from TESTS_DIR inside WORK_DIR and its output is checked
+
+foreach(VARIABLE COMPILER CASE TESTS_DIR WORK_DIR)
+    if(NOT DEFINED ${VARIABLE})
+        message(FATAL_ERROR "${VARIABLE} is not set")
+    endif()
+endforeach()
+
+file(REMOVE_RECURSE ${WORK_DIR})
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+# -------------------------------------------------------------------------------------------------------------------------------------------------- #
+
+# compile(<source> <output> [driver options...]), the driver's stderr ends up in COMPILE_LOG
+function(compile SOURCE OUTPUT)
+    execute_process(COMMAND ${COMPILER} ${SOURCE} ${OUTPUT} ${ARGN}
+                    WORKING_DIRECTORY ${WORK_DIR}
+                    RESULT_VARIABLE   RESULT
+                    OUTPUT_QUIET
+                    ERROR_VARIABLE    LOG)
+
+    if(NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "${CASE}: can't compile ${SOURCE} ${ARGN} (${RESULT}):\n${LOG}")
+    endif()
+
+    set(COMPILE_LOG "${LOG}" PARENT_SCOPE)
+endfunction()
+
+# expect_compile_error(<source> <output> [driver options...]), the driver has to fail and write no output
+function(expect_compile_error SOURCE OUTPUT)
+    execute_process(COMMAND ${COMPILER} ${SOURCE} ${OUTPUT} ${ARGN}
+                    WORKING_DIRECTORY ${WORK_DIR}
+                    RESULT_VARIABLE   RESULT
+                    OUTPUT_QUIET
+                    ERROR_VARIABLE    LOG)
+
+    if(RESULT EQUAL 0 OR EXISTS ${WORK_DIR}/${OUTPUT})
+        message(FATAL_ERROR "${CASE}: ${SOURCE} ${ARGN} compiled:\n${LOG}")
+    endif()
+
+    set(COMPILE_LOG "${LOG}" PARENT_SCOPE)
+endfunction()
+
+function(expect_same_files FIRST SECOND)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${FIRST} ${SECOND} RESULT_VARIABLE RESULT)
+
+    if(NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "${CASE}: ${FIRST} and ${SECOND} differ")
+    endif()
+endfunction()
+
+function(expect_log TEXT)
+    string(FIND "${COMPILE_LOG}" "${TEXT}" POSITION)
+
+    if(POSITION EQUAL -1)
+        message(FATAL_ERROR "${CASE}: \"${TEXT}\" is not in the driver output:\n${COMPILE_LOG}")
+    endif()
+endfunction()
+
+# -------------------------------------------------------------------------------------------------------------------------------------------------- #
+
+set(FACTORIAL        ${TESTS_DIR}/factorial.prison)
+set(FACTORIAL_GOLDEN ${TESTS_DIR}/golden/factorial.s)
+set(REACHABLE        ${TESTS_DIR}/reachable.prison)
+set(REACHABLE_GOLDEN ${TESTS_DIR}/golden/reachable.s)
+
+if(CASE STREQUAL "factorial")
+    compile(${FACTORIAL} factorial.s)
+    expect_same_files(${WORK_DIR}/factorial.s ${FACTORIAL_GOLDEN})
+
+# a syntax error in a later function fails the compile instead of dropping that function
+elseif(CASE STREQUAL "syntaxError")
+    expect_compile_error(${TESTS_DIR}/syntaxError.prison syntaxError.s)
+    expect_log("syntaxError.prison:10: syntax error")
+
+    expect_compile_error(${TESTS_DIR}/syntaxError.prison cached.s --cache cache)
+    expect_compile_error(${TESTS_DIR}/syntaxError.prison cached.s --cache cache)
+
+# functions the entry point never calls are left out, whether the tree comes from the front-end or from its image
+elseif(CASE STREQUAL "reachable")
+    compile(${REACHABLE} direct.s)
+    expect_same_files(${WORK_DIR}/direct.s ${REACHABLE_GOLDEN})
+
+    compile(${REACHABLE} first.s --cache cache)
+
+    file(GLOB ASSEMBLY_ENTRIES ${WORK_DIR}/cache/*.s)
+    file(REMOVE ${ASSEMBLY_ENTRIES})
+
+    compile(${REACHABLE} image.s --cache cache)
+    expect_same_files(${WORK_DIR}/image.s ${REACHABLE_GOLDEN})
+
+# a second build of the same source is served from the cache for both the tree and the assembly
+elseif(CASE STREQUAL "cache")
+    compile(${FACTORIAL} first.s --cache cache --cache-stats)
+    expect_log("0 hits, 2 misses this run")
+
+    compile(${FACTORIAL} second.s --cache cache --cache-stats)
+    expect_log("2 hits, 0 misses this run")
+
+    # a broken tree entry is a miss, the assembly entry of the rebuilt image is still there
+    file(GLOB TREE_ENTRIES ${WORK_DIR}/cache/*.bin)
+    file(WRITE ${TREE_ENTRIES} "broken")
+
+    compile(${FACTORIAL} third.s --cache cache --cache-stats)
+    expect_log("1 hits, 1 misses this run")
+
+    expect_same_files(${WORK_DIR}/first.s  ${FACTORIAL_GOLDEN})
+    expect_same_files(${WORK_DIR}/second.s ${FACTORIAL_GOLDEN})
+    expect_same_files(${WORK_DIR}/third.s  ${FACTORIAL_GOLDEN})
+
+# after an edit inside one function only that function is lowered again,
+# and the stitched assembly is what a build from scratch gives for the edited source
+elseif(CASE STREQUAL "incrementalLowering")
+    file(READ ${FACTORIAL} SOURCE)
+    string(REPLACE "555" "777" SOURCE "${SOURCE}")
+    file(WRITE ${WORK_DIR}/edited.prison "${SOURCE}")
+
+    compile(${FACTORIAL} first.s --cache cache --incremental)
+    expect_same_files(${WORK_DIR}/first.s ${FACTORIAL_GOLDEN})
+
+    compile(${WORK_DIR}/edited.prison incremental.s --cache cache --incremental --cache-stats)
+    expect_log("1 hits, 3 misses this run")
+
+    compile(${WORK_DIR}/edited.prison scratch.s)
+    expect_same_files(${WORK_DIR}/incremental.s ${WORK_DIR}/scratch.s)
+
+# the back-end reads the binary AST back from the cache once the assembly entry is gone,
+# and --save-ast writes the very image that went into the cache
+elseif(CASE STREQUAL "binaryAST")
+    file(MAKE_DIRECTORY ${WORK_DIR}/tree)
+
+    compile(${FACTORIAL} first.s --save-ast --cache cache)
+
+    file(GLOB ASSEMBLY_ENTRIES ${WORK_DIR}/cache/*.s)
+    file(REMOVE ${ASSEMBLY_ENTRIES})
+
+    compile(${FACTORIAL} second.s --cache cache)
+    expect_same_files(${WORK_DIR}/first.s  ${FACTORIAL_GOLDEN})
+    expect_same_files(${WORK_DIR}/second.s ${FACTORIAL_GOLDEN})
+
+    file(GLOB SAVED_IMAGES  ${WORK_DIR}/tree/*.bin)
+    file(GLOB CACHED_IMAGES ${WORK_DIR}/cache/*.bin)
+
+    list(LENGTH SAVED_IMAGES  SAVED_COUNT)
+    list(LENGTH CACHED_IMAGES CACHED_COUNT)
+
+    if(NOT SAVED_COUNT EQUAL 1 OR NOT CACHED_COUNT EQUAL 1)
+        message(FATAL_ERROR "${CASE}: expected one saved and one cached image, got ${SAVED_COUNT} and ${CACHED_COUNT}")
+    endif()
+
+    expect_same_files(${SAVED_IMAGES} ${CACHED_IMAGES})
+
+else()
+    message(FATAL_ERROR "unknown case ${CASE}")
+endif()
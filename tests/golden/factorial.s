@@ -0,0 +1,40 @@
+; Generated ASM from IR
+section .text
+global мэйн
+
+мэйн:
+    push rbp
+    mov rbp, rsp
+    sub rsp, 32
+    mov rax, 228
+    mov [rbp - 8], rax
+    mov rbx, 114
+    sub rax, rbx
+    mov [rbp - 16], rax
+    mov rcx, rax
+    cqo
+    idiv rcx
+    mov rdx, rax
+    mov [rbp - 24], rdx
+    mov rdi, rdx
+    call петух
+    mov rsi, rax
+    mov rsp, rbp
+    pop rbp
+    ret
+
+петух:
+    push rbp
+    mov rbp, rsp
+    sub rsp, 8
+    mov rax, [rbp - 8]
+    mov rdi, rax
+    mov rax, 1
+    mov rsi, 1
+    syscall
+    mov rbx, 555
+    mov rax, rbx
+    mov rsp, rbp
+    pop rbp
+    ret
+
@@ -0,0 +1,32 @@
+; Generated ASM from IR
+section .text
+global мэйн
+
+мэйн:
+    push rbp
+    mov rbp, rsp
+    sub rsp, 16
+    mov rax, 228
+    mov [rbp - 8], rax
+    mov rdi, rax
+    call петух
+    mov rbx, rax
+    mov rsp, rbp
+    pop rbp
+    ret
+
+петух:
+    push rbp
+    mov rbp, rsp
+    sub rsp, 8
+    mov rax, [rbp - 8]
+    mov rdi, rax
+    mov rax, 1
+    mov rsi, 1
+    syscall
+    mov rbx, 555
+    mov rax, rbx
+    mov rsp, rbp
+    pop rbp
+    ret
+
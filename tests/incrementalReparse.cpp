@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "core.h"
+#include "buffer.h"
+#include "lexer.h"
+#include "parser.h"
+#include "treeSaver.h"
+#include "incremental.h"
+#include "sourceInput.h"
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// every edit goes into the first occurrence of pattern in the source
+struct reparseCase {
+    const char *pattern     = NULL;
+    const char *replacement = NULL;
+};
+
+// each one is applied to the unedited source, then all of them in turn to one context
+static const reparseCase REPARSE_CASES[] = {
+    {"555",      "777"           }, // same length, in the last function
+    {"228",      "1337"          }, // longer, every offset after it moves
+    {"торкнуло", "\n\nторкнуло"  }, // new lines at the end of the first function
+    {"минус",    "плюс"          }, // another keyword of the same priority
+    {"мусорнул", "\nмусорнул"    }  // in the last function, after the ones above moved it
+};
+
+static const size_t REPARSE_CASES_COUNT = sizeof(REPARSE_CASES) / sizeof(REPARSE_CASES[0]);
+
+static const char *EDITED_SOURCE_FILE = "edited.prison";
+
+static bool checkReparse (compilationContext *context, const reparseCase *reparse);
+static bool openSource   (compilationContext *context, sourceInput *source, const char *fileName);
+static void closeSource  (compilationContext *context, sourceInput *source);
+static bool parseSource  (compilationContext *context);
+static bool writeSource  (compilationContext *context, const char *fileName);
+static bool areSameImages(compilationContext *first, compilationContext *second);
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+// incrementalReparse <source>: every edit has to go through reparseDeclaration alone,
+// and the edited context has to give the binary AST a fresh parse of the edited text gives
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <source>\n", argv[0]);
+        return 1;
+    }
+
+    int failedCount = 0;
+
+    for (size_t caseIndex = 0; caseIndex < REPARSE_CASES_COUNT; caseIndex++) {
+        sourceInput        source  = {};
+        compilationContext context = {};
+
+        if (!openSource(&context, &source, argv[1])) {
+            return 1;
+        }
+
+        if (!parseSource(&context) || !checkReparse(&context, &REPARSE_CASES[caseIndex])) {
+            failedCount++;
+        }
+
+        closeSource(&context, &source);
+    }
+
+    sourceInput        source  = {};
+    compilationContext context = {};
+
+    if (!openSource(&context, &source, argv[1])) {
+        return 1;
+    }
+
+    bool isParsed = parseSource(&context);
+
+    for (size_t caseIndex = 0; caseIndex < REPARSE_CASES_COUNT && isParsed; caseIndex++) {
+        if (!checkReparse(&context, &REPARSE_CASES[caseIndex])) {
+            fprintf(stderr, "after the edits above it\n");
+            failedCount++;
+            break;
+        }
+    }
+
+    closeSource(&context, &source);
+
+    return failedCount == 0 && isParsed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------------------------------------------------------------------------------------- //
+
+static bool checkReparse(compilationContext *context, const reparseCase *reparse) {
+    if (moveSourceGap(context->source, context->source->size) != sourceInputError::NO_ERRORS) {
+        return false;
+    }
+
+    // fileContent is not null-terminated, so the pattern is looked for by hand
+    size_t patternLength = strlen(reparse->pattern);
+    size_t offset        = 0;
+
+    while (offset + patternLength <= context->fileSize && memcmp(context->fileContent + offset, reparse->pattern, patternLength) != 0) {
+        offset++;
+    }
+
+    if (offset + patternLength > context->fileSize) {
+        fprintf(stderr, "\"%s\" is not in the source\n", reparse->pattern);
+        return false;
+    }
+
+    sourceEdit edit = {.offset         = offset,
+                       .removedLength  = patternLength,
+                       .insertedText   = reparse->replacement,
+                       .insertedLength = strlen(reparse->replacement)};
+    editPath   path = editPath::FULL;
+
+    if (applySourceEdit(context, &edit, &path) != compilationError::NO_ERRORS || path != editPath::INCREMENTAL) {
+        fprintf(stderr, "\"%s\" -> \"%s\": the whole file was parsed again\n", reparse->pattern, reparse->replacement);
+        return false;
+    }
+
+    sourceInput        editedSource  = {};
+    compilationContext editedContext = {};
+
+    if (!writeSource(context, EDITED_SOURCE_FILE) || !openSource(&editedContext, &editedSource, EDITED_SOURCE_FILE)) {
+        return false;
+    }
+
+    bool isSame = parseSource(&editedContext) && areSameImages(context, &editedContext);
+
+    closeSource(&editedContext, &editedSource);
+
+    if (!isSame) {
+        fprintf(stderr, "\"%s\" -> \"%s\": reparsed tree differs from a fresh parse\n", reparse->pattern, reparse->replacement);
+    }
+
+    return isSame;
+}
+
+static bool openSource(compilationContext *context, sourceInput *source, const char *fileName) {
+    if (openSourceInput(source, fileName) != sourceInputError::NO_ERRORS) {
+        fprintf(stderr, "can't open source file \"%s\"\n", fileName);
+        return false;
+    }
+
+    if (initializeCompilationContext(context, source) != compilationError::NO_ERRORS) {
+        closeSourceInput(source);
+        return false;
+    }
+
+    return true;
+}
+
+static void closeSource(compilationContext *context, sourceInput *source) {
+    destroyCompilationContext(context);
+    closeSourceInput(source);
+}
+
+static bool parseSource(compilationContext *context) {
+    return lexicalAnalysis(context) == compilationError::NO_ERRORS && parseCode(context) == compilationError::NO_ERRORS &&
+           context->errorBuffer->currentIndex == 0;
+}
+
+static bool writeSource(compilationContext *context, const char *fileName) {
+    if (moveSourceGap(context->source, context->source->size) != sourceInputError::NO_ERRORS) {
+        return false;
+    }
+
+    FILE *file = fopen(fileName, "wb");
+
+    if (!file) {
+        return false;
+    }
+
+    bool isWritten = fwrite(context->fileContent, 1, context->fileSize, file) == context->fileSize;
+
+    return fclose(file) == 0 && isWritten;
+}
+
+static bool areSameImages(compilationContext *first, compilationContext *second) {
+    Buffer<char> firstImage  = {};
+    Buffer<char> secondImage = {};
+
+    bool isSame = bufferInitialize(&firstImage)        == bufferError::NO_BUFFER_ERROR &&
+                  bufferInitialize(&secondImage)       == bufferError::NO_BUFFER_ERROR &&
+                  buildBinaryAST(first,  &firstImage)  == saveDataError::NO_ERRORS &&
+                  buildBinaryAST(second, &secondImage) == saveDataError::NO_ERRORS &&
+                  firstImage.currentIndex == secondImage.currentIndex &&
+                  memcmp(firstImage.data, secondImage.data, firstImage.currentIndex) == 0;
+
+    bufferDestruct(&firstImage);
+    bufferDestruct(&secondImage);
+
+    return isSame;
+}